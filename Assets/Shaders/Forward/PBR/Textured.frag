@@ -4,6 +4,7 @@ layout(location = 0) out vec4 FragColor;
 layout(location = 1) out vec4 NormalColor;
 
 #include "../../Decals.h"
+#include "../../LightClusters.h"
 
 uniform Color
 {
@@ -104,6 +105,8 @@ void main()
 	NormalColor.rgb = normalize(Normal) * 0.5f + 0.5f;
 #endif
 	NormalColor.a = 0.0f;
+
+	FragColor.rgb += ApplyClusteredPointLights(FragColor.rgb, NormalColor.rgb * 2.0f - 1.0f, WorldPos.xyz, gl_FragCoord.xy);
 #ifdef HAS_DECALS
 	vec3 projCoords;
 	vec4 decalColor;
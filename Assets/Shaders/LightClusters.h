@@ -0,0 +1,81 @@
+#pragma once
+#include "common.h"
+
+// Perspective views split the screen in tiles and the depth in exponential slices, other views use a single cluster
+#define LIGHT_CLUSTERS_X 16
+#define LIGHT_CLUSTERS_Y 9
+#define LIGHT_CLUSTERS_Z 24
+
+struct PointLightGPU
+{
+	vec4 PositionIntensity;
+	vec4 ColorRadius;
+};
+
+uniformbuffer LightClusterInfo
+{
+	mat4 ClusterViewMatrix;
+	// x: near plane, y: slices per unit of log depth, zw: tiles per pixel
+	vec4 ClusterDepthAndTileScale;
+	uint ClusterCountX;
+	uint ClusterCountY;
+	uint ClusterCountZ;
+	uint ClusterLightCount;
+};
+
+#if !defined(SHADER_ENGINE_SIDE)
+layout(std430) readonly buffer ClusterPointLights
+{
+	PointLightGPU PointLights[];
+};
+
+// Offset into ClusterLightIndices and light count, two uints per cluster
+layout(std430) readonly buffer ClusterRanges
+{
+	uint ClusterOffsetCount[];
+};
+
+layout(std430) readonly buffer ClusterLightIndices
+{
+	uint ClusterIndices[];
+};
+
+uint GetLightCluster(vec2 fragCoord, vec3 worldPos)
+{
+	float depth = -(ClusterViewMatrix * vec4(worldPos, 1.0)).z;
+	uint slice = uint(clamp(log(max(depth, ClusterDepthAndTileScale.x) / ClusterDepthAndTileScale.x) * ClusterDepthAndTileScale.y, 0.0, float(ClusterCountZ - 1)));
+	uvec2 tile = min(uvec2(fragCoord * ClusterDepthAndTileScale.zw), uvec2(ClusterCountX - 1, ClusterCountY - 1));
+
+	return (slice * ClusterCountY + tile.y) * ClusterCountX + tile.x;
+}
+
+vec3 ApplyPointLight(PointLightGPU light, vec3 color, vec3 normal, vec3 worldPos)
+{
+	vec3 diff = light.PositionIntensity.xyz - worldPos;
+	float dist = length(diff);
+	vec3 N = normalize(diff);
+	float radius = light.ColorRadius.w;
+	float att = clamp(1.0 - dist*dist/(radius*radius), 0.0, 1.0);
+	att *= att;
+
+	float nDotL = dot(N, normal);
+	nDotL = max(nDotL, 0.2f);
+
+	return color * nDotL * att * light.ColorRadius.rgb * light.PositionIntensity.w;
+}
+
+// Sum of the point lights binned into the cluster of the fragment
+vec3 ApplyClusteredPointLights(vec3 color, vec3 normal, vec3 worldPos, vec2 fragCoord)
+{
+	uint cluster = GetLightCluster(fragCoord, worldPos);
+	uint lightOffset = ClusterOffsetCount[cluster * 2];
+	uint lightCount = ClusterOffsetCount[cluster * 2 + 1];
+
+	vec3 result = vec3(0.0);
+	for (uint i = 0; i < lightCount; ++i)
+	{
+		result += ApplyPointLight(PointLights[ClusterIndices[lightOffset + i]], color, normal, worldPos);
+	}
+	return result;
+}
+#endif
@@ -29,21 +29,6 @@ vec3 ApplyDirectionalLight(DirectionalLightGPU light, vec3 color, vec3 normal)
 	return color * nDotL * light.Color.rgb * light.DirectionIntensity.w;
 }
 
-vec3 ApplyPointLight(PointLightGPU light, vec3 color, vec3 normal, vec3 worldPos)
-{
-	vec3 diff = light.PositionIntensity.xyz - worldPos;
-	float dist = length(diff);
-	vec3 N = normalize(diff);
-	float radius = light.ColorRadius.w;
-	float att = clamp(1.0 - dist*dist/(radius*radius), 0.0, 1.0);
-	att *= att;
-
-	float nDotL = dot(N, normal);
-	nDotL = max(nDotL, 0.2f);
-
-	return color * nDotL * att * light.ColorRadius.rgb * light.PositionIntensity.w;
-}
-
 void main()
 {
 	if (true)
@@ -75,11 +60,8 @@ void main()
 		color += ApplyDirectionalLight(DirLights[i], albedo.rgb, normals);
 	}
 
-	// Point lights
-	for (uint i = 0; i < PointLightCount; ++i)
-	{
-		color += ApplyPointLight(PointLights[i], albedo.rgb, normals, worldPos);
-	}
+	// Point lights of this pixel's cluster
+	color += ApplyClusteredPointLights(albedo.rgb, normals, worldPos, gl_FragCoord.xy);
 
 	FragColor.rgb = color;
 	FragColor.a = 1.0f;
@@ -1,7 +1,7 @@
 #include "../ps_common.h"
+#include "../LightClusters.h"
 
 #define MAX_DIRECTIONAL_LIGHTS 3
-#define MAX_POINT_LIGHTS 1000
 
 uniformbuffer CompositeDefaults
 {
@@ -17,12 +17,6 @@ struct DirectionalLightGPU
 	vec4 Color;
 };
 
-struct PointLightGPU
-{
-	vec4 PositionIntensity;
-	vec4 ColorRadius;
-};
-
 uniformbuffer SkyLightStorage
 {
 	vec4 AmbientColorAndIntensity;
@@ -32,10 +26,4 @@ uniformbuffer DirectionalLightStorage
 {
 	DirectionalLightGPU DirLights[MAX_DIRECTIONAL_LIGHTS];
 	uint DirLightCount;
-};
-
-uniformbuffer PointLightStorage
-{
-	PointLightGPU PointLights[MAX_POINT_LIGHTS];
-	uint PointLightCount;
 };
\ No newline at end of file
@@ -2,16 +2,22 @@
 
 #include "../common.h"
 
-#define MAX_INSTANCES 1024
-
 struct InstanceData
 {
 	mat4 Transform;
 };
 
-uniformbuffer Instances
+#if !defined(SHADER_ENGINE_SIDE)
+layout(std430) readonly buffer Instances
 {
-	mat4 gInstances[MAX_INSTANCES];
+	mat4 gInstances[];
 };
+#endif
 
+#if defined(SHADER_DRAW_PARAMETERS)
+// Multi draw batches bind the instances of the whole pass, every draw starts at its base instance
+#define INST_TRANSFORM gInstances[gl_BaseInstanceARB + gl_InstanceID]
+#else
+// Every draw is bound to its own slice of the instance ring, so gl_InstanceID indexes from the start of the draw
 #define INST_TRANSFORM gInstances[gl_InstanceID]
+#endif
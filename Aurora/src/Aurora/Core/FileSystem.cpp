@@ -1,6 +1,7 @@
 #include "FileSystem.hpp"
 #include <fstream>
 #include <iostream>
+#include <cstdlib>
 
 namespace Aurora::FS
 {
@@ -85,6 +86,22 @@ namespace Aurora::FS
 		return std::filesystem::current_path();
 	}
 
+	Path GetCacheDir()
+	{
+#ifdef _WIN32
+		if (const char* localAppData = std::getenv("LOCALAPPDATA"))
+			return Path(localAppData) / "Aurora";
+#else
+		const char* cacheHome = std::getenv("XDG_CACHE_HOME");
+		if (cacheHome && cacheHome[0] != '\0')
+			return Path(cacheHome) / "Aurora";
+
+		if (const char* home = std::getenv("HOME"))
+			return Path(home) / ".cache" / "Aurora";
+#endif
+		return GetCurrentDir() / "Cache";
+	}
+
 	bool FileExists(const Path &path)
 	{
 		try {
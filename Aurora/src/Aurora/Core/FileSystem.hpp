@@ -10,6 +10,8 @@ namespace Aurora::FS
 	AU_API std::vector<Path> ListFiles(const Path &path, bool recursive);
 	AU_API bool CreateDirectories(const Path &path);
 	AU_API Path GetCurrentDir();
+	// Per user cache directory of the engine, falls back to the current directory when the platform has none
+	AU_API Path GetCacheDir();
 	AU_API bool FileExists(const Path &path);
 
 	/*static inline nlohmann::json LoadJson(const Path& file) {
@@ -1,12 +1,13 @@
 #pragma once
 
+#include <functional>
 #include "Types.hpp"
 
 typedef uint64 StrHashID;
 
 constexpr StrHashID HashDjb2(const char* str)
 {
-	unsigned long int hash = 5381;
+	uint64 hash = 5381;
 
 	char c = *str;
 	while(c != 0)
@@ -32,4 +33,11 @@ constexpr StrHashID HashDjb2(const std::string_view& view)
 
 StrHashID constexpr operator "" _HASH(const char* s, std::size_t) {
 	return HashDjb2(s);
+}
+
+// Mixes the std::hash of value into hash, fields combined in a different order give a different hash
+template<typename T>
+inline void HashCombine(uint64& hash, const T& value)
+{
+	hash ^= std::hash<T>()(value) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
 }
\ No newline at end of file
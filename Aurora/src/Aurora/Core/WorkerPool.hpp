@@ -0,0 +1,101 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "WorkerThread.hpp"
+
+namespace Aurora
+{
+	// Fixed set of WorkerThreads that split one index range into contiguous chunks.
+	// The calling thread always runs chunk 0, so a pool without workers runs everything inline.
+	class WorkerPool
+	{
+	public:
+		using ChunkFunction = std::function<void(uint32_t chunk, size_t begin, size_t end)>;
+	private:
+		std::vector<std::unique_ptr<WorkerThread>> m_Workers;
+
+		const ChunkFunction* m_Function;
+		size_t m_Count;
+		uint32_t m_ChunkCount;
+	public:
+		explicit WorkerPool(const std::string& name, uint32_t workerCount = DefaultWorkerCount()) : m_Function(nullptr), m_Count(0), m_ChunkCount(0)
+		{
+			for (uint32_t i = 0; i < workerCount; ++i)
+			{
+				uint32_t chunk = i + 1;
+				m_Workers.emplace_back(std::make_unique<WorkerThread>([this, chunk]() { RunChunk(chunk); }, name + " " + std::to_string(chunk)));
+			}
+		}
+
+		~WorkerPool()
+		{
+			for (auto& worker : m_Workers)
+			{
+				worker->Destroy();
+			}
+		}
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		[[nodiscard]] uint32_t GetMaxChunks() const { return (uint32_t)m_Workers.size() + 1; }
+
+		// Runs function over [0, count) in at most GetMaxChunks() chunks of at least minChunkSize items and blocks until all finish.
+		// Returns the number of chunks used, chunk ranges are given by GetChunkRange.
+		uint32_t ParallelFor(size_t count, size_t minChunkSize, const ChunkFunction& function)
+		{
+			if (count == 0)
+				return 0;
+
+			auto chunkCount = (uint32_t)std::clamp<size_t>(count / std::max<size_t>(minChunkSize, 1), 1, GetMaxChunks());
+
+			if (chunkCount == 1)
+			{
+				function(0, 0, count);
+				return 1;
+			}
+
+			m_Function = &function;
+			m_Count = count;
+			m_ChunkCount = chunkCount;
+
+			for (uint32_t chunk = 1; chunk < chunkCount; ++chunk)
+			{
+				m_Workers[chunk - 1]->Trigger();
+			}
+
+			RunChunk(0);
+
+			for (uint32_t chunk = 1; chunk < chunkCount; ++chunk)
+			{
+				m_Workers[chunk - 1]->WaitFor();
+			}
+
+			m_Function = nullptr;
+			return chunkCount;
+		}
+
+		static inline void GetChunkRange(size_t count, uint32_t chunkCount, uint32_t chunk, size_t& begin, size_t& end)
+		{
+			begin = count * chunk / chunkCount;
+			end = count * (chunk + 1) / chunkCount;
+		}
+
+		static inline uint32_t DefaultWorkerCount()
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+	private:
+		inline void RunChunk(uint32_t chunk)
+		{
+			size_t begin, end;
+			GetChunkRange(m_Count, m_ChunkCount, chunk, begin, end);
+			(*m_Function)(chunk, begin, end);
+		}
+	};
+}
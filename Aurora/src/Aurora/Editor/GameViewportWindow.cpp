@@ -279,8 +279,14 @@ namespace Aurora
 
 						//AU_LOG_INFO(glm::to_string(ray.Origin));
 
+						PhysicsWorld* physicsWorld = GEngine->GetAppContext()->GetPhysicsWorld();
+
+						// Meshes with a collision BVH are picked by their triangles, the rest by their colliders
 						std::vector<RayCastHitResult> results;
-						if (GEngine->GetAppContext()->GetPhysicsWorld()->RayCast(ray.Origin, ray.Origin + ray.Direction * 1000.0f, results))
+						int32_t hitCount = physicsWorld->RayCast(ray.Origin, ray.Origin + ray.Direction * 1000.0f, results);
+						hitCount += physicsWorld->RayCastMeshes(ray.Origin, ray.Origin + ray.Direction * 1000.0f, results);
+
+						if (hitCount > 0)
 						{
 							const RayCastHitResult& closesResult = results[0];
 							m_MainPanel->SetSelectedActor(closesResult.HitActor);
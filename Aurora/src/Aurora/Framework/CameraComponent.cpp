@@ -164,7 +164,7 @@ namespace Aurora
 	void CameraComponent::Tick(double delta)
 	{
 		// TODO: think about updating only when transform changes too
-		m_View = glm::inverse(GetTransformationMatrix());
+		m_View = glm::inverse(GetRenderTransformationMatrix());
 
 		UpdateFrustum();
 	}
@@ -4,6 +4,7 @@
 #include "Aurora/Graphics/DShape.hpp"
 
 #include "CameraComponent.hpp"
+#include "Scene.hpp"
 
 // Implemented from https://doc.magnum.graphics/magnum/examples-shadows.html
 
@@ -22,11 +23,15 @@ namespace Aurora
 		textureDesc.MipLevels = 1;
 		textureDesc.DepthOrArraySize = numShadowLevels;
 		RenderTexture = GEngine->GetRenderDevice()->CreateTexture(textureDesc);
+		StaticRenderTexture = CacheStaticShadows ? GEngine->GetRenderDevice()->CreateTexture(textureDesc) : nullptr;
 
 		for(std::int_fast32_t i = 0; i < numShadowLevels; ++i)
 		{
 			Layers.emplace_back(resolution);
 			ShadowMatrices.emplace_back(glm::identity<Matrix4>());
+
+			// The first two cascades cover most of the screen, the ones behind them refresh every 2, 4, ... frames
+			Layers.back().UpdateInterval = i < 2 ? 1 : 1u << (i - 1);
 		}
 	}
 
@@ -44,34 +49,50 @@ namespace Aurora
 			std::vector<Vector3> mainCameraFrustumCorners = LayerFrustumCorners(mainCamera, int(layerIndex));
 			ShadowLayerData& layer = Layers[layerIndex];
 
-			/* Calculate the AABB in shadow-camera space */
-			Vector3 min(std::numeric_limits<float>::max());
-			Vector3 max(std::numeric_limits<float>::lowest());
+			/* Fit a sphere in shadow-camera space, unlike a box its size does not change when the camera rotates */
+			Vector3 center(0.0f);
 			for (Vector3 worldPoint: mainCameraFrustumCorners)
 			{
-				//Vector3 cameraPoint = worldPoint;
-				Vector3 cameraPoint = inverseCameraRotationMatrix * worldPoint;
-				min = glm::min(min, cameraPoint);
-				max = glm::max(max, cameraPoint);
-
-				//DShapes::WireBox(AABB(worldPoint - Vector3(2.0f), worldPoint + Vector3(2.0f)));
+				center += inverseCameraRotationMatrix * worldPoint;
 			}
+			center /= float(mainCameraFrustumCorners.size());
 
-			/* Place the shadow camera at the mid-point of the camera box */
-			const Vector3 mid = (min + max) * 0.5f;
-			const Vector3 cameraPosition = cameraRotationMatrix * mid;
-
-			//DShapes::WireBox(AABB(cameraPosition - Vector3(2.0f), cameraPosition + Vector3(2.0f)), Color::blue());
-			//DShapes::WireBox(AABB(mid - Vector3(2.0f), mid + Vector3(2.0f)), Color::red());
-
-			const Vector3 range = max - min;
-			/* Set up the initial extends of the shadow map's render volume. Note
-			   we will adjust this later when we render. */
-			layer.OrthographicSize = Vector2i(range.x, range.y);
-			layer.OrthographicNear = -0.5f * range.z;
-			layer.OrthographicFar =  0.5f * range.z;
+			float radius = 0.0f;
+			for (Vector3 worldPoint: mainCameraFrustumCorners)
+			{
+				radius = std::max(radius, glm::length(inverseCameraRotationMatrix * worldPoint - center));
+			}
+			// Rounding hides float noise, so the size only changes with the projection
+			radius = std::ceil(radius * 16.0f) / 16.0f;
+
+			/* Snap the center to whole steps of SnapTexels texels and grow the
+			   volume by one step, so it still covers the cascade */
+			const float resolution = float(std::max(layer.Resolution.x, layer.Resolution.y));
+			const float snapTexels = std::clamp(SnapTexels, 1.0f, resolution / 4.0f);
+			const float halfSize = radius / (1.0f - 2.0f * snapTexels / resolution);
+			const float step = 2.0f * halfSize / resolution * snapTexels;
+			center = glm::floor(center / step) * step;
+
+			const Vector3 cameraPosition = cameraRotationMatrix * center;
+
+			layer.OrthographicSize = Vector2(2.0f * halfSize);
+			layer.OrthographicNear = -halfSize;
+			layer.OrthographicFar = halfSize;
 			lightCameraMatrix[3] = Vector4(cameraPosition, lightCameraMatrix[3].w);
 			layer.ShadowCameraMatrix = lightCameraMatrix;
+
+			const float hx = layer.OrthographicSize.x / 2.0f;
+			const float hy = layer.OrthographicSize.y / 2.0f;
+			layer.ProjectionMatrix = glm::ortho(-hx, hx, hy, -hy, layer.OrthographicNear, layer.OrthographicFar);
+			layer.Frustum = FFrustum(layer.ProjectionMatrix * glm::inverse(layer.ShadowCameraMatrix));
+		}
+	}
+
+	void DirectionalLightComponent::InvalidateStaticShadows()
+	{
+		for (ShadowLayerData& layer : Layers)
+		{
+			layer.StaticCacheValid = false;
 		}
 	}
 
@@ -156,25 +177,53 @@ namespace Aurora
 
 		CameraComponent lightCamera;
 
+		// Static casters were added, removed, moved or toggled since the caches were rendered
+		if (m_Scene && m_Scene->GetMeshCullingTree().GetStaticVersion() != m_StaticGeometryVersion)
+		{
+			m_StaticGeometryVersion = m_Scene->GetMeshCullingTree().GetStaticVersion();
+			InvalidateStaticShadows();
+		}
+
 		for (std::size_t layer = 0; layer != Layers.size(); layer++)
 		{
 			ShadowLayerData& d = Layers[layer];
-			float orthographicNear = d.OrthographicNear;
-			const float orthographicFar = d.OrthographicFar;
 
 			//const std::vector<Vector4> clipPlanes = CalculateClipPlanes(lightProjection);
 
-			float hx = d.OrthographicSize.x / 2.0f;
-			float hy = d.OrthographicSize.y / 2.0f;
+			Matrix4 invertedShadowCameraMatrix = glm::inverse(d.ShadowCameraMatrix);
+			Matrix4 shadowMatrix = bias * d.ProjectionMatrix * invertedShadowCameraMatrix;
 
-			lightCamera.SetProjectionMatrix(glm::ortho(-hx, hx, hy, -hy, orthographicNear, orthographicFar));
+			// A skipped cascade keeps its old matrix, it still matches the depth in the map
+			++d.FramesSinceUpdate;
+			if (shadowMatrix == ShadowMatrices[layer] && d.FramesSinceUpdate < d.UpdateInterval)
+			{
+				continue;
+			}
+			d.FramesSinceUpdate = 0;
+
+			lightCamera.SetProjectionMatrix(d.ProjectionMatrix);
 			lightCamera.GetTransform().SetFromMatrix(d.ShadowCameraMatrix);
 			lightCamera.UpdateFrustum();
 
-			Matrix4 invertedShadowCameraMatrix = glm::inverse(d.ShadowCameraMatrix);
-			ShadowMatrices[layer] = bias * lightCamera.GetProjectionMatrix() * invertedShadowCameraMatrix;
+			ShadowMatrices[layer] = shadowMatrix;
+
+			if (!CacheStaticShadows || StaticRenderTexture == nullptr)
+			{
+				renderCallback(&lightCamera, &d.Frustum, invertedShadowCameraMatrix, int(layer), EShadowCasterPass::All);
+				continue;
+			}
+
+			if (!d.StaticCacheValid || d.StaticCameraMatrix != d.ShadowCameraMatrix || d.StaticProjectionMatrix != d.ProjectionMatrix)
+			{
+				renderCallback(&lightCamera, &d.Frustum, invertedShadowCameraMatrix, int(layer), EShadowCasterPass::Static);
+
+				d.StaticCameraMatrix = d.ShadowCameraMatrix;
+				d.StaticProjectionMatrix = d.ProjectionMatrix;
+				d.StaticCacheValid = true;
+			}
 
-			renderCallback(&lightCamera, &lightCamera.GetFrustum(), invertedShadowCameraMatrix, int(layer));
+			GEngine->GetRenderDevice()->CopyTextureLayer(StaticRenderTexture, uint32_t(layer), RenderTexture, uint32_t(layer));
+			renderCallback(&lightCamera, &d.Frustum, invertedShadowCameraMatrix, int(layer), EShadowCasterPass::Dynamic);
 		}
 	}
 }
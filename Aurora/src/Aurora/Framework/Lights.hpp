@@ -3,13 +3,13 @@
 #include <functional>
 #include "Aurora/Graphics/Color.hpp"
 #include "Aurora/Graphics/Base/IRenderDevice.hpp"
+#include "Aurora/Physics/Frustum.hpp"
 #include "SceneComponent.hpp"
 #include "Actor.hpp"
 
 namespace Aurora
 {
 	class CameraComponent;
-	class FFrustum;
 
 	struct ShadowLayerData
 	{
@@ -18,6 +18,18 @@ namespace Aurora
 		Vector2 OrthographicSize;
 		float OrthographicNear, OrthographicFar;
 		float CutPlane;
+		// Updated by SetTarget, lets the renderer cull every cascade before rendering any of them
+		Matrix4 ProjectionMatrix;
+		FFrustum Frustum;
+
+		// Frames between two renders of the cascade, far cascades can refresh less often
+		uint32_t UpdateInterval = 1;
+		uint32_t FramesSinceUpdate = 0;
+
+		// Frame the cached static casters were rendered with, the cache is reused while the snapped frame stays the same
+		Matrix4 StaticCameraMatrix;
+		Matrix4 StaticProjectionMatrix;
+		bool StaticCacheValid = false;
 
 		explicit ShadowLayerData(const Vector2i& resolution) : Resolution(resolution) { }
 	};
@@ -45,13 +57,29 @@ namespace Aurora
 		[[nodiscard]] Vector3 GetDirection() const { return -glm::normalize(GetForwardVector()); }
 	};
 
-	typedef std::function<void(CameraComponent*, const FFrustum* frustum, const Matrix4& lightViewMatrix, int layer)> LightRenderFnc;
+	enum class EShadowCasterPass : uint8
+	{
+		// Every caster into RenderTexture, cleared first
+		All,
+		// Static casters into StaticRenderTexture, cleared first
+		Static,
+		// Dynamic casters into RenderTexture on top of the copied static cache, not cleared
+		Dynamic
+	};
+
+	typedef std::function<void(CameraComponent*, const FFrustum* frustum, const Matrix4& lightViewMatrix, int layer, EShadowCasterPass casterPass)> LightRenderFnc;
 
 	class DirectionalLightComponent : public LightComponent
 	{
 	public:
 		std::vector<ShadowLayerData> Layers;
 		std::vector<Matrix4> ShadowMatrices;
+		// Depth of the static casters per cascade, copied into RenderTexture before the dynamic casters are drawn
+		Texture_ptr StaticRenderTexture = nullptr;
+		// Read by SetupShadowmaps, StaticRenderTexture is only created when caching
+		bool CacheStaticShadows = true;
+		// Cascade centers move in steps of this many texels, a cascade is re-rendered only when its center crosses a step
+		float SnapTexels = 64.0f;
 	public:
 		CLASS_OBJ(DirectionalLightComponent, LightComponent);
 
@@ -61,6 +89,10 @@ namespace Aurora
 
 		float CutZ(const int layer) const { return Layers[layer].CutPlane; }
 
+		// Called by Render when the static casters of the scene culling tree changed
+		void InvalidateStaticShadows();
+		void SetLayerUpdateInterval(int layer, uint32_t frames) { Layers[layer].UpdateInterval = std::max(frames, 1u); }
+
 		void Render(DrawCallState& drawCallState, const LightRenderFnc& renderCallback);
 
 		static std::vector<Vector3> FrustumCorners(const Matrix4& imvp, float z0, float z1);
@@ -69,6 +101,9 @@ namespace Aurora
 		std::vector<Vector3> CameraFrustumCorners(CameraComponent* mainCamera, float z0, float z1);
 
 		std::vector<Vector4> CalculateClipPlanes(const Matrix4& lightProjection);
+
+		// Static version of the scene culling tree the caches were invalidated for
+		uint32_t m_StaticGeometryVersion = 0;
 	};
 
 	class PointLightComponent : public LightComponent
@@ -1,9 +1,52 @@
 #include "Mesh.hpp"
+#include "MeshSimplifier.hpp"
 #include "Aurora/Engine.hpp"
 #include "Aurora/Graphics/Base/IRenderDevice.hpp"
+#include "Aurora/Graphics/RenderManager.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <limits>
 
 namespace Aurora
 {
+	static std::atomic<uint32_t> s_NextMeshSortIndex(0);
+
+	Mesh::Mesh() : SortIndex(s_NextMeshSortIndex++), LODHysteresis(0.1f)
+	{
+
+	}
+
+	float Mesh::GetLODScreenSize(LOD lod) const
+	{
+		auto it = LODResources.find(lod);
+
+		if (it != LODResources.end() && it->second.ScreenSize > 0.0f)
+		{
+			return it->second.ScreenSize;
+		}
+
+		return std::exp2(-(float)lod);
+	}
+
+	LOD Mesh::SelectLOD(float screenSize, LOD currentLod) const
+	{
+		LOD lod = 0;
+
+		for (size_t i = 1; i < LODResources.size(); ++i)
+		{
+			// Going coarser needs the size to drop below the band, going finer needs it to rise above it
+			float hysteresis = i <= currentLod ? 1.0f + LODHysteresis : 1.0f - LODHysteresis;
+
+			if (screenSize >= GetLODScreenSize((LOD)i) * hysteresis)
+				break;
+
+			lod = (LOD)i;
+		}
+
+		return lod;
+	}
+
 	void Mesh::UploadToGPU(bool keepCPUData, bool dynamic)
 	{
 		for(auto& it : LODResources)
@@ -16,16 +59,39 @@ namespace Aurora
 				continue;
 			}
 
-			if(lodResource.VertexBuffer && lodResource.VertexBuffer->GetDesc().ByteSize == lodResource.Vertices->GetSize())
+			if(dynamic)
 			{
+				// Dynamic meshes are rewritten often, they keep buffers of their own
+				lodResource.VertexRange.reset();
+				lodResource.IndexRange.reset();
+				lodResource.BaseVertex = 0;
+				lodResource.FirstIndex = 0;
+
+				if(lodResource.VertexBuffer && lodResource.VertexBuffer->GetDesc().ByteSize == lodResource.Vertices->GetSize())
+				{
+
+				}
+				else
+				{
+					lodResource.VertexBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("Mesh VB", lodResource.Vertices->GetSize(), EBufferType::VertexBuffer, EBufferUsage::DynamicDraw));
+				}
 
+				GEngine->GetRenderDevice()->WriteBuffer(lodResource.VertexBuffer, lodResource.Vertices->GetData());
 			}
 			else
 			{
-				lodResource.VertexBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("Mesh VB", lodResource.Vertices->GetSize(), EBufferType::VertexBuffer, dynamic ? EBufferUsage::DynamicDraw : EBufferUsage::StaticDraw));
-			}
+				GPUBufferHeap& vertexHeap = GEngine->GetRenderManager()->GetMeshVertexHeap(lodResource.Vertices->GetStride());
+
+				if(!lodResource.VertexRange || lodResource.VertexRange->Count != lodResource.Vertices->GetCount())
+				{
+					lodResource.VertexRange = vertexHeap.Allocate((uint32_t)lodResource.Vertices->GetCount());
+				}
+
+				vertexHeap.Write(lodResource.VertexRange, lodResource.Vertices->GetData());
 
-			GEngine->GetRenderDevice()->WriteBuffer(lodResource.VertexBuffer, lodResource.Vertices->GetData());
+				lodResource.VertexBuffer = lodResource.VertexRange->Buffer;
+				lodResource.BaseVertex = lodResource.VertexRange->Offset;
+			}
 
 			if(!keepCPUData)
 				lodResource.Vertices.reset();
@@ -35,19 +101,217 @@ namespace Aurora
 				continue;
 			}
 
-			if(lodResource.IndexBuffer && lodResource.IndexBuffer->GetDesc().ByteSize == lodResource.Indices.size() * sizeof(Index_t))
+			if(dynamic)
 			{
+				if(lodResource.IndexBuffer && lodResource.IndexBuffer->GetDesc().ByteSize == lodResource.Indices.size() * sizeof(Index_t))
+				{
+
+				}
+				else
+				{
+					lodResource.IndexBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("Mesh IB", lodResource.Indices.size() * sizeof(Index_t), EBufferType::IndexBuffer, EBufferUsage::DynamicDraw));
+				}
 
+				GEngine->GetRenderDevice()->WriteBuffer(lodResource.IndexBuffer, lodResource.Indices.data());
 			}
 			else
 			{
-				lodResource.IndexBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("Mesh IB", lodResource.Indices.size() * sizeof(Index_t), EBufferType::IndexBuffer, dynamic ? EBufferUsage::DynamicDraw : EBufferUsage::StaticDraw));
-			}
+				GPUBufferHeap& indexHeap = GEngine->GetRenderManager()->GetMeshIndexHeap();
+
+				if(!lodResource.IndexRange || lodResource.IndexRange->Count != lodResource.Indices.size())
+				{
+					lodResource.IndexRange = indexHeap.Allocate((uint32_t)lodResource.Indices.size());
+				}
 
-			GEngine->GetRenderDevice()->WriteBuffer(lodResource.IndexBuffer, lodResource.Indices.data());
+				indexHeap.Write(lodResource.IndexRange, lodResource.Indices.data());
+
+				lodResource.IndexBuffer = lodResource.IndexRange->Buffer;
+				lodResource.FirstIndex = lodResource.IndexRange->Offset;
+			}
 
 			if(!keepCPUData)
 				lodResource.Indices.clear();
 		}
 	}
-}
\ No newline at end of file
+
+	bool StaticMesh::GetTriangles(LOD lod, std::vector<Vector3>& positions, std::vector<uint32_t>& indices)
+	{
+		VertexBuffer<Vertex>* vertexBuffer = GetVertexBuffer<Vertex>(lod);
+
+		if (!vertexBuffer || LODResources[lod].Indices.empty())
+			return false;
+
+		positions.resize(vertexBuffer->GetCount());
+		for (size_t i = 0; i < vertexBuffer->GetCount(); ++i)
+		{
+			positions[i] = vertexBuffer->Get(i).Position;
+		}
+
+		// Only triangle list sections can be indexed as triangles, NumTriangles holds the index count of the section
+		indices.clear();
+		const MeshLodResource& lodResource = LODResources[lod];
+		for (const FMeshSection& section : lodResource.Sections)
+		{
+			if (section.PrimitiveType != EPrimitiveType::TriangleList)
+				continue;
+
+			indices.insert(indices.end(), lodResource.Indices.begin() + section.FirstIndex, lodResource.Indices.begin() + section.FirstIndex + section.NumTriangles);
+		}
+
+		return true;
+	}
+
+	bool StaticMesh::BuildCollisionBVH(LOD lod)
+	{
+		std::vector<Vector3> positions;
+		std::vector<uint32_t> indices;
+
+		if (!GetTriangles(lod, positions, indices))
+		{
+			AU_LOG_WARNING("Could not build collision BVH for ", Name, " because LOD", (int)lod, " has no CPU data !");
+			return false;
+		}
+
+		CollisionBVH = std::make_shared<TriangleBVH>();
+		CollisionBVH->Build(positions, indices);
+		return true;
+	}
+
+	bool StaticMesh::BuildOccluder()
+	{
+		std::vector<Vector3> positions;
+		std::vector<uint32_t> indices;
+
+		// Simplified LODs can move the surface outwards and hide what is behind the real mesh, only LOD0 is conservative
+		if (!GetTriangles(0, positions, indices))
+		{
+			AU_LOG_WARNING("Could not build occluder for ", Name, " because LOD0 has no CPU data !");
+			return false;
+		}
+
+		// Only the vertices used by the triangles are kept
+		std::vector<uint32_t> remap(positions.size(), UINT32_MAX);
+		Occluder = std::make_shared<OccluderGeometry>();
+		Occluder->Indices.reserve(indices.size());
+
+		for (uint32_t index : indices)
+		{
+			if (remap[index] == UINT32_MAX)
+			{
+				remap[index] = (uint32_t)Occluder->Positions.size();
+				Occluder->Positions.push_back(positions[index]);
+			}
+
+			Occluder->Indices.push_back(remap[index]);
+		}
+
+		return true;
+	}
+
+	uint8_t StaticMesh::GenerateLODs(uint8_t lodCount, float reductionRatio, float maxError)
+	{
+		VertexBuffer<Vertex>* baseVertexBuffer = GetVertexBuffer<Vertex>(0);
+
+		if (!baseVertexBuffer || LODResources[0].Indices.empty())
+		{
+			AU_LOG_WARNING("Could not generate LODs for ", Name, " because LOD0 has no CPU data !");
+			return (uint8_t)LODResources.size();
+		}
+
+		if (LODResources.size() > 1)
+		{
+			AU_LOG_WARNING("Mesh ", Name, " already has LODs, generation skipped");
+			return (uint8_t)LODResources.size();
+		}
+
+		std::vector<Vector3> positions(baseVertexBuffer->GetCount());
+		Vector3 boundsMin(std::numeric_limits<float>::max());
+		Vector3 boundsMax(std::numeric_limits<float>::lowest());
+
+		for (size_t i = 0; i < baseVertexBuffer->GetCount(); ++i)
+		{
+			positions[i] = baseVertexBuffer->Get(i).Position;
+			boundsMin = glm::min(boundsMin, positions[i]);
+			boundsMax = glm::max(boundsMax, positions[i]);
+		}
+
+		const float errorLimit = maxError * glm::length(boundsMax - boundsMin);
+
+		// Copied because adding LODs may move the resources of the map
+		const std::vector<FMeshSection> baseSections = LODResources[0].Sections;
+		const EIndexBufferFormat indexFormat = LODResources[0].IndexFormat;
+
+		// Sections are simplified on their own so material borders stay where they are
+		std::vector<std::vector<Index_t>> sectionIndices(baseSections.size());
+		size_t previousIndexCount = 0;
+
+		for (size_t sectionID = 0; sectionID < baseSections.size(); ++sectionID)
+		{
+			const FMeshSection& section = baseSections[sectionID];
+			const std::vector<Index_t>& baseIndices = LODResources[0].Indices;
+			sectionIndices[sectionID].assign(baseIndices.begin() + section.FirstIndex, baseIndices.begin() + section.FirstIndex + section.NumTriangles);
+			previousIndexCount += section.NumTriangles;
+		}
+
+		std::vector<Index_t> simplified;
+
+		for (LOD lod = 1; lod < lodCount; ++lod)
+		{
+			size_t indexCount = 0;
+
+			for (size_t sectionID = 0; sectionID < baseSections.size(); ++sectionID)
+			{
+				if (baseSections[sectionID].PrimitiveType != EPrimitiveType::TriangleList)
+				{
+					indexCount += sectionIndices[sectionID].size();
+					continue;
+				}
+
+				size_t target = (size_t)((float)(sectionIndices[sectionID].size() / 3) * reductionRatio) * 3;
+				MeshSimplifier::Simplify(positions, sectionIndices[sectionID], target, errorLimit, simplified);
+
+				sectionIndices[sectionID].swap(simplified);
+				indexCount += sectionIndices[sectionID].size();
+			}
+
+			// The error limit stopped the simplification, another LOD would look the same
+			if ((float)indexCount > (float)previousIndexCount * 0.9f)
+			{
+				AU_LOG_INFO("LOD generation of ", Name, " stopped at LOD", (int)lod, " because of the error limit");
+				break;
+			}
+
+			previousIndexCount = indexCount;
+
+			// Only keep the vertices the simplified sections still use
+			std::vector<Index_t> vertexRemap(positions.size(), UINT32_MAX);
+
+			MeshLodResource* lodResource;
+			VertexBuffer<Vertex>* vertexBuffer = CreateVertexBuffer<Vertex>(lod, &lodResource);
+			lodResource->IndexFormat = indexFormat;
+			lodResource->Indices.reserve(indexCount);
+
+			for (size_t sectionID = 0; sectionID < baseSections.size(); ++sectionID)
+			{
+				FMeshSection section = baseSections[sectionID];
+				section.FirstIndex = (Index_t)lodResource->Indices.size();
+				section.NumTriangles = (Index_t)sectionIndices[sectionID].size();
+
+				for (Index_t index : sectionIndices[sectionID])
+				{
+					if (vertexRemap[index] == UINT32_MAX)
+					{
+						vertexRemap[index] = (Index_t)vertexBuffer->GetCount();
+						vertexBuffer->Add(baseVertexBuffer->Get(index));
+					}
+
+					lodResource->Indices.push_back(vertexRemap[index]);
+				}
+
+				lodResource->Sections.push_back(section);
+			}
+		}
+
+		return (uint8_t)LODResources.size();
+	}
+}
@@ -6,8 +6,10 @@
 #include "Aurora/Core/Library.hpp"
 #include "Aurora/Core/Archive.hpp"
 #include "Aurora/Graphics/Base/Buffer.hpp"
+#include "Aurora/Graphics/GPUBufferHeap.hpp"
 #include "Aurora/Graphics/Material/Material.hpp"
 #include "Aurora/Physics/AABB.hpp"
+#include "Aurora/Physics/TriangleBVH.hpp"
 #include "Aurora/Tools/robin_hood.h"
 #include "VertexBuffer.hpp"
 
@@ -65,13 +67,31 @@ namespace Aurora
 		Buffer_ptr IndexBuffer;
 		bool NeedUpdateBuffers;
 
+		// Static LODs live in the shared mesh heaps, the buffers above then point to the heap pages
+		GPUBufferRange_ptr VertexRange;
+		GPUBufferRange_ptr IndexRange;
+		// Offsets into the buffers added to every draw, zero for LODs with their own buffers
+		uint32_t BaseVertex;
+		uint32_t FirstIndex;
+
 		EIndexBufferFormat IndexFormat;
 
-		MeshLodResource() : Vertices(nullptr), Indices(), Sections(), VertexBuffer(nullptr), IndexBuffer(nullptr), NeedUpdateBuffers(false), IndexFormat(EIndexBufferFormat::Uint32) { }
+		// Projected size, as a fraction of the view height, below which this LOD replaces the previous one.
+		// Zero uses the default, which halves with every LOD.
+		float ScreenSize;
+
+		MeshLodResource() : Vertices(nullptr), Indices(), Sections(), VertexBuffer(nullptr), IndexBuffer(nullptr), NeedUpdateBuffers(false), VertexRange(nullptr), IndexRange(nullptr), BaseVertex(0), FirstIndex(0), IndexFormat(EIndexBufferFormat::Uint32), ScreenSize(0.0f) { }
 	};
 
 	typedef std::unordered_map<int32_t, MaterialSlot> MaterialSet;
 
+	// Simplified triangles rasterized into the OcclusionBuffer, in mesh space
+	struct OccluderGeometry
+	{
+		std::vector<Vector3> Positions;
+		std::vector<uint32_t> Indices;
+	};
+
 	AU_CLASS(Mesh) : public ObjectBase
 	{
 	public:
@@ -80,6 +100,20 @@ namespace Aurora
 		robin_hood::unordered_map<LOD, MeshLodResource> LODResources;
 		MaterialSet MaterialSlots;
 		AABB m_Bounds;
+		// Triangle hierarchy for exact ray casts and mesh colliders, only built on request because it needs CPU data
+		std::shared_ptr<TriangleBVH> CollisionBVH;
+		// Occluder triangles for software occlusion culling, only built on request for the same reason
+		std::shared_ptr<OccluderGeometry> Occluder;
+		// Sequential id used for draw sort keys
+		uint32_t SortIndex;
+		// Relative band around the LOD screen sizes that has to be crossed before switching back, keeps LODs from flickering
+		float LODHysteresis;
+
+		Mesh();
+
+		[[nodiscard]] float GetLODScreenSize(LOD lod) const;
+		// Coarsest LOD whose screen size is above the projected size, currentLod is the LOD used last frame
+		[[nodiscard]] LOD SelectLOD(float screenSize, LOD currentLod) const;
 
 		[[nodiscard]] virtual VertexLayout GetVertexLayoutDesc() const = 0;
 
@@ -217,6 +251,19 @@ namespace Aurora
 			}
 		}
 
+		// Builds CollisionBVH from the CPU data of the LOD, has to run before UploadToGPU drops it
+		bool BuildCollisionBVH(LOD lod = 0);
+		// Builds Occluder from LOD0, same restriction as BuildCollisionBVH
+		bool BuildOccluder();
+
+		// Fills LODs 1 to lodCount - 1 by simplifying LOD 0, each LOD keeps reductionRatio of the triangles of the previous one.
+		// Stops early when a LOD would exceed maxError, relative to the size of the mesh bounds. Returns the number of LODs.
+		uint8_t GenerateLODs(uint8_t lodCount, float reductionRatio, float maxError);
+	private:
+		// Positions and triangle list indices of the LOD, false when its CPU data is gone
+		bool GetTriangles(LOD lod, std::vector<Vector3>& positions, std::vector<uint32_t>& indices);
+	public:
+
 		void Serialize(Archive& archive) override
 		{
 			archive << Name;
@@ -0,0 +1,350 @@
+#include "MeshSimplifier.hpp"
+
+#include <queue>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+
+namespace Aurora
+{
+	// Surviving triangles may not turn further than this, as cosine between the old and new normal
+	static constexpr float MinNormalCosine = 0.25f;
+
+	namespace
+	{
+		// Symmetric 4x4 matrix of summed plane equations, only the upper triangle is stored
+		struct Quadric
+		{
+			double A00 = 0, A01 = 0, A02 = 0, A03 = 0;
+			double A11 = 0, A12 = 0, A13 = 0;
+			double A22 = 0, A23 = 0;
+			double A33 = 0;
+
+			void AddPlane(double a, double b, double c, double d)
+			{
+				A00 += a * a; A01 += a * b; A02 += a * c; A03 += a * d;
+				A11 += b * b; A12 += b * c; A13 += b * d;
+				A22 += c * c; A23 += c * d;
+				A33 += d * d;
+			}
+
+			Quadric& operator+=(const Quadric& other)
+			{
+				A00 += other.A00; A01 += other.A01; A02 += other.A02; A03 += other.A03;
+				A11 += other.A11; A12 += other.A12; A13 += other.A13;
+				A22 += other.A22; A23 += other.A23;
+				A33 += other.A33;
+				return *this;
+			}
+
+			// Sum of squared distances of the point to all planes
+			[[nodiscard]] double Evaluate(const Vector3& point) const
+			{
+				double x = point.x, y = point.y, z = point.z;
+				double error = A00 * x * x + 2.0 * A01 * x * y + 2.0 * A02 * x * z + 2.0 * A03 * x
+					+ A11 * y * y + 2.0 * A12 * y * z + 2.0 * A13 * y
+					+ A22 * z * z + 2.0 * A23 * z
+					+ A33;
+				return std::max(error, 0.0);
+			}
+		};
+
+		struct EdgeCollapse
+		{
+			double Cost;
+			uint32_t From;
+			uint32_t To;
+			uint32_t FromVersion;
+			uint32_t ToVersion;
+
+			bool operator>(const EdgeCollapse& other) const { return Cost > other.Cost; }
+		};
+	}
+
+	float MeshSimplifier::Simplify(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices, size_t targetIndexCount, float maxError, std::vector<uint32_t>& outIndices)
+	{
+		outIndices.clear();
+
+		const auto vertexCount = (uint32_t)positions.size();
+
+		// Weld vertices with equal positions, remap points every vertex at the first vertex of its group
+		std::vector<uint32_t> order(vertexCount);
+		std::iota(order.begin(), order.end(), 0u);
+		std::sort(order.begin(), order.end(), [&positions](uint32_t left, uint32_t right)
+		{
+			const Vector3& a = positions[left];
+			const Vector3& b = positions[right];
+
+			if (a.x != b.x) return a.x < b.x;
+			if (a.y != b.y) return a.y < b.y;
+			if (a.z != b.z) return a.z < b.z;
+			return left < right;
+		});
+
+		std::vector<uint32_t> remap(vertexCount);
+		for (uint32_t i = 0; i < vertexCount; ++i)
+		{
+			bool sameAsPrevious = i > 0 && positions[order[i]] == positions[order[i - 1]];
+			remap[order[i]] = sameAsPrevious ? remap[order[i - 1]] : order[i];
+		}
+
+		// Corners keep the source vertex for the output, the topology always goes through remap
+		std::vector<uint32_t> corners;
+		corners.reserve(indices.size());
+
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			uint32_t a = remap[indices[i]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
+
+			if (a == b || b == c || c == a)
+				continue;
+
+			corners.insert(corners.end(), {indices[i], indices[i + 1], indices[i + 2]});
+		}
+
+		const auto triangleCount = (uint32_t)(corners.size() / 3);
+		uint32_t liveTriangles = triangleCount;
+
+		if (triangleCount * 3 <= targetIndexCount)
+		{
+			outIndices = corners;
+			return 0.0f;
+		}
+
+		auto corner = [&](uint32_t triangle, uint32_t k) { return remap[corners[triangle * 3 + k]]; };
+
+		// Positions with more than one referenced vertex sit on an attribute seam
+		std::vector<uint8_t> referenced(vertexCount, 0);
+		std::vector<uint8_t> copyCount(vertexCount, 0);
+		for (uint32_t vertex : corners)
+			referenced[vertex] = 1;
+		for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+			if (referenced[vertex] && copyCount[remap[vertex]] < 2)
+				copyCount[remap[vertex]]++;
+
+		std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+		std::vector<Quadric> quadrics(vertexCount);
+
+		std::vector<uint64_t> edges;
+		edges.reserve(triangleCount * 3);
+
+		for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+		{
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				uint32_t a = corner(triangle, k), b = corner(triangle, (k + 1) % 3);
+				vertexTriangles[a].push_back(triangle);
+				edges.push_back(((uint64_t)std::min(a, b) << 32) | std::max(a, b));
+			}
+
+			const Vector3& p0 = positions[corner(triangle, 0)];
+			Vector3 normal = glm::cross(positions[corner(triangle, 1)] - p0, positions[corner(triangle, 2)] - p0);
+			float length = glm::length(normal);
+
+			if (length <= 0.0f)
+				continue;
+
+			normal /= length;
+			double d = -glm::dot(normal, p0);
+
+			for (uint32_t k = 0; k < 3; ++k)
+				quadrics[corner(triangle, k)].AddPlane(normal.x, normal.y, normal.z, d);
+		}
+
+		// Edges not shared by exactly two triangles are open borders or non manifold, their vertices stay in place
+		std::vector<uint8_t> locked(vertexCount, 0);
+		std::sort(edges.begin(), edges.end());
+
+		for (size_t i = 0; i < edges.size();)
+		{
+			size_t run = i;
+			while (run < edges.size() && edges[run] == edges[i])
+				++run;
+
+			if (run - i != 2)
+			{
+				locked[(uint32_t)(edges[i] >> 32)] = 1;
+				locked[(uint32_t)(edges[i] & 0xFFFFFFFF)] = 1;
+			}
+
+			i = run;
+		}
+
+		std::vector<uint8_t> deadTriangles(triangleCount, 0);
+		std::vector<uint8_t> removed(vertexCount, 0);
+		std::vector<uint32_t> versions(vertexCount, 0);
+		std::priority_queue<EdgeCollapse, std::vector<EdgeCollapse>, std::greater<>> queue;
+
+		auto pushCollapse = [&](uint32_t from, uint32_t to)
+		{
+			if (locked[from] || copyCount[from] > 1)
+				return;
+
+			Quadric quadric = quadrics[from];
+			quadric += quadrics[to];
+			queue.push({quadric.Evaluate(positions[to]), from, to, versions[from], versions[to]});
+		};
+
+		for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+		{
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				uint32_t a = corner(triangle, k), b = corner(triangle, (k + 1) % 3);
+				pushCollapse(a, b);
+				pushCollapse(b, a);
+			}
+		}
+
+		std::vector<uint32_t> fromNeighbours;
+		std::vector<uint32_t> toNeighbours;
+
+		// Rejects collapses that flip surviving triangles or would glue the surface into a non manifold one
+		auto isCollapseValid = [&](uint32_t from, uint32_t to) -> bool
+		{
+			fromNeighbours.clear();
+			toNeighbours.clear();
+			uint32_t sharedTriangles = 0;
+
+			for (uint32_t triangle : vertexTriangles[from])
+			{
+				if (deadTriangles[triangle])
+					continue;
+
+				uint32_t a = corner(triangle, 0), b = corner(triangle, 1), c = corner(triangle, 2);
+
+				for (uint32_t vertex : {a, b, c})
+					if (vertex != from)
+						fromNeighbours.push_back(vertex);
+
+				if (a == to || b == to || c == to)
+				{
+					++sharedTriangles;
+					continue;
+				}
+
+				Vector3 oldNormal = glm::cross(positions[b] - positions[a], positions[c] - positions[a]);
+
+				a = a == from ? to : a;
+				b = b == from ? to : b;
+				c = c == from ? to : c;
+
+				Vector3 newNormal = glm::cross(positions[b] - positions[a], positions[c] - positions[a]);
+				float newLength2 = glm::dot(newNormal, newNormal);
+
+				if (newLength2 <= 0.0f || glm::dot(oldNormal, newNormal) < MinNormalCosine * glm::sqrt(glm::dot(oldNormal, oldNormal) * newLength2))
+					return false;
+			}
+
+			if (sharedTriangles == 0)
+				return false;
+
+			for (uint32_t triangle : vertexTriangles[to])
+			{
+				if (deadTriangles[triangle])
+					continue;
+
+				for (uint32_t k = 0; k < 3; ++k)
+					if (corner(triangle, k) != to)
+						toNeighbours.push_back(corner(triangle, k));
+			}
+
+			std::sort(fromNeighbours.begin(), fromNeighbours.end());
+			fromNeighbours.erase(std::unique(fromNeighbours.begin(), fromNeighbours.end()), fromNeighbours.end());
+			std::sort(toNeighbours.begin(), toNeighbours.end());
+			toNeighbours.erase(std::unique(toNeighbours.begin(), toNeighbours.end()), toNeighbours.end());
+
+			size_t commonNeighbours = 0;
+			for (uint32_t vertex : fromNeighbours)
+				commonNeighbours += std::binary_search(toNeighbours.begin(), toNeighbours.end(), vertex);
+
+			// Every common neighbour that does not close a triangle over the edge would become a non manifold edge
+			return commonNeighbours <= sharedTriangles;
+		};
+
+		const double maxCost = (double)maxError * (double)maxError;
+		double reachedCost = 0.0;
+
+		while (liveTriangles * 3 > targetIndexCount && !queue.empty())
+		{
+			EdgeCollapse collapse = queue.top();
+			queue.pop();
+
+			uint32_t from = collapse.From;
+			uint32_t to = collapse.To;
+
+			if (removed[from] || removed[to] || versions[from] != collapse.FromVersion || versions[to] != collapse.ToVersion)
+				continue;
+
+			// Valid entries are exact, everything left in the queue costs at least as much
+			if (collapse.Cost > maxCost)
+				break;
+
+			if (!isCollapseValid(from, to))
+				continue;
+
+			// From has a single vertex, so every triangle around it uses the same vertex of the target position
+			uint32_t toVertex = UINT32_MAX;
+			for (uint32_t triangle : vertexTriangles[from])
+			{
+				if (deadTriangles[triangle])
+					continue;
+
+				for (uint32_t k = 0; k < 3 && toVertex == UINT32_MAX; ++k)
+					if (corner(triangle, k) == to)
+						toVertex = corners[triangle * 3 + k];
+			}
+
+			for (uint32_t triangle : vertexTriangles[from])
+			{
+				if (deadTriangles[triangle])
+					continue;
+
+				if (corner(triangle, 0) == to || corner(triangle, 1) == to || corner(triangle, 2) == to)
+				{
+					deadTriangles[triangle] = 1;
+					--liveTriangles;
+					continue;
+				}
+
+				for (uint32_t k = 0; k < 3; ++k)
+					if (corner(triangle, k) == from)
+						corners[triangle * 3 + k] = toVertex;
+
+				vertexTriangles[to].push_back(triangle);
+			}
+
+			vertexTriangles[from].clear();
+			removed[from] = 1;
+			quadrics[to] += quadrics[from];
+			versions[to]++;
+			reachedCost = std::max(reachedCost, collapse.Cost);
+
+			std::vector<uint32_t>& toTriangles = vertexTriangles[to];
+			toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(), [&deadTriangles](uint32_t triangle) { return deadTriangles[triangle] != 0; }), toTriangles.end());
+
+			for (uint32_t triangle : toTriangles)
+			{
+				for (uint32_t k = 0; k < 3; ++k)
+				{
+					uint32_t vertex = corner(triangle, k);
+
+					if (vertex == to)
+						continue;
+
+					pushCollapse(to, vertex);
+					pushCollapse(vertex, to);
+				}
+			}
+		}
+
+		outIndices.reserve(liveTriangles * 3);
+
+		for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+		{
+			if (!deadTriangles[triangle])
+				outIndices.insert(outIndices.end(), corners.begin() + triangle * 3, corners.begin() + triangle * 3 + 3);
+		}
+
+		return (float)std::sqrt(reachedCost);
+	}
+}
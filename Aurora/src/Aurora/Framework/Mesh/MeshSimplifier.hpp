@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Core/Math.hpp"
+
+namespace Aurora
+{
+	// Quadric error metric simplification with half edge collapses.
+	// Vertices are never moved or created, the result indexes the input vertices so every vertex attribute stays valid.
+	// Vertices sharing a position are one vertex for the topology, vertices on open borders and on attribute seams stay in place.
+	namespace MeshSimplifier
+	{
+		// Collapses edges until at most targetIndexCount indices are left or the cheapest collapse would exceed maxError.
+		// Returns the largest error of the applied collapses, in mesh units. It bounds the distance of removed
+		// vertices to the planes of the triangles that were merged into the remaining surface.
+		AU_API float Simplify(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices, size_t targetIndexCount, float maxError, std::vector<uint32_t>& outIndices);
+	}
+}
@@ -0,0 +1,20 @@
+#include "MeshComponent.hpp"
+#include "Scene.hpp"
+
+namespace Aurora
+{
+	void MeshComponent::SetStatic(bool isStatic)
+	{
+		if (m_Static == isStatic)
+		{
+			return;
+		}
+
+		m_Static = isStatic;
+
+		if (m_Scene)
+		{
+			m_Scene->GetMeshCullingTree().Refresh(this);
+		}
+	}
+}
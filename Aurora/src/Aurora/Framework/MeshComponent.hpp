@@ -10,7 +10,16 @@ namespace Aurora
 	protected:
 		MaterialSet m_MaterialSlots;
 		bool m_IgnoreFrustumChecks = false;
+		// Static components are not expected to move, their shadows are cached by directional lights
+		// and their bounds are only read when they enter the scene MeshCullingTree
+		bool m_Static = false;
+		// Occluders are rasterized into the occlusion buffer of the camera, their mesh needs Mesh::Occluder
+		bool m_Occluder = false;
+		// LOD picked by the last perspective view, views without a screen size (shadows, orthographic) reuse it
+		LOD m_CurrentLod = 0;
 	public:
+		friend class SceneRenderer;
+
 		CLASS_OBJ(MeshComponent, SceneComponent);
 
 		MeshComponent() = default;
@@ -22,11 +31,22 @@ namespace Aurora
 
 		[[nodiscard]] virtual TTypeID GetSupportedMeshType() const = 0;
 
+		// Animated components upload their bones before drawing, which splits them from multi draw batches
+		[[nodiscard]] virtual bool HasAnimation() const { return false; }
 		virtual void UploadAnimation(Buffer_ptr& buffer) {}
 
 		void SetIgnoreFrustumChecks(bool ignoreFrustum = true) { m_IgnoreFrustumChecks = ignoreFrustum; }
 		[[nodiscard]] bool IsIgnoringFrustumChecks() const { return m_IgnoreFrustumChecks; }
 
+		// Moves the component between the static and dynamic parts of the scene culling tree
+		void SetStatic(bool isStatic = true);
+		[[nodiscard]] bool IsStatic() const { return m_Static; }
+
+		void SetOccluder(bool isOccluder = true) { m_Occluder = isOccluder; }
+		[[nodiscard]] bool IsOccluder() const { return m_Occluder; }
+
+		[[nodiscard]] LOD GetCurrentLod() const { return m_CurrentLod; }
+
 		void SetMaterial(int slot, const matref& material)
 		{
 			au_assert(slot < m_MaterialSlots.size());
@@ -10,4 +10,36 @@ namespace Aurora
 		bounds.SetOffset(GetParent()->GetWorldPosition() + m_Origin);
 		return bounds;
 	}
-}
\ No newline at end of file
+
+	Matrix4 MeshColliderComponent::GetColliderMatrix() const
+	{
+		return glm::translate(m_Origin) * GetParent()->GetTransformationMatrix();
+	}
+
+	AABB MeshColliderComponent::GetTransformedAABB() const
+	{
+		return GetAABB().Transform(GetColliderMatrix());
+	}
+
+	bool MeshColliderComponent::CollideWith(const AABB& bounds, const AABB& encapsulatedBounds, Vector3& velocity, double updateRate, uint8_t axis)
+	{
+		if (!m_TriangleBVH)
+			return false;
+
+		return m_TriangleBVH->OverlapsBox(encapsulatedBounds.Transform(glm::inverse(GetColliderMatrix())));
+	}
+
+	bool MeshColliderComponent::RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, float& distance, Vector3& normal) const
+	{
+		if (!m_TriangleBVH)
+			return false;
+
+		TriangleHit hit = {};
+		if (!m_TriangleBVH->RayCast(GetColliderMatrix(), origin, direction, maxDistance, hit))
+			return false;
+
+		distance = hit.Distance;
+		normal = hit.Normal;
+		return true;
+	}
+}
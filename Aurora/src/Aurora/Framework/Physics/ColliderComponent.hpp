@@ -4,6 +4,7 @@
 #include "../Transform.hpp"
 #include "Aurora/Physics/AABB.hpp"
 #include "Aurora/Physics/Types.hpp"
+#include "Aurora/Physics/TriangleBVH.hpp"
 
 namespace Aurora
 {
@@ -38,7 +39,7 @@ namespace Aurora
 		inline Vector3& GetOrigin() { return m_Origin; }
 
 		[[nodiscard]] const AABB& GetAABB() const { return m_Bounds; }
-		[[nodiscard]] AABB GetTransformedAABB() const;
+		[[nodiscard]] virtual AABB GetTransformedAABB() const;
 	};
 
 	class ProxyColliderComponent : public ColliderComponent
@@ -83,4 +84,38 @@ namespace Aurora
 		}
 
 	};
+
+	// Static collider over a triangle BVH, usually StaticMesh::CollisionBVH. It follows the full parent transform,
+	// moving bodies are tested conservatively with their swept bounds transformed into mesh space.
+	class AU_API MeshColliderComponent : public ProxyColliderComponent
+	{
+	private:
+		std::shared_ptr<TriangleBVH> m_TriangleBVH;
+	public:
+		CLASS_OBJ(MeshColliderComponent, ProxyColliderComponent);
+
+		MeshColliderComponent() : ProxyColliderComponent(), m_TriangleBVH(nullptr) {}
+
+		explicit MeshColliderComponent(const std::shared_ptr<TriangleBVH>& triangleBVH) : ProxyColliderComponent()
+		{
+			SetTriangleBVH(triangleBVH);
+		}
+
+		inline void SetTriangleBVH(const std::shared_ptr<TriangleBVH>& triangleBVH)
+		{
+			m_TriangleBVH = triangleBVH;
+			m_Bounds = triangleBVH ? triangleBVH->GetBounds() : AABB();
+		}
+
+		[[nodiscard]] inline const std::shared_ptr<TriangleBVH>& GetTriangleBVH() const { return m_TriangleBVH; }
+
+		[[nodiscard]] AABB GetTransformedAABB() const override;
+
+		bool CollideWith(const AABB& bounds, const AABB& encapsulatedBounds, Vector3& velocity, double updateRate, uint8_t axis) override;
+
+		// Exact ray test in world space, direction must be normalized
+		bool RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, float& distance, Vector3& normal) const;
+	private:
+		[[nodiscard]] Matrix4 GetColliderMatrix() const;
+	};
 }
@@ -12,6 +12,8 @@ namespace Aurora
 		bool m_CanSleep;
 		bool m_HasGravity;
 		bool m_IsKinematic;
+		bool m_ContinuousCollision;
+		uint32_t m_MaxSubsteps;
 
 		float m_Mass;
 		float m_Friction;
@@ -19,7 +21,14 @@ namespace Aurora
 		Vector3 m_Velocity;
 		Vector3 m_AngularVelocity;
 		Vector3 m_Acceleration;
+
+		// Root location before and after the last physics step, used for render interpolation
+		Vector3 m_PreviousLocation;
+		Vector3 m_CurrentLocation;
+		bool m_HasPhysicsState;
 	public:
+		friend class PhysicsWorld;
+
 		bool CollidedSides[3];
 
 		CLASS_OBJ(RigidBodyComponent, ActorComponent);
@@ -30,11 +39,16 @@ namespace Aurora
 			m_CanSleep(true),
 			m_HasGravity(true),
 			m_IsKinematic(false),
+			m_ContinuousCollision(false),
+			m_MaxSubsteps(8),
 			m_Mass(1),
 			m_Friction(0),
 			m_Velocity(0),
 			m_AngularVelocity(0),
-			m_Acceleration(0)
+			m_Acceleration(0),
+			m_PreviousLocation(0),
+			m_CurrentLocation(0),
+			m_HasPhysicsState(false)
 		{
 
 		}
@@ -59,6 +73,14 @@ namespace Aurora
 		[[nodiscard]] bool IsKinematic() const { return m_IsKinematic; }
 		void SetIsKinematic(bool mIsKinematic) { m_IsKinematic = mIsKinematic; }
 
+		// Fast bodies are swept against box colliders so they do not tunnel through thin geometry
+		[[nodiscard]] bool IsContinuousCollision() const { return m_ContinuousCollision; }
+		void SetContinuousCollision(bool continuousCollision) { m_ContinuousCollision = continuousCollision; }
+
+		// Upper bound of substeps a continuous body may split one physics step into
+		[[nodiscard]] uint32_t GetMaxSubsteps() const { return m_MaxSubsteps; }
+		void SetMaxSubsteps(uint32_t maxSubsteps) { m_MaxSubsteps = std::max(maxSubsteps, 1u); }
+
 		Transform& GetWorldTransform();
 	};
 }
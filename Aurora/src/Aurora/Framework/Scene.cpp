@@ -1,5 +1,7 @@
 #include "Scene.hpp"
 #include "Aurora/Core/Common.hpp"
+#include "MeshComponent.hpp"
+#include "Physics/ColliderComponent.hpp"
 
 namespace Aurora
 {
@@ -55,6 +57,73 @@ namespace Aurora
 		m_ActorMemory.DeAllocAndUnload<Actor>(actor);
 	}
 
+	void Scene::RegisterComponent(ActorComponent* component)
+	{
+		if (MeshComponent* meshComponent = MeshComponent::SafeCast(component))
+		{
+			m_MeshCullingTree.Add(meshComponent);
+		}
+
+		if (ColliderComponent* collider = ColliderComponent::SafeCast(component))
+		{
+			m_PhysicsWorld.AddCollider(collider);
+		}
+	}
+
+	void Scene::UnregisterComponent(ActorComponent* component)
+	{
+		if (MeshComponent* meshComponent = MeshComponent::SafeCast(component))
+		{
+			m_MeshCullingTree.Remove(meshComponent);
+		}
+
+		if (ColliderComponent* collider = ColliderComponent::SafeCast(component))
+		{
+			m_PhysicsWorld.RemoveCollider(collider);
+		}
+
+		SceneComponent* sceneComponent = SceneComponent::SafeCast(component);
+		if (sceneComponent && sceneComponent->m_TransformChanged)
+		{
+			VectorRemove(m_MovedComponents, sceneComponent);
+			sceneComponent->m_TransformChanged = false;
+		}
+	}
+
+	void Scene::FlushMovedComponents()
+	{
+		for (SceneComponent* component : m_MovedComponents)
+		{
+			component->m_TransformChanged = false;
+			RefreshMovedComponent(component);
+		}
+
+		m_MovedComponents.clear();
+	}
+
+	void Scene::RefreshMovedComponent(SceneComponent* component)
+	{
+		// Dynamic meshes are read by the culling tree every update, static ones have to be reinserted
+		MeshComponent* meshComponent = MeshComponent::SafeCast(component);
+		if (meshComponent && meshComponent->IsStatic())
+		{
+			m_MeshCullingTree.Refresh(meshComponent);
+		}
+
+		// Attached components follow the transform of their parent
+		for (ActorComponent* child : component->GetComponents())
+		{
+			if (SceneComponent* sceneComponent = SceneComponent::SafeCast(child))
+			{
+				RefreshMovedComponent(sceneComponent);
+			}
+			else if (ColliderComponent* collider = ColliderComponent::SafeCast(child))
+			{
+				m_PhysicsWorld.UpdateCollider(collider);
+			}
+		}
+	}
+
 	void Scene::Update(double delta)
 	{
 		// Iterate from end to enable destroy while updating
@@ -69,5 +138,7 @@ namespace Aurora
 		}
 
 		m_PhysicsWorld.Update(delta);
+
+		FlushMovedComponents();
 	}
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Aurora/Logger/Logger.hpp"
 #include "Aurora/Memory/Aum.hpp"
 #include "Aurora/Physics/PhysicsWorld.hpp"
+#include "Aurora/Render/MeshCullingTree.hpp"
 #include "ComponentStorage.hpp"
 #include "SceneComponent.hpp"
 #include "Actor.hpp"
@@ -18,13 +19,18 @@ namespace Aurora
 		std::vector<Actor*> m_Actors;
 		ComponentStorage m_ComponentStorage;
 		PhysicsWorld m_PhysicsWorld;
+		MeshCullingTree m_MeshCullingTree;
+		// Components whose transform may have changed, their colliders are refitted on the next flush
+		std::vector<SceneComponent*> m_MovedComponents;
 	public:
 		friend class Actor;
+		friend class SceneComponent;
 
 		Scene();
 		~Scene();
 
 		inline PhysicsWorld& GetPhysicsWorld() { return m_PhysicsWorld; }
+		inline MeshCullingTree& GetMeshCullingTree() { return m_MeshCullingTree; }
 
 		template<class T, class RootCmp = typename T::DefaultComponent_t, typename std::enable_if<std::is_base_of<Actor, T>::value>::type* = nullptr>
 		T* SpawnActor(const String& name, const Vector3& position = Vector3(0.0), const Vector3& rotation = Vector3(0.0), const Vector3& scale = Vector3(1.0))
@@ -80,8 +86,15 @@ namespace Aurora
 
 		void Update(double delta);
 
+		// Refreshes the broadphase entries and static culling entries under the moved components, done by Update, before culling and before physics queries
+		void FlushMovedComponents();
+
 	public:
 		void FinishSpawningActor(Actor* actor);
 		void DestroyActor(Actor* actor);
+	private:
+		void RegisterComponent(ActorComponent* component);
+		void UnregisterComponent(ActorComponent* component);
+		void RefreshMovedComponent(SceneComponent* component);
 	};
 }
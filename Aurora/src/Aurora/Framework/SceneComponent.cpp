@@ -1,18 +1,47 @@
 #include "SceneComponent.hpp"
 #include "Aurora/Core/Common.hpp"
 #include "Actor.hpp"
+#include "Scene.hpp"
 
 namespace Aurora
 {
-	SceneComponent::SceneComponent() : ActorComponent()
+	SceneComponent::SceneComponent() : ActorComponent(), m_InterpolationOffset(0.0f)
 	{
 
 	}
 
+	void SceneComponent::MarkTransformChanged()
+	{
+		if (m_Scene == nullptr || m_TransformChanged)
+		{
+			return;
+		}
+
+		m_TransformChanged = true;
+		m_Scene->m_MovedComponents.push_back(this);
+	}
+
 	Matrix4 SceneComponent::GetTransformationMatrix() const
+	{
+		return ComputeTransformationMatrix(false);
+	}
+
+	Matrix4 SceneComponent::GetRenderTransformationMatrix() const
+	{
+		return ComputeTransformationMatrix(true);
+	}
+
+	Matrix4 SceneComponent::ComputeTransformationMatrix(bool interpolated) const
 	{
 		// TODO: Cache matrix and update it only when transform changes!
 
+		Matrix4 localTransform = m_Transform.GetTransform();
+
+		if (interpolated)
+		{
+			localTransform[3] += Vector4(m_InterpolationOffset, 0.0f);
+		}
+
 		if(m_Parent)
 		{
 			if (not m_Socket.empty())
@@ -21,13 +50,13 @@ namespace Aurora
 
 				if (socketIndex >= 0)
 				{
-					return m_Parent->GetTransformationMatrix() * m_Parent->GetSocketTransform(socketIndex) * m_Transform.GetTransform();
+					return m_Parent->ComputeTransformationMatrix(interpolated) * m_Parent->GetSocketTransform(socketIndex) * localTransform;
 				}
 			}
 
-			return m_Parent->GetTransformationMatrix() * m_Transform.GetTransform();
+			return m_Parent->ComputeTransformationMatrix(interpolated) * localTransform;
 		}
 
-		return m_Transform.GetTransform();
+		return localTransform;
 	}
 }
\ No newline at end of file
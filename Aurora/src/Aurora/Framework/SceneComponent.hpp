@@ -9,10 +9,14 @@ namespace Aurora
 	{
 	private:
 		Transform m_Transform;
+		Vector3 m_InterpolationOffset;
 		std::vector<ActorComponent*> m_Components;
+		// Queued in the scene since the last Scene::FlushMovedComponents
+		bool m_TransformChanged = false;
 	public:
 		friend class Actor;
 		friend class ActorComponent;
+		friend class Scene;
 
 		CLASS_OBJ(SceneComponent, ActorComponent);
 
@@ -20,13 +24,22 @@ namespace Aurora
 		~SceneComponent() override = default;
 
 		[[nodiscard]] const Transform& GetTransform() const { return m_Transform; }
-		Transform& GetTransform() { return m_Transform; }
+		// The caller may move the component through the reference, so it is queued for Scene::FlushMovedComponents
+		Transform& GetTransform() { if (!m_TransformChanged) MarkTransformChanged(); return m_Transform; }
+		void MarkTransformChanged();
 
 		[[nodiscard]] const Vector3& GetLocation() const { return m_Transform.GetLocation(); }
 		[[nodiscard]] const Vector3& GetRotation() const { return m_Transform.GetRotation(); }
 		[[nodiscard]] const Vector3& GetScale() const { return m_Transform.GetScale(); }
 
 		[[nodiscard]] Matrix4 GetTransformationMatrix() const;
+
+		// Offset of the rendered location from the simulated one, set by PhysicsWorld to blend between physics steps
+		void SetInterpolationOffset(const Vector3& offset) { m_InterpolationOffset = offset; }
+		[[nodiscard]] const Vector3& GetInterpolationOffset() const { return m_InterpolationOffset; }
+
+		// World matrix with the interpolation offsets applied, use for anything that is only drawn
+		[[nodiscard]] Matrix4 GetRenderTransformationMatrix() const;
 		[[nodiscard]] Vector3 GetWorldPosition() const { return GetTransformationMatrix()[3]; }
 		[[nodiscard]] Vector3 GetForwardVector() const { return GetTransformationMatrix()[2]; }
 		[[nodiscard]] Vector3 GetUpVector() const { return GetTransformationMatrix()[1]; }
@@ -35,6 +48,9 @@ namespace Aurora
 		[[nodiscard]] const std::vector<ActorComponent*>& GetComponents() const { return m_Components; }
 
 		virtual Matrix4 GetSocketTransform(int32_t socketId) const { return glm::identity<Matrix4>(); }
+	private:
+		[[nodiscard]] Matrix4 ComputeTransformationMatrix(bool interpolated) const;
+	public:
 
 		template<typename T>
 		bool GetComponentsOfType(std::vector<T*>& components)
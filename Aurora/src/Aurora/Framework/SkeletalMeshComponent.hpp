@@ -22,6 +22,7 @@ public:
 	[[nodiscard]] bool HasMesh() const override { return m_Mesh != nullptr; }
 
 	void Tick(double delta) override;
+	[[nodiscard]] bool HasAnimation() const override { return true; }
 	void UploadAnimation(Buffer_ptr& buffer) override;
 
 	void Play(int32_t animationIndex, bool loop)
@@ -15,6 +15,7 @@
 #include "BlendState.hpp"
 #include "RasterState.hpp"
 #include "FDepthStencilState.hpp"
+#include "PipelineState.hpp"
 
 #include "../ViewPort.hpp"
 #include "Aurora/Core/TypeID.hpp"
@@ -301,14 +302,51 @@ namespace Aurora
 		}
 	};
 
+	// Resources bound by hashed shader name. A draw only binds a handful, so a linear search beats hashing strings into a map.
+	template<typename T>
+	class ResourceBindings
+	{
+	private:
+		std::vector<std::pair<StrHashID, T>> m_Bindings;
+	public:
+		void Set(StrHashID nameID, const T& value)
+		{
+			for (auto& binding : m_Bindings)
+			{
+				if (binding.first == nameID)
+				{
+					binding.second = value;
+					return;
+				}
+			}
+
+			m_Bindings.emplace_back(nameID, value);
+		}
+
+		[[nodiscard]] const T* Find(StrHashID nameID) const
+		{
+			for (const auto& binding : m_Bindings)
+			{
+				if (binding.first == nameID)
+					return &binding.second;
+			}
+
+			return nullptr;
+		}
+
+		// Keeps the capacity, states are reused every frame
+		void clear() { m_Bindings.clear(); }
+		[[nodiscard]] size_t size() const { return m_Bindings.size(); }
+	};
+
 	struct StateResources
 	{
 		static constexpr uint8_t MaxBoundTextures = 8;
 
-		robin_hood::unordered_map<std::string, TextureBinding> BoundTextures{};
-		robin_hood::unordered_map<std::string, Sampler_ptr> BoundSamplers{};
-		robin_hood::unordered_map<std::string, BufferBinding> BoundUniformBuffers{};
-		robin_hood::unordered_map<std::string, BufferBinding> SSBOBuffers{};
+		ResourceBindings<TextureBinding> BoundTextures{};
+		ResourceBindings<Sampler_ptr> BoundSamplers{};
+		ResourceBindings<BufferBinding> BoundUniformBuffers{};
+		ResourceBindings<BufferBinding> SSBOBuffers{};
 
 		UniformResources Uniforms;
 
@@ -322,24 +360,46 @@ namespace Aurora
 			Uniforms.ResetResources();
 		}
 
-		inline void BindTexture(const std::string& name, const Texture_ptr& texture, bool isUAV = false, TextureBinding::EAccess access = TextureBinding::EAccess::Write, int mipLevel = 0)
+		// Names can be hashed up front with _HASH, the string overloads hash on every call
+
+		inline void BindTexture(StrHashID nameID, const Texture_ptr& texture, bool isUAV = false, TextureBinding::EAccess access = TextureBinding::EAccess::Write, int mipLevel = 0)
+		{
+			BoundTextures.Set(nameID, TextureBinding(texture, isUAV, access, mipLevel));
+		}
+
+		inline void BindTexture(std::string_view name, const Texture_ptr& texture, bool isUAV = false, TextureBinding::EAccess access = TextureBinding::EAccess::Write, int mipLevel = 0)
+		{
+			BindTexture(HashDjb2(name), texture, isUAV, access, mipLevel);
+		}
+
+		inline void BindSampler(StrHashID nameID, const Sampler_ptr& sampler)
+		{
+			BoundSamplers.Set(nameID, sampler);
+		}
+
+		inline void BindSampler(std::string_view name, const Sampler_ptr& sampler)
+		{
+			BindSampler(HashDjb2(name), sampler);
+		}
+
+		inline void BindUniformBuffer(StrHashID nameID, const Buffer_ptr& uniformBuffer, uint32_t offset = 0, uint32_t size = 0)
 		{
-			BoundTextures[name] = TextureBinding(texture, isUAV, access, mipLevel);
+			BoundUniformBuffers.Set(nameID, {uniformBuffer, offset, size});
 		}
 
-		inline void BindSampler(const std::string& name, const Sampler_ptr& sampler)
+		inline void BindUniformBuffer(std::string_view name, const Buffer_ptr& uniformBuffer, uint32_t offset = 0, uint32_t size = 0)
 		{
-			BoundSamplers[name] = sampler;
+			BindUniformBuffer(HashDjb2(name), uniformBuffer, offset, size);
 		}
 
-		inline void BindUniformBuffer(const std::string& name, const Buffer_ptr& uniformBuffer, uint32_t offset = 0, uint32_t size = 0)
+		inline void BindSSBOBuffer(StrHashID nameID, const Buffer_ptr& ssbo, uint32_t offset = 0, uint32_t size = 0)
 		{
-			BoundUniformBuffers[name] = {uniformBuffer, offset, size};
+			SSBOBuffers.Set(nameID, {ssbo, offset, size});
 		}
 
-		inline void BindSSBOBuffer(const std::string& name, const Buffer_ptr& ssbo, uint32_t offset = 0, uint32_t size = 0)
+		inline void BindSSBOBuffer(std::string_view name, const Buffer_ptr& ssbo, uint32_t offset = 0, uint32_t size = 0)
 		{
-			SSBOBuffers[name] = {ssbo, offset, size};
+			BindSSBOBuffer(HashDjb2(name), ssbo, offset, size);
 		}
 	};
 
@@ -541,6 +601,10 @@ namespace Aurora
 		// Shaders
 		virtual Shader_ptr CreateShaderProgram(const ShaderProgramDesc& desc) = 0;
 		virtual void SetShader(const Shader_ptr& shader) = 0;
+		// Pipeline states, equal descriptions share one object
+		[[nodiscard]] virtual PipelineState_ptr CreatePipelineState(const PipelineStateDesc& desc) = 0;
+		// Applies only what differs from the current state, the piecemeal setters below invalidate it
+		virtual void SetPipelineState(const PipelineState_ptr& pipelineState) = 0;
 		// Textures
 		virtual Texture_ptr CreateTexture(const TextureDesc& desc, TextureData textureData) = 0;
 		virtual void WriteTexture(const Texture_ptr &texture, uint32_t mipLevel, uint32_t subresource, const void *data) = 0;
@@ -581,7 +645,10 @@ namespace Aurora
 		// Drawing
 		virtual void Draw(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState = true) = 0;
 		virtual void DrawIndexed(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState = true) = 0;
-		virtual void DrawIndirect(const DrawCallState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes) = 0;
+		// Submits drawCount DrawElementsIndirectCommands starting at offsetBytes of indirectParams, the state is expected to be applied
+		virtual void DrawIndirect(const DrawCallState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes, uint32_t drawCount = 1) = 0;
+		// Multi draw batches address their instances by the base instance of every draw, which shaders can only read with draw parameters
+		[[nodiscard]] virtual bool IsMultiDrawIndirectSupported() const = 0;
 
 		virtual void Dispatch(const DispatchState& state, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) = 0;
 		virtual void DispatchIndirect(const DispatchState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes) = 0;
@@ -589,11 +656,15 @@ namespace Aurora
 		virtual void InvalidateState() = 0;
 
 		virtual void Blit(const Texture_ptr &src, const Texture_ptr &dest) = 0;
+		// Copies mip 0 of one array layer, both textures need the same size and format
+		virtual void CopyTextureLayer(const Texture_ptr& src, uint32_t srcLayer, const Texture_ptr& dest, uint32_t destLayer) = 0;
 
 		virtual void SetViewPort(const FViewPort& wp) = 0;
 		[[nodiscard]] virtual const FViewPort& GetCurrentViewPort() const = 0;
 
 		virtual void BindShaderResources(const BaseState& state) = 0;
+		// Binds a range of the buffer to one storage block of the state's shader, its other resources are left as they are
+		virtual void BindStorageBlockRange(const BaseState& state, StrHashID nameID, const Buffer_ptr& buffer, uint32_t offset, uint32_t size) = 0;
 		virtual void ApplyShaderUniformResources(const Shader_ptr& shader, const UniformResources& resources) = 0;
 		virtual void ApplyDispatchState(const DispatchState& state) = 0;
 		virtual void ApplyDrawCallState(const DrawCallState& state) = 0;
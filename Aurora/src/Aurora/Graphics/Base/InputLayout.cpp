@@ -1,6 +1,27 @@
 #include "InputLayout.hpp"
 
+#include "Aurora/Core/Hash.hpp"
+
 namespace Aurora
 {
 	IInputLayout::~IInputLayout() {}
+
+	uint64_t HashVertexLayout(const VertexLayout& layout)
+	{
+		uint64_t hash = layout.size();
+
+		for (const VertexAttributeDesc& desc : layout)
+		{
+			HashCombine(hash, HashDjb2(desc.Name));
+			HashCombine(hash, desc.Format);
+			HashCombine(hash, desc.BufferIndex);
+			HashCombine(hash, desc.Offset);
+			HashCombine(hash, desc.SemanticIndex);
+			HashCombine(hash, desc.Stride);
+			HashCombine(hash, desc.IsInstanced);
+			HashCombine(hash, desc.Normalized);
+		}
+
+		return hash;
+	}
 }
\ No newline at end of file
@@ -43,14 +43,19 @@ namespace Aurora
 		virtual bool GetDescriptor(int index, VertexAttributeDesc& out_desc) const noexcept = 0;
 		virtual bool GetDescriptorByName(const std::string& name, VertexAttributeDesc& out_desc) const noexcept = 0;
 		virtual bool GetDescriptorBySemanticID(uint32_t semantic, VertexAttributeDesc& out_desc) const noexcept = 0;
+		// Equal layouts have equal hashes, so devices can share objects built from them
+		virtual uint64_t GetHash() const noexcept = 0;
 	};
 
+	AU_API uint64_t HashVertexLayout(const VertexLayout& layout);
+
 	class AU_API BasicInputLayout : public IInputLayout
 	{
 	private:
 		VertexLayout m_Descriptors;
+		uint64_t m_Hash;
 	public:
-		inline explicit BasicInputLayout(VertexLayout descriptors) : m_Descriptors(std::move(descriptors))
+		inline explicit BasicInputLayout(VertexLayout descriptors) : m_Descriptors(std::move(descriptors)), m_Hash(HashVertexLayout(m_Descriptors))
 		{
 		}
 		~BasicInputLayout() override = default;
@@ -89,6 +94,8 @@ namespace Aurora
 
 			return false;
 		}
+
+		inline uint64_t GetHash() const noexcept override { return m_Hash; }
 	};
 
 	typedef std::shared_ptr<IInputLayout> InputLayout_ptr;
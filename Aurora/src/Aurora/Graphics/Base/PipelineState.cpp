@@ -0,0 +1,48 @@
+#include "PipelineState.hpp"
+
+#include <tuple>
+
+#include "Aurora/Core/Hash.hpp"
+
+namespace Aurora
+{
+	static auto Tie(const FRasterState& state)
+	{
+		return std::tie(state.FillMode, state.CullMode, state.FrontCounterClockwise, state.DepthClipEnable, state.ScissorEnable, state.MultisampleEnable,
+						state.DepthBias, state.DepthBiasClamp, state.SlopeScaledDepthBias, state.LineWidth);
+	}
+
+	static auto Tie(const FBlendState& state)
+	{
+		return std::tie(state.Enabled, state.SrcBlend, state.DestBlend, state.BlendOp, state.SrcBlendAlpha, state.DestBlendAlpha, state.BlendOpAlpha,
+						state.ColorWriteEnable, state.BlendFactor.rgba, state.AlphaToCoverage);
+	}
+
+	static auto Tie(const FDepthStencilState::StencilOpDesc& desc)
+	{
+		return std::tie(desc.StencilFailOp, desc.StencilDepthFailOp, desc.StencilPassOp, desc.StencilFunc);
+	}
+
+	static auto Tie(const FDepthStencilState& state)
+	{
+		return std::tuple_cat(std::tie(state.DepthEnable, state.DepthWriteMask, state.DepthFunc, state.StencilEnable, state.StencilReadMask, state.StencilWriteMask, state.StencilRefValue),
+							  Tie(state.FrontFace), Tie(state.BackFace));
+	}
+
+	static auto Tie(const PipelineStateDesc& desc)
+	{
+		return std::tuple_cat(std::tie(desc.Shader), Tie(desc.RasterState), Tie(desc.BlendState), Tie(desc.DepthStencilState));
+	}
+
+	uint64_t PipelineStateDesc::Hash() const
+	{
+		uint64_t hash = 0;
+		std::apply([&hash](const auto&... fields) { (HashCombine(hash, fields), ...); }, Tie(*this));
+		return hash;
+	}
+
+	bool PipelineStateDesc::operator==(const PipelineStateDesc& other) const
+	{
+		return Tie(*this) == Tie(other);
+	}
+}
\ No newline at end of file
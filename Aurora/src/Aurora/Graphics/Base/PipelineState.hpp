@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+
+#include "Aurora/Core/Library.hpp"
+#include "ShaderBase.hpp"
+#include "RasterState.hpp"
+#include "BlendState.hpp"
+#include "FDepthStencilState.hpp"
+
+namespace Aurora
+{
+	struct PipelineStateDesc
+	{
+		Shader_ptr Shader;
+		FRasterState RasterState;
+		FBlendState BlendState;
+		FDepthStencilState DepthStencilState;
+
+		PipelineStateDesc() : Shader(nullptr), RasterState(), BlendState(), DepthStencilState() {}
+
+		// Fields are hashed one by one, the padding of the state structs is never initialized
+		[[nodiscard]] AU_API uint64_t Hash() const;
+		[[nodiscard]] AU_API bool operator==(const PipelineStateDesc& other) const;
+	};
+
+	// Immutable shader and fixed function state, created through IRenderDevice::CreatePipelineState.
+	// Equal descriptions get the same ID, so devices compare IDs to skip applying a state that is already set.
+	class PipelineState
+	{
+	private:
+		PipelineStateDesc m_Desc;
+		uint32_t m_ID;
+	public:
+		PipelineState(PipelineStateDesc desc, uint32_t id) : m_Desc(std::move(desc)), m_ID(id) {}
+
+		[[nodiscard]] const PipelineStateDesc& GetDesc() const { return m_Desc; }
+		[[nodiscard]] uint32_t GetID() const { return m_ID; }
+	};
+
+	typedef std::shared_ptr<PipelineState> PipelineState_ptr;
+}
\ No newline at end of file
@@ -1,111 +1,96 @@
 #include "BufferCache.hpp"
+
+#include <algorithm>
+
 #include "Base/IRenderDevice.hpp"
+#include "OpenGL/GLBufferLock.hpp"
 #include "Aurora/Core/String.hpp"
+#include "Aurora/Core/Profiler.hpp"
 
 namespace Aurora
 {
 
-	BufferCache::BufferCache(IRenderDevice* renderDevice, EBufferType bufferType, uint numberOfBuffers, uint singleBufferSize, bool useGpuMapping)
+	BufferCache::BufferCache(IRenderDevice* renderDevice, EBufferType bufferType, uint size)
 			: m_RenderDevice(renderDevice),
-			m_NumBuffers(numberOfBuffers),
-			m_Buffers(numberOfBuffers),
-			m_SingleBufferSize(singleBufferSize),
-			m_CurrentOffset(0),
-			m_CurrentBuffer(0),
-			m_NumBytesPerFrame(0),
-			m_UseGpuMapping(useGpuMapping)
+			m_BufferType(bufferType),
+			m_Data(nullptr),
+			m_Size(0),
+			m_Alignment(1),
+			m_Head(0),
+			m_LockStart(0),
+			m_NumBytesPerFrame(0)
 	{
-		for (int i = 0; i < numberOfBuffers; ++i)
+		GLint alignment = 0;
+
+		if(bufferType == EBufferType::UniformBuffer)
 		{
-			m_Buffers[i] = renderDevice->CreateBuffer(BufferDesc("BufferCache #" + std::to_string(i), singleBufferSize, bufferType));
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
 		}
-
-		if(!m_UseGpuMapping)
+		else if(bufferType == EBufferType::ShaderStorageBuffer)
 		{
-			m_LocalMappedMemory = new uint8_t[numberOfBuffers * singleBufferSize];
+			glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
 		}
+
+		m_Alignment = std::max<uint>(alignment, 1);
+
+		CreateBuffer(size);
 	}
 
-	BufferCache::~BufferCache()
+	BufferCache::~BufferCache() = default;
+
+	void BufferCache::CreateBuffer(uint size)
 	{
-		delete[] m_LocalMappedMemory;
+		// Ranges handed out before keep the old buffer alive, GL deletes it once the GPU is done with it
+		m_LockManager = std::make_unique<BufferLockManager>(true);
+		m_Buffer = m_RenderDevice->CreateBuffer(BufferDesc("BufferCache", size, m_BufferType, EBufferUsage::DynamicDraw, true));
+		m_Data = m_RenderDevice->MapBuffer(m_Buffer, EBufferAccess::WriteOnly);
+		m_Size = size;
+		m_Head = 0;
+		m_LockStart = 0;
 	}
 
 	uint8* BufferCache::GetOrMap(uint size, VBufferCacheIndex &bufferCacheIndex)
 	{
-		if(size > m_SingleBufferSize)
+		CPU_DEBUG_SCOPE("BufferCache::GetOrMap");
+
+		uint alignedSize = (size + m_Alignment - 1) / m_Alignment * m_Alignment;
+
+		if(alignedSize > m_Size)
 		{
-			AU_LOG_WARNING("Cannot write ", FormatBytes(size), " to cache with max size ", FormatBytes(m_SingleBufferSize), " !");
-			return nullptr;
+			AU_LOG_WARNING("BufferCache of ", FormatBytes(m_Size), " is too small for ", FormatBytes(size), ", growing it");
+			CreateBuffer(std::max(alignedSize, m_Size * 2));
 		}
-
-		uint freeSpace = m_SingleBufferSize - m_CurrentOffset;
-
-		if(size <= freeSpace && m_CurrentBuffer < m_NumBuffers)
-		{ // Free space, get memory and advance
-			bufferCacheIndex.Offset = m_CurrentOffset;
-			bufferCacheIndex.BufferIndex = m_CurrentBuffer;
-			bufferCacheIndex.Size = size;
-			bufferCacheIndex.Buffer = m_Buffers[bufferCacheIndex.BufferIndex];
-
-			m_CurrentOffset += std::max(size, 256u);
-
-			if(freeSpace == size)
-			{ // If we fill whole buffer we advance to another
-				m_CurrentOffset = 0;
-				m_CurrentBuffer += 1;
-			}
-
-			m_NumBytesPerFrame += size;
-
-			size_t offset = bufferCacheIndex.BufferIndex * m_SingleBufferSize + bufferCacheIndex.Offset;
-			if(m_UseGpuMapping)
-			{
-				return reinterpret_cast<uint8_t*>(m_RenderDevice->MapBuffer(bufferCacheIndex.Buffer, EBufferAccess::WriteOnly)) + offset;
-			}
-			else
-			{
-				return &m_LocalMappedMemory[offset];
-			}
+		else if(m_Head + alignedSize > m_Size)
+		{ // Wrap around, the ranges written so far have to be fenced before they can be waited on
+			Lock();
+			m_Head = 0;
+			m_LockStart = 0;
 		}
-		else if(m_CurrentBuffer < m_NumBuffers - 1)
-		{ // No free space, need to cache remaining and advance buffer
-			AU_LOG_WARNING(FormatBytes(freeSpace), " bytes was skipped at the end of BufferCache !");
-			m_CurrentOffset = std::max(size, 256u);
-			m_CurrentBuffer += 1;
 
-			bufferCacheIndex.Offset = m_CurrentOffset;
-			bufferCacheIndex.BufferIndex = m_CurrentBuffer;
-			bufferCacheIndex.Size = size;
-			bufferCacheIndex.Buffer = m_Buffers[bufferCacheIndex.BufferIndex];
+		m_LockManager->WaitForLockedRange(m_Head, alignedSize);
 
-			m_NumBytesPerFrame += size;
+		bufferCacheIndex.Offset = m_Head;
+		bufferCacheIndex.Size = size;
+		bufferCacheIndex.Buffer = m_Buffer;
 
-			return m_RenderDevice->MapBuffer(bufferCacheIndex.Buffer, EBufferAccess::WriteOnly);
-		}
-		else
-		{ // We are at the end of max memory, throw an error
-			AU_LOG_WARNING("BufferCache memory at maximum ", FormatBytes(m_NumBuffers * m_SingleBufferSize), " !");
-		}
+		m_Head += alignedSize;
+		m_NumBytesPerFrame += size;
 
-		return nullptr;
+		return m_Data + bufferCacheIndex.Offset;
 	}
 
-	void BufferCache::Unmap(VBufferCacheIndex &bufferCacheIndex)
+	void BufferCache::Lock()
 	{
-		if(bufferCacheIndex.Buffer == nullptr)
+		if(m_Head > m_LockStart)
 		{
-			return;
+			m_LockManager->LockRange(m_LockStart, m_Head - m_LockStart);
+			m_LockStart = m_Head;
 		}
+	}
 
-		if(m_UseGpuMapping)
-		{
-			m_RenderDevice->UnmapBuffer(bufferCacheIndex.Buffer);
-		}
-		else
-		{
-			size_t offset = bufferCacheIndex.BufferIndex * m_SingleBufferSize + bufferCacheIndex.Offset;
-			m_RenderDevice->WriteBuffer(bufferCacheIndex.Buffer, &m_LocalMappedMemory[offset], bufferCacheIndex.Size, offset);
-		}
+	void BufferCache::OnFrameEnd()
+	{
+		Lock();
+		m_NumBytesPerFrame = 0;
 	}
 }
\ No newline at end of file
@@ -1,37 +1,44 @@
 #pragma once
 
+#include <memory>
+
 #include "Aurora/Core/Types.hpp"
 #include "Aurora/Graphics/Base/Buffer.hpp"
 
 namespace Aurora
 {
 	class IRenderDevice;
+	class BufferLockManager;
 
 	struct VBufferCacheIndex
 	{
 		uint Offset;
 		uint Size;
-		uint BufferIndex;
 		Buffer_ptr Buffer;
 
-		VBufferCacheIndex() : Offset(0), Size(0), BufferIndex(0), Buffer(nullptr)
+		VBufferCacheIndex() : Offset(0), Size(0), Buffer(nullptr)
 		{}
 	};
 
+	// Persistently mapped buffer written as a ring, data written through GetOrMap is visible to the GPU without a flush.
+	// Everything written during a frame is fenced in OnFrameEnd, the ring only blocks when it wraps onto a frame the GPU still reads.
 	class AU_API BufferCache
 	{
 	private:
 		IRenderDevice* m_RenderDevice;
-		std::vector<Buffer_ptr> m_Buffers;
-		uint m_NumBuffers;
-		uint m_SingleBufferSize;
-		uint m_CurrentOffset;
-		uint m_CurrentBuffer;
+		EBufferType m_BufferType;
+		Buffer_ptr m_Buffer;
+		uint8_t* m_Data;
+		std::unique_ptr<BufferLockManager> m_LockManager;
+
+		uint m_Size;
+		uint m_Alignment;
+		uint m_Head;
+		// Start of the ranges written since the last fence
+		uint m_LockStart;
 		uint m_NumBytesPerFrame;
-		bool m_UseGpuMapping;
-		uint8_t* m_LocalMappedMemory;
 	public:
-		BufferCache(IRenderDevice* renderDevice, EBufferType bufferType, uint numberOfBuffers, uint singleBufferSize, bool useGpuMapping);
+		BufferCache(IRenderDevice* renderDevice, EBufferType bufferType, uint size);
 		~BufferCache();
 
 		uint8* GetOrMap(uint size, VBufferCacheIndex& bufferCacheIndex);
@@ -42,22 +49,21 @@ namespace Aurora
 			return reinterpret_cast<T*>(GetOrMap(size, bufferCacheIndex));
 		}
 
-		void Unmap(VBufferCacheIndex& bufferCacheIndex);
-
-		void Reset()
+		// The mapping is coherent, there is nothing to upload
+		void Unmap(VBufferCacheIndex& bufferCacheIndex)
 		{
-			m_CurrentOffset = 0;
-			m_CurrentBuffer = 0;
+			(void)bufferCacheIndex;
 		}
 
-		void OnFrameEnd()
-		{
-			m_NumBytesPerFrame = 0;
-		}
+		// Fences the ranges written this frame, must be called once all draws reading them are submitted
+		void OnFrameEnd();
 
 		uint GetNumBytesPerFrame()
 		{
 			return m_NumBytesPerFrame;
 		}
+	private:
+		void Lock();
+		void CreateBuffer(uint size);
 	};
 }
\ No newline at end of file
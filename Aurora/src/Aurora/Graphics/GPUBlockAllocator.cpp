@@ -1,25 +1,271 @@
 #include "GPUBlockAllocator.hpp"
 
+#include <bit>
+#include <algorithm>
+
+#include "Aurora/Core/assert.hpp"
+
 namespace Aurora
 {
+	GPUBlockAllocator::GPUBlockAllocator(uint32_t capacity) : m_Capacity(capacity), m_FreeSize(0), m_FirstLevelMask(0), m_SecondLevelMasks()
+	{
+		for (NodeIndex& head : m_BinHeads)
+		{
+			head = InvalidNode;
+		}
+
+		if (capacity > 0)
+		{
+			InsertFreeNode(CreateNode(0, capacity));
+			m_FreeSize = capacity;
+		}
+	}
+
+	GPUBlockAllocator::~GPUBlockAllocator() = default;
+
+	uint32_t GPUBlockAllocator::GetBin(uint32_t size)
+	{
+		if (size < SecondLevelCount)
+		{
+			return size;
+		}
+
+		uint32_t topBit = 31 - std::countl_zero(size);
+		uint32_t firstLevel = topBit - SecondLevelBits + 1;
+		uint32_t secondLevel = (size >> (topBit - SecondLevelBits)) - SecondLevelCount;
+		return firstLevel * SecondLevelCount + secondLevel;
+	}
+
+	bool GPUBlockAllocator::GetSearchBin(uint32_t size, uint32_t& firstLevel, uint32_t& secondLevel)
+	{
+		uint64_t rounded = size;
+
+		if (size >= SecondLevelCount)
+		{
+			uint32_t topBit = 31 - std::countl_zero(size);
+			rounded += (uint64_t(1) << (topBit - SecondLevelBits)) - 1;
+
+			if (rounded > UINT32_MAX)
+				return false;
+		}
+
+		uint32_t bin = GetBin(static_cast<uint32_t>(rounded));
+		firstLevel = bin / SecondLevelCount;
+		secondLevel = bin % SecondLevelCount;
+		return true;
+	}
+
+	GPUBlockAllocator::NodeIndex GPUBlockAllocator::FindFreeNode(uint32_t firstLevel, uint32_t secondLevel) const
+	{
+		uint32_t secondLevelMask = m_SecondLevelMasks[firstLevel] & (~0u << secondLevel);
+
+		if (secondLevelMask == 0)
+		{
+			// Nothing large enough in this power of two, take the smallest bin of a larger one
+			uint32_t firstLevelMask = firstLevel + 1 < FirstLevelCount ? m_FirstLevelMask & (~0u << (firstLevel + 1)) : 0;
+
+			if (firstLevelMask == 0)
+				return InvalidNode;
+
+			firstLevel = std::countr_zero(firstLevelMask);
+			secondLevelMask = m_SecondLevelMasks[firstLevel];
+		}
+
+		secondLevel = std::countr_zero(secondLevelMask);
+		return m_BinHeads[firstLevel * SecondLevelCount + secondLevel];
+	}
+
+	void GPUBlockAllocator::InsertFreeNode(NodeIndex index)
+	{
+		Node& node = m_Nodes[index];
+		uint32_t bin = GetBin(node.Size);
+
+		node.PrevFree = InvalidNode;
+		node.NextFree = m_BinHeads[bin];
+
+		if (node.NextFree != InvalidNode)
+		{
+			m_Nodes[node.NextFree].PrevFree = index;
+		}
+
+		m_BinHeads[bin] = index;
+		m_FirstLevelMask |= 1u << (bin / SecondLevelCount);
+		m_SecondLevelMasks[bin / SecondLevelCount] |= 1u << (bin % SecondLevelCount);
+	}
+
+	void GPUBlockAllocator::RemoveFreeNode(NodeIndex index)
+	{
+		Node& node = m_Nodes[index];
+		uint32_t bin = GetBin(node.Size);
+
+		if (node.PrevFree != InvalidNode)
+		{
+			m_Nodes[node.PrevFree].NextFree = node.NextFree;
+		}
+		else
+		{
+			m_BinHeads[bin] = node.NextFree;
+		}
+
+		if (node.NextFree != InvalidNode)
+		{
+			m_Nodes[node.NextFree].PrevFree = node.PrevFree;
+		}
 
-	GPUBlockAllocator::GPUBlockAllocator()
+		node.PrevFree = InvalidNode;
+		node.NextFree = InvalidNode;
+
+		if (m_BinHeads[bin] == InvalidNode)
+		{
+			uint32_t firstLevel = bin / SecondLevelCount;
+			m_SecondLevelMasks[firstLevel] &= ~(1u << (bin % SecondLevelCount));
+
+			if (m_SecondLevelMasks[firstLevel] == 0)
+			{
+				m_FirstLevelMask &= ~(1u << firstLevel);
+			}
+		}
+	}
+
+	GPUBlockAllocator::NodeIndex GPUBlockAllocator::CreateNode(GPUMemoryLocation offset, uint32_t size)
 	{
+		NodeIndex index;
+
+		if (!m_UnusedNodes.empty())
+		{
+			index = m_UnusedNodes.back();
+			m_UnusedNodes.pop_back();
+		}
+		else
+		{
+			index = static_cast<NodeIndex>(m_Nodes.size());
+			m_Nodes.emplace_back();
+		}
 
+		m_Nodes[index] = {offset, size, InvalidNode, InvalidNode, InvalidNode, InvalidNode, false};
+		return index;
 	}
 
-	GPUBlockAllocator::~GPUBlockAllocator()
+	void GPUBlockAllocator::ReleaseNode(NodeIndex index)
 	{
+		m_UnusedNodes.push_back(index);
+	}
+
+	GPUBlockAllocator::Allocation GPUBlockAllocator::Alloc(uint32_t size)
+	{
+		if (size == 0)
+			return {};
+
+		uint32_t firstLevel, secondLevel;
+		if (!GetSearchBin(size, firstLevel, secondLevel))
+			return {};
+
+		NodeIndex index = FindFreeNode(firstLevel, secondLevel);
+
+		if (index == InvalidNode)
+		{
+			// The rounded search skips the bin of size itself, one of its blocks may still be large enough
+			for (index = m_BinHeads[GetBin(size)]; index != InvalidNode; index = m_Nodes[index].NextFree)
+			{
+				if (m_Nodes[index].Size >= size)
+					break;
+			}
+
+			if (index == InvalidNode)
+				return {};
+		}
+
+		RemoveFreeNode(index);
+
+		if (m_Nodes[index].Size > size)
+		{
+			// Return the tail to the free bins
+			NodeIndex remainder = CreateNode(m_Nodes[index].Offset + size, m_Nodes[index].Size - size);
+			Node& node = m_Nodes[index];
+
+			m_Nodes[remainder].PrevPhysical = index;
+			m_Nodes[remainder].NextPhysical = node.NextPhysical;
+
+			if (node.NextPhysical != InvalidNode)
+			{
+				m_Nodes[node.NextPhysical].PrevPhysical = remainder;
+			}
+
+			node.NextPhysical = remainder;
+			node.Size = size;
 
+			InsertFreeNode(remainder);
+		}
+
+		Node& node = m_Nodes[index];
+		node.Used = true;
+		m_FreeSize -= size;
+
+		return {node.Offset, size, index};
 	}
 
-	uint8_t* GPUBlockAllocator::Alloc(size_t size)
+	void GPUBlockAllocator::Free(const Allocation& allocation)
 	{
-		return nullptr;
+		if (!allocation.IsValid())
+			return;
+
+		NodeIndex index = allocation.Node;
+		au_assert(m_Nodes[index].Used && m_Nodes[index].Offset == allocation.Offset);
+
+		m_Nodes[index].Used = false;
+		m_FreeSize += m_Nodes[index].Size;
+
+		// Merge with the free neighbours so the buffer does not fragment into small blocks
+		NodeIndex prev = m_Nodes[index].PrevPhysical;
+		if (prev != InvalidNode && !m_Nodes[prev].Used)
+		{
+			RemoveFreeNode(prev);
+
+			m_Nodes[prev].Size += m_Nodes[index].Size;
+			m_Nodes[prev].NextPhysical = m_Nodes[index].NextPhysical;
+
+			if (m_Nodes[index].NextPhysical != InvalidNode)
+			{
+				m_Nodes[m_Nodes[index].NextPhysical].PrevPhysical = prev;
+			}
+
+			ReleaseNode(index);
+			index = prev;
+		}
+
+		NodeIndex next = m_Nodes[index].NextPhysical;
+		if (next != InvalidNode && !m_Nodes[next].Used)
+		{
+			RemoveFreeNode(next);
+
+			m_Nodes[index].Size += m_Nodes[next].Size;
+			m_Nodes[index].NextPhysical = m_Nodes[next].NextPhysical;
+
+			if (m_Nodes[next].NextPhysical != InvalidNode)
+			{
+				m_Nodes[m_Nodes[next].NextPhysical].PrevPhysical = index;
+			}
+
+			ReleaseNode(next);
+		}
+
+		InsertFreeNode(index);
 	}
 
-	bool GPUBlockAllocator::Delete(uint8_t* memory)
+	uint32_t GPUBlockAllocator::GetLargestFreeBlock() const
 	{
-		return false;
+		if (m_FirstLevelMask == 0)
+			return 0;
+
+		uint32_t firstLevel = 31 - std::countl_zero(m_FirstLevelMask);
+		uint32_t secondLevel = 31 - std::countl_zero(m_SecondLevelMasks[firstLevel]);
+
+		uint32_t largest = 0;
+		for (NodeIndex index = m_BinHeads[firstLevel * SecondLevelCount + secondLevel]; index != InvalidNode; index = m_Nodes[index].NextFree)
+		{
+			largest = std::max(largest, m_Nodes[index].Size);
+		}
+
+		return largest;
 	}
-}
\ No newline at end of file
+}
@@ -1,33 +1,83 @@
 #pragma once
 
+#include <vector>
+
 #include "Aurora/Core/Types.hpp"
 #include "Aurora/Core/Library.hpp"
 
 namespace Aurora
 {
-	typedef size_t GPUMemoryLocation;
+	typedef uint32_t GPUMemoryLocation;
 
+	// Two level segregated fit (TLSF) allocator of offsets into a GPU buffer, it never touches the memory it manages.
+	// Free blocks are binned by size, every power of two split into SecondLevelCount bins, so both Alloc and Free are O(1).
+	// Offsets and sizes are in caller defined units, a buffer of vertices can be managed in vertices.
 	class AU_API GPUBlockAllocator
 	{
+	public:
+		typedef uint32_t NodeIndex;
+		static constexpr NodeIndex InvalidNode = ~0u;
+
+		struct Allocation
+		{
+			GPUMemoryLocation Offset = 0;
+			uint32_t Size = 0;
+			NodeIndex Node = InvalidNode;
+
+			[[nodiscard]] bool IsValid() const { return Node != InvalidNode; }
+		};
 	private:
+		static constexpr uint32_t SecondLevelBits = 3;
+		static constexpr uint32_t SecondLevelCount = 1u << SecondLevelBits;
+		static constexpr uint32_t FirstLevelCount = 32;
+		static constexpr uint32_t BinCount = FirstLevelCount * SecondLevelCount;
+
+		struct Node
+		{
+			GPUMemoryLocation Offset;
+			uint32_t Size;
+			// Free list of the bin, only linked while the block is free
+			NodeIndex PrevFree;
+			NodeIndex NextFree;
+			// Neighbouring blocks in the buffer, merged on free
+			NodeIndex PrevPhysical;
+			NodeIndex NextPhysical;
+			bool Used;
+		};
 
+		uint32_t m_Capacity;
+		uint32_t m_FreeSize;
+
+		uint32_t m_FirstLevelMask;
+		uint32_t m_SecondLevelMasks[FirstLevelCount];
+		NodeIndex m_BinHeads[BinCount];
+
+		std::vector<Node> m_Nodes;
+		std::vector<NodeIndex> m_UnusedNodes;
 	public:
-		GPUBlockAllocator();
+		explicit GPUBlockAllocator(uint32_t capacity);
 		~GPUBlockAllocator();
 
-		uint8_t* Alloc(size_t size);
-		bool Delete(uint8_t* memory);
+		// Returns an invalid allocation when no free block can hold size.
+		// Blocks are taken from the first bin that is guaranteed to fit, the bin of size itself is only searched when that fails.
+		[[nodiscard]] Allocation Alloc(uint32_t size);
+		void Free(const Allocation& allocation);
 
-		template<typename T>
-		T* AllocType()
-		{
-			return reinterpret_cast<T*>(Alloc(sizeof(T)));
-		}
+		[[nodiscard]] uint32_t GetCapacity() const { return m_Capacity; }
+		[[nodiscard]] uint32_t GetFreeSize() const { return m_FreeSize; }
+		[[nodiscard]] uint32_t GetLargestFreeBlock() const;
+		[[nodiscard]] bool IsEmpty() const { return m_FreeSize == m_Capacity; }
+	private:
+		// Bin a free block of size is stored in
+		static uint32_t GetBin(uint32_t size);
+		// First bin whose blocks are all at least size, the size is rounded up to the next bin boundary
+		static bool GetSearchBin(uint32_t size, uint32_t& firstLevel, uint32_t& secondLevel);
 
-		template<typename T>
-		T* AllocTypeArray(size_t count)
-		{
-			return reinterpret_cast<T*>(Alloc(count * sizeof(T)));
-		}
+		NodeIndex FindFreeNode(uint32_t firstLevel, uint32_t secondLevel) const;
+		void InsertFreeNode(NodeIndex index);
+		void RemoveFreeNode(NodeIndex index);
+
+		NodeIndex CreateNode(GPUMemoryLocation offset, uint32_t size);
+		void ReleaseNode(NodeIndex index);
 	};
 }
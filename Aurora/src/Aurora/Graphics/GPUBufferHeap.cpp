@@ -0,0 +1,62 @@
+#include "GPUBufferHeap.hpp"
+
+#include <algorithm>
+
+#include "Aurora/Core/Profiler.hpp"
+#include "Aurora/Logger/Logger.hpp"
+#include "Base/IRenderDevice.hpp"
+
+namespace Aurora
+{
+	GPUBufferHeap::GPUBufferHeap(IRenderDevice* renderDevice, String name, EBufferType type, uint32_t elementSize, uint32_t pageByteSize)
+		: m_RenderDevice(renderDevice), m_Name(std::move(name)), m_Type(type), m_ElementSize(elementSize), m_PageElements(std::max<uint32_t>(pageByteSize / elementSize, 1))
+	{
+	}
+
+	std::shared_ptr<GPUBufferHeap::Page> GPUBufferHeap::CreatePage(uint32_t elementCount)
+	{
+		auto page = std::make_shared<Page>(elementCount);
+		page->Buffer = m_RenderDevice->CreateBuffer(BufferDesc(m_Name, elementCount * m_ElementSize, m_Type, EBufferUsage::StaticDraw));
+
+		AU_LOG_INFO("Created ", m_Name, " heap page of ", FormatBytes(uint64_t(elementCount) * m_ElementSize));
+
+		m_Pages.push_back(page);
+		return page;
+	}
+
+	GPUBufferRange_ptr GPUBufferHeap::Allocate(uint32_t count)
+	{
+		CPU_DEBUG_SCOPE("GPUBufferHeap::Allocate");
+
+		std::shared_ptr<Page> page;
+		GPUBlockAllocator::Allocation allocation;
+
+		for (const std::shared_ptr<Page>& existingPage : m_Pages)
+		{
+			allocation = existingPage->Allocator.Alloc(count);
+
+			if (allocation.IsValid())
+			{
+				page = existingPage;
+				break;
+			}
+		}
+
+		if (!allocation.IsValid())
+		{
+			page = CreatePage(std::max(count, m_PageElements));
+			allocation = page->Allocator.Alloc(count);
+		}
+
+		return {new GPUBufferRange{page->Buffer, allocation.Offset, count}, [page, allocation](GPUBufferRange* range)
+		{
+			page->Allocator.Free(allocation);
+			delete range;
+		}};
+	}
+
+	void GPUBufferHeap::Write(const GPUBufferRange_ptr& range, const void* data)
+	{
+		m_RenderDevice->WriteBuffer(range->Buffer, data, range->Count * m_ElementSize, range->Offset * m_ElementSize);
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Aurora/Core/Types.hpp"
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Core/String.hpp"
+#include "Base/Buffer.hpp"
+#include "GPUBlockAllocator.hpp"
+
+namespace Aurora
+{
+	class IRenderDevice;
+
+	// Range of a heap buffer, it goes back to the heap when the last reference is dropped
+	struct GPUBufferRange
+	{
+		Buffer_ptr Buffer;
+		// In elements of the heap, so a vertex range offset is its base vertex
+		GPUMemoryLocation Offset;
+		uint32_t Count;
+	};
+
+	typedef std::shared_ptr<GPUBufferRange> GPUBufferRange_ptr;
+
+	// Sub-allocates elements of one size from a few large buffers, so that many meshes share one buffer binding.
+	// A new page is created when no page has room, ranges larger than a page get a page of their own.
+	class AU_API GPUBufferHeap
+	{
+	private:
+		struct Page
+		{
+			Buffer_ptr Buffer;
+			GPUBlockAllocator Allocator;
+
+			explicit Page(uint32_t elementCount) : Buffer(nullptr), Allocator(elementCount) { }
+		};
+
+		IRenderDevice* m_RenderDevice;
+		String m_Name;
+		EBufferType m_Type;
+		uint32_t m_ElementSize;
+		uint32_t m_PageElements;
+		// Ranges keep their page alive, so freeing a range after the heap is gone is safe
+		std::vector<std::shared_ptr<Page>> m_Pages;
+	public:
+		GPUBufferHeap(IRenderDevice* renderDevice, String name, EBufferType type, uint32_t elementSize, uint32_t pageByteSize);
+
+		[[nodiscard]] GPUBufferRange_ptr Allocate(uint32_t count);
+		// Writes count elements of the range
+		void Write(const GPUBufferRange_ptr& range, const void* data);
+
+		[[nodiscard]] uint32_t GetElementSize() const { return m_ElementSize; }
+		[[nodiscard]] size_t GetPageCount() const { return m_Pages.size(); }
+	private:
+		std::shared_ptr<Page> CreatePage(uint32_t elementCount);
+	};
+}
@@ -1,4 +1,8 @@
 #include "Material.hpp"
+
+#include <atomic>
+#include <algorithm>
+
 #include "Aurora/Engine.hpp"
 #include "Aurora/Core/Profiler.hpp"
 #include "Aurora/Graphics/RenderManager.hpp"
@@ -12,15 +16,15 @@ namespace Aurora
 {
 	uint64_t HashShaderMacros(const ShaderMacros& macros)
 	{
-		std::stringstream ss;
+		uint64_t hash = macros.size();
 
-		for(const auto& it : macros)
+		for(const auto& [name, value] : macros)
 		{
-			ss << it.first;
-			ss << it.second;
+			HashCombine(hash, HashDjb2(name));
+			HashCombine(hash, HashDjb2(value));
 		}
 
-		return std::hash<String>()(ss.str());
+		return hash;
 	}
 
 	std::ostream& operator<<(std::ostream &out, ShaderMacros const& macros)
@@ -33,13 +37,15 @@ namespace Aurora
 		return out;
 	}
 
-	Material::Material(MaterialDefinition *matDef) : m_MatDef(matDef)
+	static std::atomic<uint32_t> s_NextMaterialSortIndex(0);
+
+	Material::Material(MaterialDefinition *matDef) : m_MatDef(matDef), m_SortIndex(s_NextMaterialSortIndex++)
 	{
 
 	}
 
 	Material::Material(MaterialDefinition* matDef, bool instance)
-		:  m_MatDef(matDef), m_UniformData(matDef->m_UniformData), m_Macros(matDef->m_Macros), m_PassStates(matDef->m_PassStates), m_TextureVars(matDef->m_TextureVars)
+		:  m_MatDef(matDef), m_UniformData(matDef->m_UniformData), m_Macros(matDef->m_Macros), m_PassStates(matDef->m_PassStates), m_TextureVars(matDef->m_TextureVars), m_SortIndex(s_NextMaterialSortIndex++)
 	{
 		for(const auto& it : m_MatDef->m_PassDefs)
 		{
@@ -47,18 +53,26 @@ namespace Aurora
 		}
 	}
 
+	uint32_t Material::GetProgramSortIndex() const
+	{
+		return m_MatDef->GetSortIndex();
+	}
+
 	FRasterState& Material::RasterState(PassType_t pass)
 	{
+		m_PassStateVersion++;
 		return m_PassStates[pass].RasterState;
 	}
 
 	FDepthStencilState& Material::DepthStencilState(PassType_t pass)
 	{
+		m_PassStateVersion++;
 		return m_PassStates[pass].DepthStencilState;
 	}
 
 	FBlendState& Material::BlendState(PassType_t pass)
 	{
+		m_PassStateVersion++;
 		return m_PassStates[pass].BlendState;
 	}
 
@@ -87,7 +101,7 @@ namespace Aurora
 			AU_LOG_WARNING("Pass ", (uint32_t)pass, " not found for ", m_MatDef->m_Name);
 		}
 
-		Shader_ptr shader = passDef->GetShader(m_Macros);
+		Shader_ptr shader = passDef->GetShader(GetPermutationKey(), m_Macros);
 
 		if(shader == nullptr)
 		{
@@ -96,53 +110,157 @@ namespace Aurora
 		}
 
 		drawState.Shader = shader;
-		renderDevice->SetShader(shader);
 
-		// Set buffers
+		UploadUniformData();
+
+		const MaterialBindingTable& bindingTable = GetBindingTable(pass, shader);
+		renderDevice->SetPipelineState(bindingTable.PipelineState);
+
+		for(const MaterialBindingTable::BlockEntry& block : bindingTable.UniformBlocks)
+		{
+			drawState.BindUniformBuffer(block.NameID, m_UniformBuffer, block.Offset, block.Size);
+		}
+
+		for(const MaterialBindingTable::TextureEntry& texture : bindingTable.Textures)
+		{
+			drawState.BindTexture(texture.NameID, texture.Texture);
+			drawState.BindSampler(texture.NameID, texture.Sampler);
+		}
+
+		renderDevice->BindShaderResources(drawState);
+
+		const MaterialPassState& passState = m_PassStates[pass];
+		drawState.RasterState = passState.RasterState;
+		drawState.DepthStencilState = passState.DepthStencilState;
+		drawState.BlendState = passState.BlendState;
+	}
+
+	uint64_t Material::GetPermutationKey()
+	{
+		if(m_PermutationKeyDirty)
+		{
+			m_PermutationKey = HashShaderMacros(m_Macros);
+			m_PermutationKeyDirty = false;
+		}
+
+		return m_PermutationKey;
+	}
+
+	void Material::UploadUniformData()
+	{
+		if(!m_UniformDataDirty)
+			return;
+
+		CPU_DEBUG_SCOPE("Material::UploadUniformData");
+
+		m_UniformDataDirty = false;
+
+		static uint32_t uniformAlignment = 0;
+		if(uniformAlignment == 0)
+		{
+			GLint alignment = 0;
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+			uniformAlignment = std::max<uint32_t>(alignment, 1);
+		}
+
+		// Every block starts at an offset it can be bound at
+		const std::vector<MUniformBlock>& blocks = m_MatDef->m_UniformBlocksDef;
+		m_UniformBlockOffsets.resize(blocks.size());
+
+		uint32_t bufferSize = 0;
+		for(size_t i = 0; i < blocks.size(); ++i)
+		{
+			m_UniformBlockOffsets[i] = bufferSize;
+			bufferSize += (blocks[i].Size + uniformAlignment - 1) / uniformAlignment * uniformAlignment;
+		}
+
+		if(bufferSize == 0)
+			return;
+
+		if(m_UniformBuffer == nullptr || m_UniformBuffer->GetDesc().ByteSize != bufferSize)
+		{
+			m_UniformBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("Material " + m_MatDef->GetName(), bufferSize, EBufferType::UniformBuffer));
+			m_BindingVersion++;
+		}
+
+		for(size_t i = 0; i < blocks.size(); ++i)
+		{
+			if(blocks[i].Offset + blocks[i].Size > m_UniformData.size())
+				continue;
+
+			GEngine->GetRenderDevice()->WriteBuffer(m_UniformBuffer, m_UniformData.data() + blocks[i].Offset, blocks[i].Size, m_UniformBlockOffsets[i]);
+		}
+	}
+
+	const MaterialBindingTable& Material::GetBindingTable(PassType_t pass, const Shader_ptr& shader)
+	{
+		MaterialBindingTable& table = m_BindingTables[pass];
+
+		if(table.Shader != shader || table.StateVersion != m_PassStateVersion)
+		{
+			const MaterialPassState& passState = m_PassStates[pass];
+
+			PipelineStateDesc pipelineDesc;
+			pipelineDesc.Shader = shader;
+			pipelineDesc.RasterState = passState.RasterState;
+			pipelineDesc.DepthStencilState = passState.DepthStencilState;
+			pipelineDesc.BlendState = passState.BlendState;
+
+			// The accessors bump the version on every call, most of the time nothing changed
+			if(table.PipelineState == nullptr || !(table.PipelineState->GetDesc() == pipelineDesc))
+			{
+				table.PipelineState = GEngine->GetRenderDevice()->CreatePipelineState(pipelineDesc);
+			}
+
+			table.StateVersion = m_PassStateVersion;
+		}
 
-		for(uint8 uniformBlockIndex : m_MatDef->m_PassUniformBlockMapping[pass])
+		if(table.Shader == shader && table.Version == m_BindingVersion)
 		{
-			const MUniformBlock& block = m_MatDef->m_UniformBlocksDef[uniformBlockIndex];
+			return table;
+		}
+
+		CPU_DEBUG_SCOPE("Material::BuildBindingTable");
+
+		table.Shader = shader;
+		table.Version = m_BindingVersion;
+		table.UniformBlocks.clear();
+		table.Textures.clear();
 
-			VBufferCacheIndex cacheIndex;
-			uint8* data = GEngine->GetRenderManager()->GetUniformBufferCache().GetOrMap(block.Size, cacheIndex);
-			std::memcpy(data, m_UniformData.data() + block.Offset, block.Size);
-			GEngine->GetRenderManager()->GetUniformBufferCache().Unmap(cacheIndex);
-			drawState.BindUniformBuffer(block.Name, cacheIndex.Buffer, cacheIndex.Offset, cacheIndex.Size);
+		if(m_UniformBuffer)
+		{
+			for(uint8 uniformBlockIndex : m_MatDef->m_PassUniformBlockMapping[pass])
+			{
+				const MUniformBlock& block = m_MatDef->m_UniformBlocksDef[uniformBlockIndex];
+				table.UniformBlocks.push_back({block.NameID, m_UniformBlockOffsets[uniformBlockIndex], static_cast<uint32_t>(block.Size)});
+			}
 		}
 
-		// Set textures
 		for(TTypeID texId : m_MatDef->m_PassTextureMapping[pass])
 		{
-			MTextureVar* textureVar = GetTextureVar(texId);
+			const MTextureVar* textureVar = FindTextureVar(texId);
+
+			if(textureVar == nullptr)
+				continue;
 
-			if(textureVar->Texture == nullptr)
+			Texture_ptr texture = textureVar->Texture;
+
+			if(texture == nullptr)
 			{
+				// Global textures are bound by the renderer
 				if (textureVar->InShaderName[0] == 'g')
 				{
 					continue;
 				}
 
 				// TODO: Look at this and maybe fix this
-				drawState.BindTexture(textureVar->InShaderName, GEngine->GetResourceManager()->LoadTexture("Assets/Textures/blueprint.png"));
-				drawState.BindSampler(textureVar->InShaderName, textureVar->Sampler);
-				continue;
+				texture = GEngine->GetResourceManager()->LoadTexture("Assets/Textures/blueprint.png");
 			}
 
-			drawState.BindTexture(textureVar->InShaderName, textureVar->Texture);
-			drawState.BindSampler(textureVar->InShaderName, textureVar->Sampler);
+			table.Textures.push_back({HashDjb2(textureVar->InShaderName.c_str()), texture, textureVar->Sampler});
 		}
 
-		renderDevice->BindShaderResources(drawState);
-
-		MaterialPassState& passState = m_PassStates[pass];
-		renderDevice->SetRasterState(passState.RasterState);
-		renderDevice->SetDepthStencilState(passState.DepthStencilState);
-		renderDevice->SetBlendState(passState.BlendState);
-
-		drawState.RasterState = passState.RasterState;
-		drawState.DepthStencilState = passState.DepthStencilState;
-		drawState.BlendState = passState.BlendState;
+		return table;
 	}
 
 	void Material::EndPass(PassType_t pass, DrawCallState& state)
@@ -160,8 +278,6 @@ namespace Aurora
 
 		(void)pass;
 		(void)state;
-
-		GEngine->GetRenderManager()->GetUniformBufferCache().Reset();
 	}
 
 #pragma endregion RenderPass
@@ -186,6 +302,8 @@ namespace Aurora
 
 	uint8* Material::GetBlockMemory(StrHashID id, size_t size)
 	{
+		m_UniformDataDirty = true;
+
 		MUniformBlock* block = m_MatDef->FindUniformBlock(id);
 
 		if(block == nullptr)
@@ -220,6 +338,8 @@ namespace Aurora
 
 	uint8* Material::GetVariableMemory(StrHashID varId, size_t size)
 	{
+		m_UniformDataDirty = true;
+
 		MUniformBlock* block = nullptr;
 		MUniformVar* var = m_MatDef->FindUniformVar(varId, &block);
 
@@ -268,8 +388,25 @@ namespace Aurora
 
 	///////////////////////////////////// TEXTURES /////////////////////////////////////
 
+	const MTextureVar* Material::FindTextureVar(StrHashID varId) const
+	{
+		const auto& it = m_TextureVars.find(varId);
+
+		if(it != m_TextureVars.end())
+			return &it->second;
+
+		const auto& it2 = m_MatDef->m_TextureVars.find(varId);
+
+		if(it2 != m_MatDef->m_TextureVars.end())
+			return &it2->second;
+
+		return nullptr;
+	}
+
 	MTextureVar* Material::GetTextureVar(StrHashID varId)
 	{
+		m_BindingVersion++;
+
 		const auto& it = m_TextureVars.find(varId);
 
 		if(it == m_TextureVars.end())
@@ -298,7 +435,10 @@ namespace Aurora
 		var->Texture = texture;
 
 		if (var->HasEnableMacro)
+		{
 			m_Macros[var->MacroName] = var->Texture != nullptr ? "1" : "0";
+			m_PermutationKeyDirty = true;
+		}
 
 		return true;
 	}
@@ -14,6 +14,7 @@ namespace Aurora
 {
 	class MaterialDefinition;
 
+	// Permutation key of a macro set, equal sets give equal keys
 	[[nodiscard]] AU_API uint64_t HashShaderMacros(const ShaderMacros& macros);
 	AU_API std::ostream& operator<<(std::ostream &out, ShaderMacros const& macros);
 
@@ -95,6 +96,33 @@ namespace Aurora
 		MaterialPassState() : RasterState(), DepthStencilState(), BlendState() {}
 	};
 
+	// Bindings of one pass, resolved once for the shader permutation and reused until the material changes
+	struct MaterialBindingTable
+	{
+		struct BlockEntry
+		{
+			StrHashID NameID;
+			uint32_t Offset;
+			uint32_t Size;
+		};
+
+		struct TextureEntry
+		{
+			StrHashID NameID;
+			Texture_ptr Texture;
+			Sampler_ptr Sampler;
+		};
+
+		Shader_ptr Shader = nullptr;
+		uint32_t Version = 0;
+
+		PipelineState_ptr PipelineState = nullptr;
+		uint32_t StateVersion = 0;
+
+		std::vector<BlockEntry> UniformBlocks;
+		std::vector<TextureEntry> Textures;
+	};
+
 	typedef uint64_t SortID;
 
 	enum class RenderSortType : uint8
@@ -128,6 +156,9 @@ namespace Aurora
 		robin_hood::unordered_map<StrHashID, MTextureVar> m_TextureVars;
 
 		ShaderMacros m_Macros; // TODO: Finish macros
+		// Hashing the macros is only done after they changed, not on every pass
+		uint64_t m_PermutationKey = 0;
+		bool m_PermutationKeyDirty = true;
 
 		robin_hood::unordered_map<PassType_t, MaterialPassState> m_PassStates;
 
@@ -136,6 +167,21 @@ namespace Aurora
 
 		uint8_t m_StateCheck = 0;
 
+		// Sequential id used for draw sort keys, cheaper to compare than pointers and stable between runs
+		uint32_t m_SortIndex;
+
+		// Uniform blocks are kept in a buffer of their own and only uploaded after the data was handed out for writing
+		Buffer_ptr m_UniformBuffer;
+		std::vector<uint32_t> m_UniformBlockOffsets;
+		bool m_UniformDataDirty = true;
+
+		robin_hood::unordered_map<PassType_t, MaterialBindingTable> m_BindingTables;
+		// Accessors handing out writable references bump these too, the caller may change the data through them
+		// Bumped when a texture, sampler or the uniform buffer changes, tables built for an older version are rebuilt
+		uint32_t m_BindingVersion = 1;
+		// Bumped when a pass state may have been changed, only the pipeline states of the tables are recreated
+		uint32_t m_PassStateVersion = 1;
+
 	public:
 		EventEmitter<PassType_t, DrawCallState&, class CameraComponent*, Material*> BeforeMaterialBegin;
 	public:
@@ -149,14 +195,18 @@ namespace Aurora
 		[[nodiscard]] uint8_t GetFlags() const { return m_Flags; }
 		[[nodiscard]] bool HasFlag(uint8_t flag) const { return m_Flags & flag; }
 		void SetFlags(uint8_t flags) { m_Flags = flags; }
+		[[nodiscard]] uint32_t GetSortIndex() const { return m_SortIndex; }
+		// Sort index of the definition, materials sharing it share their shader programs
+		[[nodiscard]] uint32_t GetProgramSortIndex() const;
 
 		FRasterState& RasterState(PassType_t pass = 0);
 		FDepthStencilState& DepthStencilState(PassType_t pass = 0);
 		FBlendState& BlendState(PassType_t pass = 0);
 
-		ShaderMacros& GetMacros() { return m_Macros; }
+		ShaderMacros& GetMacros() { m_PermutationKeyDirty = true; return m_Macros; }
 		[[nodiscard]] const ShaderMacros& GetMacros() const { return m_Macros; }
-		void SetMacro(const String& key, const String& value) { m_Macros[key] = value; }
+		void SetMacro(const String& key, const String& value) { m_Macros[key] = value; m_PermutationKeyDirty = true; }
+		[[nodiscard]] uint64_t GetPermutationKey();
 
 		void BeginPass(PassType_t pass, DrawCallState& state);
 		void EndPass(PassType_t pass, DrawCallState& state);
@@ -166,6 +216,8 @@ namespace Aurora
 
 		void SetAlphaThresholdEnabled(bool alphaThreshold)
 		{
+			m_PermutationKeyDirty = true;
+
 			if (alphaThreshold)
 			{
 				m_Macros["USE_ALPHA_THRESHOLD"] = "1";
@@ -242,6 +294,11 @@ namespace Aurora
 
 		//////// Buffers ////////
 		bool SetBuffer(StrHashID bufferId, const Buffer_ptr& buffer) { return false; } // TODO: Complete buffers
+	private:
+		void UploadUniformData();
+		const MaterialBindingTable& GetBindingTable(PassType_t pass, const Shader_ptr& shader);
+		// Lookup that does not copy the definition variable into the instance
+		[[nodiscard]] const MTextureVar* FindTextureVar(StrHashID varId) const;
 	};
 
 	using matref = std::shared_ptr<Material>;
@@ -14,9 +14,12 @@ namespace Aurora
 
 	Shader_ptr MaterialPassDef::GetShader(const ShaderMacros& macros)
 	{
-		uint64_t hash = HashShaderMacros(macros);
+		return GetShader(HashShaderMacros(macros), macros);
+	}
 
-		const auto& it = m_ShaderPermutations.find(hash);
+	Shader_ptr MaterialPassDef::GetShader(uint64_t permutationKey, const ShaderMacros& macros)
+	{
+		const auto& it = m_ShaderPermutations.find(permutationKey);
 
 		if(it == m_ShaderPermutations.end())
 		{
@@ -30,7 +33,7 @@ namespace Aurora
 				return nullptr;
 			}
 
-			m_ShaderPermutations[hash] = newShader;
+			m_ShaderPermutations[permutationKey] = newShader;
 			return newShader;
 		}
 
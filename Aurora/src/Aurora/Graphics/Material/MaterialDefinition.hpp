@@ -18,13 +18,16 @@ namespace Aurora
 	{
 	private:
 		ShaderProgramDesc m_ShaderBaseDescription;
-		std::unordered_map<PassType_t, Shader_ptr> m_ShaderPermutations;
+		// By permutation key of the macro set
+		std::unordered_map<uint64_t, Shader_ptr> m_ShaderPermutations;
 
 		MaterialPassState m_PassStates;
 	public:
 		MaterialPassDef() = default;
 		MaterialPassDef(ShaderProgramDesc shaderProgramDesc, MaterialPassState passState);
 		Shader_ptr GetShader(const ShaderMacros& macroSet);
+		// The macros are only read when the permutation was not compiled yet
+		Shader_ptr GetShader(uint64_t permutationKey, const ShaderMacros& macroSet);
 		void ReloadShader();
 
 		inline MaterialPassState& GetMaterialPassState() { return m_PassStates; }
@@ -1,9 +1,10 @@
 #include "GLContextState.hpp"
 #include "GLUtils.hpp"
+#include "GLConversions.hpp"
 
 namespace Aurora
 {
-	GLContextState::GLContextState() : m_ActiveTexture(-1), m_LastShaderHandle(0)
+	GLContextState::GLContextState() : m_ActiveTexture(-1), m_LastShaderHandle(0), m_PipelineStateID(0), m_RasterState(), m_DepthStencilState(), m_RasterStateUnknown(true), m_DepthStateUnknown(true)
 	{
 
 	}
@@ -28,12 +29,26 @@ namespace Aurora
 
 		m_ActiveTexture = -1;
 		m_LastShaderHandle = -1;
+		m_PipelineStateID = 0;
+
+		m_RasterState = FRasterState();
+		m_DepthStencilState = FDepthStencilState();
+
+		m_RasterState.FillMode = EFillMode::Solid;
+		m_RasterState.CullMode = ECullMode::Front;
+		m_RasterState.DepthClipEnable = false;
+
+		m_DepthStencilState.DepthEnable = false;
+
+		m_RasterStateUnknown = true;
+		m_DepthStateUnknown = true;
 
 		m_BoundTextures.clear();
 		m_BoundSamplers.clear();
 		m_BoundImages.clear();
 		m_BoundUniformBuffers.clear();
 		m_BoundStorageBlocks.clear();
+		m_BoundStorageRanges.clear();
 	}
 
 	template <typename ObjectType>
@@ -109,6 +124,243 @@ namespace Aurora
 			glUseProgram(GLProgHandle);
 			CHECK_GL_ERROR("Failed to set GL program");
 		}
+
+		m_PipelineStateID = 0;
+	}
+
+	void GLContextState::SetPipelineState(const PipelineState& pipelineState, GLShaderProgram* shader)
+	{
+		if (m_PipelineStateID == pipelineState.GetID())
+			return;
+
+		const PipelineStateDesc& desc = pipelineState.GetDesc();
+
+		SetShader(shader);
+		SetRasterState(desc.RasterState);
+		SetDepthStencilState(desc.DepthStencilState);
+		SetBlendState(desc.BlendState);
+
+		m_PipelineStateID = pipelineState.GetID();
+	}
+
+	void GLContextState::SetBlendState(const FBlendState& state)
+	{
+		m_PipelineStateID = 0;
+
+		if (state.AlphaToCoverage)
+		{
+			glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+		}
+
+		// TODO: Finish proper blending
+
+		if (state.Enabled)
+		{
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		}
+		else
+		{
+			glDisable(GL_BLEND);
+		}
+
+		/*for (uint32_t i = 0; i < targetCount; ++i)
+		{
+			if (blendState.blendEnable[i])
+				glEnablei(GL_BLEND, i);
+
+			uint32_t BlendOpRGB = convertBlendOp(blendState.blendOp[i]);
+			uint32_t BlendOpAlpha = convertBlendOp(blendState.blendOpAlpha[i]);
+			glBlendEquationSeparatei(i, BlendOpRGB, BlendOpAlpha);
+
+			uint32_t SrcBlendRGB = convertBlendValue(blendState.srcBlend[i]);
+			uint32_t DstBlendRGB = convertBlendValue(blendState.destBlend[i]);
+			uint32_t SrcBlendAlpha = convertBlendValue(blendState.srcBlendAlpha[i]);
+			uint32_t DstBlendAlpha = convertBlendValue(blendState.destBlendAlpha[i]);
+			glBlendFuncSeparatei(i, SrcBlendRGB, DstBlendRGB, SrcBlendAlpha, DstBlendAlpha);
+
+			glColorMaski(i,
+				(blendState.colorWriteEnable[i] & BlendState::COLOR_MASK_RED) != 0,
+				(blendState.colorWriteEnable[i] & BlendState::COLOR_MASK_GREEN) != 0,
+				(blendState.colorWriteEnable[i] & BlendState::COLOR_MASK_BLUE) != 0,
+				(blendState.colorWriteEnable[i] & BlendState::COLOR_MASK_ALPHA) != 0);
+		}*/
+	}
+
+	void GLContextState::SetRasterState(const FRasterState& rasterState)
+	{
+		m_PipelineStateID = 0;
+
+		if (m_RasterStateUnknown || m_RasterState.FillMode != rasterState.FillMode)
+		{
+			switch (rasterState.FillMode)
+			{
+				case EFillMode::Line:
+					glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+					break;
+				case EFillMode::Solid:
+					glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+					break;
+
+				default:
+					AU_LOG_WARNING("Unknown fill mode specified");
+					break;
+			}
+			m_RasterState.FillMode = rasterState.FillMode;
+		}
+
+		if (m_RasterState.CullMode != rasterState.CullMode)
+		{
+			switch (rasterState.CullMode)
+			{
+				case ECullMode::Back:
+					glCullFace(GL_BACK);
+					glEnable(GL_CULL_FACE);
+					break;
+				case ECullMode::Front:
+					glCullFace(GL_FRONT);
+					glEnable(GL_CULL_FACE);
+					break;
+				case ECullMode::None:
+					glDisable(GL_CULL_FACE);
+					break;
+				default:
+					AU_LOG_WARNING("Unknown cullMode");
+			}
+			m_RasterState.CullMode = rasterState.CullMode;
+		}
+
+		if (m_RasterStateUnknown || m_RasterState.FrontCounterClockwise != rasterState.FrontCounterClockwise)
+		{
+			glFrontFace(rasterState.FrontCounterClockwise ? GL_CCW : GL_CW);
+			m_RasterState.FrontCounterClockwise = rasterState.FrontCounterClockwise;
+		}
+
+		if (m_RasterState.DepthClipEnable)
+		{
+			if (rasterState.DepthClipEnable)
+			{
+				glEnable(GL_DEPTH_CLAMP);
+			}
+			else
+			{
+				glDisable(GL_DEPTH_CLAMP);
+			}
+			m_RasterState.DepthClipEnable = rasterState.DepthClipEnable;
+		}
+
+		if (m_RasterState.ScissorEnable != rasterState.ScissorEnable)
+		{
+			if (rasterState.ScissorEnable)
+			{
+				glEnable(GL_SCISSOR_TEST);
+			}
+			else
+			{
+				glDisable(GL_SCISSOR_TEST);
+			}
+			m_RasterState.ScissorEnable = rasterState.ScissorEnable;
+		}
+
+		if (m_RasterState.DepthBias != rasterState.DepthBias || m_RasterState.SlopeScaledDepthBias != rasterState.SlopeScaledDepthBias)
+		{
+			if (rasterState.DepthBias != 0 || rasterState.SlopeScaledDepthBias != 0.f)
+			{
+				glEnable(GL_POLYGON_OFFSET_FILL);
+				glPolygonOffset(rasterState.SlopeScaledDepthBias, float(rasterState.DepthBias));
+			}
+
+			m_RasterState.DepthBias = rasterState.DepthBias;
+			m_RasterState.SlopeScaledDepthBias = rasterState.SlopeScaledDepthBias;
+		}
+
+		if (rasterState.MultisampleEnable != m_RasterState.MultisampleEnable)
+		{
+			m_RasterState.MultisampleEnable = rasterState.MultisampleEnable;
+
+			if (rasterState.MultisampleEnable)
+			{
+				glEnable(GL_MULTISAMPLE);
+				glSampleMaski(0, ~0u);
+				CHECK_GL_ERROR();
+			}
+			else
+			{
+				glDisable(GL_MULTISAMPLE);
+			}
+		}
+
+		if (rasterState.LineWidth != m_RasterState.LineWidth)
+		{
+			m_RasterState.LineWidth = rasterState.LineWidth;
+			glLineWidth(rasterState.LineWidth);
+		}
+
+		m_RasterStateUnknown = false;
+	}
+
+	void GLContextState::SetDepthStencilState(FDepthStencilState depthState)
+	{
+		m_PipelineStateID = 0;
+
+		if (m_DepthStateUnknown || m_DepthStencilState.DepthEnable != depthState.DepthEnable)
+		{
+			if (depthState.DepthEnable)
+			{
+				glEnable(GL_DEPTH_TEST);
+			}
+			else
+			{
+				glDisable(GL_DEPTH_TEST);
+			}
+			m_DepthStencilState.DepthEnable = depthState.DepthEnable;
+		}
+
+		// Mask and function are only set while the depth test is on
+		if (depthState.DepthEnable)
+		{
+			if (m_DepthStateUnknown || m_DepthStencilState.DepthWriteMask != depthState.DepthWriteMask)
+			{
+				glDepthMask((depthState.DepthWriteMask == EDepthWriteMask::All) ? GL_TRUE : GL_FALSE);
+				m_DepthStencilState.DepthWriteMask = depthState.DepthWriteMask;
+			}
+
+			if (m_DepthStateUnknown || m_DepthStencilState.DepthFunc != depthState.DepthFunc)
+			{
+				glDepthFunc(ConvertComparisonFunc(depthState.DepthFunc));
+				m_DepthStencilState.DepthFunc = depthState.DepthFunc;
+			}
+		}
+
+		if (m_DepthStencilState.StencilEnable != depthState.StencilEnable)
+		{
+			//TODO: Other props needs to be checked too, but I think that we will never user stencil
+
+			if (depthState.StencilEnable)
+			{
+				glEnable(GL_STENCIL_TEST);
+
+				glStencilFuncSeparate(GL_FRONT, ConvertComparisonFunc(depthState.FrontFace.StencilFunc), depthState.StencilRefValue, depthState.StencilReadMask);
+				glStencilOpSeparate(GL_FRONT, ConvertStencilOp(depthState.FrontFace.StencilFailOp),
+				                    ConvertStencilOp(depthState.FrontFace.StencilDepthFailOp),
+				                    ConvertStencilOp(depthState.FrontFace.StencilPassOp));
+
+				glStencilFuncSeparate(GL_BACK, ConvertComparisonFunc(depthState.BackFace.StencilFunc), depthState.StencilRefValue, depthState.StencilReadMask);
+				glStencilOpSeparate(GL_BACK, ConvertStencilOp(depthState.BackFace.StencilFailOp),
+				                    ConvertStencilOp(depthState.BackFace.StencilDepthFailOp),
+				                    ConvertStencilOp(depthState.BackFace.StencilPassOp));
+
+				glStencilMask(depthState.StencilWriteMask);
+			}
+			else
+			{
+				glDisable(GL_STENCIL_TEST);
+			}
+			m_DepthStencilState.StencilEnable = depthState.StencilEnable;
+		}
+
+		// Mask and function stay unknown until the test is turned on
+		m_DepthStateUnknown = m_DepthStateUnknown && !depthState.DepthEnable;
 	}
 
 	void GLContextState::SetActiveTexture(GLContextState::BindIndex index)
@@ -180,8 +432,15 @@ namespace Aurora
 
 	void GLContextState::BindStorageBlock(GLContextState::BindIndex index, GLBuffer *buffer, uint32_t offset, uint32_t size)
 	{
+		if (index >= m_BoundStorageRanges.size())
+			m_BoundStorageRanges.resize(index + 1, {0, 0});
+
+		BoundRange& boundRange = m_BoundStorageRanges[index];
+		bool rangeChanged = boundRange.Offset != offset || boundRange.Size != size;
+		boundRange = {offset, size};
+
 		GLuint GLBufferHandle = 0;
-		if (UpdateBoundObjectsArr(m_BoundStorageBlocks, index, buffer, GLBufferHandle))
+		if (UpdateBoundObjectsArr(m_BoundStorageBlocks, index, buffer, GLBufferHandle) || (rangeChanged && buffer != nullptr))
 		{
 			//glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, GLBufferHandle);
 			glBindBufferRange(GL_SHADER_STORAGE_BUFFER, index, GLBufferHandle, offset, size);
@@ -7,6 +7,7 @@
 #include "GLTexture.hpp"
 #include "GLSampler.hpp"
 #include "GLBuffer.hpp"
+#include "../Base/PipelineState.hpp"
 
 namespace Aurora
 {
@@ -15,9 +16,22 @@ namespace Aurora
 	public:
 		typedef uint32_t BindIndex;
 	private:
+		struct BoundRange
+		{
+			uint32_t Offset;
+			uint32_t Size;
+		};
+
 		uint32_t m_PendingMemoryBarriers = 0;
 
 		UniqueIdentifier m_LastShaderHandle;
+		// ID of the last applied pipeline state, zero when the state was changed piece by piece
+		uint32_t m_PipelineStateID;
+		FRasterState m_RasterState;
+		FDepthStencilState m_DepthStencilState;
+		// Set by Invalidate, other code may have changed the GL state so the next set applies it whole
+		bool m_RasterStateUnknown;
+		bool m_DepthStateUnknown;
 		BindIndex m_ActiveTexture;
 
 		std::vector<UniqueIdentifier> m_BoundTextures;
@@ -25,12 +39,22 @@ namespace Aurora
 		std::vector<UniqueIdentifier> m_BoundImages;
 		std::vector<UniqueIdentifier> m_BoundUniformBuffers;
 		std::vector<UniqueIdentifier> m_BoundStorageBlocks;
+		// Range of every bound storage block, a slice of the same buffer needs a rebind too
+		std::vector<BoundRange> m_BoundStorageRanges;
 	public:
 		GLContextState();
 	public:
 		void Invalidate();
 
 		void SetShader(GLShaderProgram* shader);
+		void SetPipelineState(const PipelineState& pipelineState, GLShaderProgram* shader);
+
+		void SetBlendState(const FBlendState& state);
+		void SetRasterState(const FRasterState& rasterState);
+		void SetDepthStencilState(FDepthStencilState depthState);
+
+		[[nodiscard]] const FRasterState& GetRasterState() const { return m_RasterState; }
+		[[nodiscard]] const FDepthStencilState& GetDepthStencilState() const { return m_DepthStencilState; }
 
 		void SetActiveTexture(BindIndex index);
 		void BindTexture(BindIndex index, GLTexture* texture);
@@ -0,0 +1,278 @@
+#include "GLProgramCache.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+
+#include "Aurora/Core/Hash.hpp"
+#include "Aurora/Core/Profiler.hpp"
+#include "Aurora/Core/FileSystem.hpp"
+#include "Aurora/Logger/Logger.hpp"
+
+namespace Aurora
+{
+	static constexpr uint32_t ProgramCacheMagic = 0x43505541; // "AUPC"
+	static constexpr uint32_t ProgramCacheVersion = 2;
+
+	// Magic, version, driver hash, payload size and payload hash
+	static constexpr size_t ProgramCacheHeaderSize = sizeof(uint32_t) * 2 + sizeof(uint64_t) * 3;
+
+	struct ProgramCacheHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint64_t DriverHash;
+		uint64_t PayloadSize;
+		uint64_t PayloadHash;
+	};
+
+	static ProgramCacheHeader ReadHeader(const uint8_t* data)
+	{
+		Archive archive(data, ProgramCacheHeaderSize);
+
+		ProgramCacheHeader header;
+		header.Magic = archive.Read<uint32_t>();
+		header.Version = archive.Read<uint32_t>();
+		header.DriverHash = archive.Read<uint64_t>();
+		header.PayloadSize = archive.Read<uint64_t>();
+		header.PayloadHash = archive.Read<uint64_t>();
+		return header;
+	}
+
+	// GL errors are sticky, calls checked with glGetError must not see the ones left by earlier calls
+	static void ClearGLErrors()
+	{
+		while (glGetError() != GL_NO_ERROR) {}
+	}
+
+	static uint64_t HashBytes(const uint8_t* data, size_t size)
+	{
+		return HashDjb2(std::string_view(reinterpret_cast<const char*>(data), size));
+	}
+
+	static uint64_t HashGLString(GLenum name)
+	{
+		const GLubyte* value = glGetString(name);
+		return value ? HashDjb2(reinterpret_cast<const char*>(value)) : 0;
+	}
+
+	GLProgramCache::GLProgramCache() : m_Directory(), m_DriverHash(0), m_Enabled(false)
+	{
+
+	}
+
+	void GLProgramCache::Init(const Path& directory)
+	{
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+
+		if (formatCount <= 0)
+		{
+			AU_LOG_INFO("Driver has no program binary formats, program cache is disabled");
+			return;
+		}
+
+		std::error_code errorCode;
+		std::filesystem::create_directories(directory, errorCode);
+
+		if (errorCode)
+		{
+			AU_LOG_WARNING("Could not create program cache directory ", directory.string(), ", reason: ", errorCode.message());
+			return;
+		}
+
+		std::vector<GLint> formats(formatCount);
+		glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data());
+
+		m_DriverHash = 0;
+		HashCombine(m_DriverHash, HashGLString(GL_VENDOR));
+		HashCombine(m_DriverHash, HashGLString(GL_RENDERER));
+		HashCombine(m_DriverHash, HashGLString(GL_VERSION));
+
+		for (GLint format : formats)
+		{
+			HashCombine(m_DriverHash, format);
+		}
+
+		m_Directory = directory;
+		m_Enabled = true;
+
+		AU_LOG_INFO("Program cache is stored in ", m_Directory.string());
+
+		EvictStaleEntries();
+	}
+
+	void GLProgramCache::EvictStaleEntries() const
+	{
+		CPU_DEBUG_SCOPE("GLProgramCache::EvictStaleEntries");
+
+		std::error_code errorCode;
+		size_t evictedCount = 0;
+
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(m_Directory, errorCode))
+		{
+			if (!entry.is_regular_file(errorCode) || entry.path().extension() != ".bin")
+				continue;
+
+			// Only the header is read, a broken payload is caught by Load and overwritten by the next Store
+			uint8_t headerData[ProgramCacheHeaderSize];
+
+			std::ifstream stream(entry.path(), std::ios::in | std::ios::binary);
+			stream.read(reinterpret_cast<char*>(headerData), ProgramCacheHeaderSize);
+
+			bool stale = static_cast<size_t>(stream.gcount()) != ProgramCacheHeaderSize;
+
+			if (!stale)
+			{
+				ProgramCacheHeader header = ReadHeader(headerData);
+				stale = header.Magic != ProgramCacheMagic || header.Version != ProgramCacheVersion || header.DriverHash != m_DriverHash;
+			}
+
+			stream.close();
+
+			if (stale && std::filesystem::remove(entry.path(), errorCode))
+			{
+				++evictedCount;
+			}
+		}
+
+		if (evictedCount > 0)
+		{
+			AU_LOG_INFO("Evicted ", evictedCount, " program cache entries of another driver or cache version");
+		}
+	}
+
+	uint64_t GLProgramCache::GetProgramKey(const std::vector<std::pair<EShaderType, String>>& sources) const
+	{
+		uint64_t key = m_DriverHash;
+		HashCombine(key, ProgramCacheVersion);
+
+		for (const auto& [type, source] : sources)
+		{
+			HashCombine(key, type);
+			HashCombine(key, HashDjb2(source));
+		}
+
+		return key;
+	}
+
+	Path GLProgramCache::GetEntryPath(uint64_t key) const
+	{
+		char fileName[32];
+		snprintf(fileName, sizeof(fileName), "%016llx.bin", static_cast<unsigned long long>(key));
+		return m_Directory / fileName;
+	}
+
+	GLuint GLProgramCache::Load(uint64_t key, GLShaderResources& resources) const
+	{
+		if (!m_Enabled)
+			return 0;
+
+		CPU_DEBUG_SCOPE("GLProgramCache::Load");
+
+		Path path = GetEntryPath(key);
+
+		if (!FS::FileExists(path))
+			return 0;
+
+		DataBlob data = FS::LoadFile(path);
+
+		if (data.size() < ProgramCacheHeaderSize)
+			return 0;
+
+		ProgramCacheHeader header = ReadHeader(data.data());
+
+		const uint8_t* payload = data.data() + ProgramCacheHeaderSize;
+		const uint64_t payloadSize = data.size() - ProgramCacheHeaderSize;
+
+		// Only a complete entry written by this version is parsed, the archive does not check its reads
+		if (header.Magic != ProgramCacheMagic || header.Version != ProgramCacheVersion || header.PayloadSize != payloadSize || header.PayloadHash != HashBytes(payload, payloadSize))
+		{
+			AU_LOG_WARNING("Program cache entry ", path.string(), " is corrupted");
+			return 0;
+		}
+
+		Archive archive(payload, payloadSize);
+
+		uint64_t storedKey = archive.Read<uint64_t>();
+		GLenum binaryFormat = archive.Read<GLenum>();
+		std::vector<uint8_t> binary;
+		archive >> binary;
+
+		if (storedKey != key)
+			return 0;
+
+		GLuint program = glCreateProgram();
+
+		ClearGLErrors();
+		glProgramBinary(program, binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+		GLint linkStatus = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+
+		// Drivers reject binaries after an update even when the version string did not change
+		if (glGetError() != GL_NO_ERROR || linkStatus == GL_FALSE)
+		{
+			glDeleteProgram(program);
+			return 0;
+		}
+
+		resources.Deserialize(archive);
+		return program;
+	}
+
+	void GLProgramCache::Store(uint64_t key, GLuint program, const GLShaderResources& resources) const
+	{
+		if (!m_Enabled)
+			return;
+
+		CPU_DEBUG_SCOPE("GLProgramCache::Store");
+
+		GLint binaryLength = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+
+		if (binaryLength <= 0)
+			return;
+
+		std::vector<uint8_t> binary(binaryLength);
+		GLenum binaryFormat = 0;
+
+		ClearGLErrors();
+		glGetProgramBinary(program, binaryLength, nullptr, &binaryFormat, binary.data());
+
+		if (glGetError() != GL_NO_ERROR)
+		{
+			AU_LOG_WARNING("Could not get program binary");
+			return;
+		}
+
+		Archive archive;
+		archive << key;
+		archive << binaryFormat;
+		archive << binary;
+		resources.Serialize(archive);
+
+		Archive header;
+		header << ProgramCacheMagic;
+		header << ProgramCacheVersion;
+		header << m_DriverHash;
+		header << static_cast<uint64_t>(archive.GetSize());
+		header << HashBytes(archive.GetBufferPointer(), archive.GetSize());
+
+		Path path = GetEntryPath(key);
+
+		std::ofstream stream;
+		stream.open(path, std::ios::out | std::ios::binary);
+
+		if (!stream.is_open())
+		{
+			AU_LOG_WARNING("Could not write program cache entry ", path.string());
+			return;
+		}
+
+		stream << header;
+		stream << archive;
+		stream.close();
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "Aurora/Core/Types.hpp"
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Core/String.hpp"
+#include "../Base/ShaderBase.hpp"
+#include "GL.hpp"
+#include "GLShaderResources.hpp"
+
+namespace Aurora
+{
+	// Stores linked programs on disk with glGetProgramBinary, so later launches skip compiling them.
+	// Entries are keyed by the preprocessed sources and the driver, a driver that rejects a binary just causes a compile.
+	// Entries of other drivers are removed by Init.
+	class AU_API GLProgramCache
+	{
+	private:
+		Path m_Directory;
+		// Vendor, renderer, version and binary formats of the driver
+		uint64_t m_DriverHash;
+		bool m_Enabled;
+	public:
+		GLProgramCache();
+
+		void Init(const Path& directory);
+		[[nodiscard]] bool IsEnabled() const { return m_Enabled; }
+
+		[[nodiscard]] uint64_t GetProgramKey(const std::vector<std::pair<EShaderType, String>>& sources) const;
+
+		// Returns a linked program and its resources, zero on a miss or when the driver rejects the binary
+		[[nodiscard]] GLuint Load(uint64_t key, GLShaderResources& resources) const;
+		void Store(uint64_t key, GLuint program, const GLShaderResources& resources) const;
+	private:
+		[[nodiscard]] Path GetEntryPath(uint64_t key) const;
+		// Removes entries written for another driver or cache version, they would never be loaded again
+		void EvictStaleEntries() const;
+	};
+}
@@ -8,6 +8,7 @@
 #include <Aurora/Core/assert.hpp>
 #include <Aurora/Core/String.hpp>
 #include <Aurora/Core/Profiler.hpp>
+#include <Aurora/Core/FileSystem.hpp>
 
 
 static const char* g_BlitVS = R"(
@@ -75,22 +76,25 @@ namespace Aurora
 
 	GLRenderDevice::GLRenderDevice()
 	: IRenderDevice(),
-	m_nVAO(0),
 	m_nVAOEmpty(0),
 	m_LastVao(0),
+	m_LastElementBuffer(0),
 	m_ContextState(),
-	m_LastRasterState(),
-	m_LastDepthState(),
+	m_NextPipelineStateID(1),
 	m_LastViewPort(0, 0),
-	m_LastInputLayout(nullptr),
-	m_GpuVendor(EGpuVendor::Unknown)
+	m_GpuVendor(EGpuVendor::Unknown),
+	m_ShaderDrawParameters(false)
 	{
 
 	}
 
 	GLRenderDevice::~GLRenderDevice()
 	{
-		glDeleteVertexArrays(1, &m_nVAO);
+		for (const auto& [key, vao] : m_CachedVaos)
+		{
+			glDeleteVertexArrays(1, &vao);
+		}
+
 		glDeleteVertexArrays(1, &m_nVAOEmpty);
 	}
 
@@ -98,11 +102,9 @@ namespace Aurora
 	{
 		CHECK_GL_ERROR_AND_THROW("Error before GLRenderDevice::Init");
 
-		glGenVertexArrays(1, &m_nVAO);
-		CHECK_GL_ERROR_AND_THROW("Cannot gen default vao");
 		glGenVertexArrays(1, &m_nVAOEmpty);
 		CHECK_GL_ERROR_AND_THROW("Cannot gen empty vao");
-		glBindVertexArray(m_nVAO);
+		BindVertexArray(m_nVAOEmpty, 0);
 		CHECK_GL_ERROR_AND_THROW("Cannot bind empty vao");
 
 
@@ -135,6 +137,11 @@ namespace Aurora
 			m_GpuVendor = EGpuVendor::AMD;
 		}
 
+		m_ShaderDrawParameters = GLAD_GL_ARB_shader_draw_parameters;
+		AU_LOG_INFO("GL_ARB_shader_draw_parameters ", m_ShaderDrawParameters ? "is supported" : "is not supported, multi draw indirect is disabled");
+
+		m_ProgramCache.Init(FS::GetCacheDir() / "ShaderCache");
+
 		{
 			GLint size;
 			glGetIntegerv(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &size);
@@ -172,9 +179,9 @@ namespace Aurora
 		InvalidateState();
 		CHECK_GL_ERROR_AND_THROW("Cannot invalidate state");
 
-		SetRasterState(m_LastRasterState);
+		SetRasterState(m_ContextState.GetRasterState());
 		CHECK_GL_ERROR_AND_THROW("Cannot set raster state");
-		SetDepthStencilState(m_LastDepthState);
+		SetDepthStencilState(m_ContextState.GetDepthStencilState());
 		CHECK_GL_ERROR_AND_THROW("Cannot set depth state");
 
 		{ // Init blit shader
@@ -211,7 +218,7 @@ namespace Aurora
 			return nullptr;
 		}*/
 
-		std::vector<GLuint> compiledShaders;
+		std::vector<std::pair<EShaderType, String>> preprocessedSources;
 		for (const auto& it : shaderDescriptions)
 		{
 			const auto& shaderDesc = it.second;
@@ -263,6 +270,37 @@ namespace Aurora
 				glslSourcePreprocessed.insert(18, ext);
 			}
 
+			if (type == EShaderType::Vertex && m_ShaderDrawParameters)
+			{
+				String ext;
+				ext += "#extension GL_ARB_shader_draw_parameters : enable\n";
+				ext += "#define SHADER_DRAW_PARAMETERS\n";
+				glslSourcePreprocessed.insert(18, ext);
+			}
+
+			preprocessedSources.emplace_back(type, std::move(glslSourcePreprocessed));
+		}
+
+		uint64_t cacheKey = 0;
+
+		if (m_ProgramCache.IsEnabled())
+		{
+			cacheKey = m_ProgramCache.GetProgramKey(preprocessedSources);
+
+			GLShaderResources cachedResources;
+			GLuint cachedProgramID = m_ProgramCache.Load(cacheKey, cachedResources);
+
+			if (cachedProgramID != 0)
+			{
+				auto shaderProgram = std::make_shared<GLShaderProgram>(cachedProgramID, desc, std::move(cachedResources));
+				glObjectLabel(GL_PROGRAM, cachedProgramID, static_cast<GLsizei>(desc.GetName().size()), desc.GetName().c_str());
+				return shaderProgram;
+			}
+		}
+
+		std::vector<GLuint> compiledShaders;
+		for (const auto& [type, glslSourcePreprocessed] : preprocessedSources)
+		{
 			std::string error;
 			GLuint shaderID = CompileShaderRaw(glslSourcePreprocessed, type, &error);
 
@@ -278,6 +316,11 @@ namespace Aurora
 		GLuint programID = glCreateProgram();
 		CHECK_GL_ERROR_AND_THROW("Could not create program ", desc.GetName());
 
+		if (m_ProgramCache.IsEnabled())
+		{
+			glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+
 		// Attach shaders
 
 		for (auto shaderID : compiledShaders)
@@ -344,6 +387,7 @@ namespace Aurora
 		}
 
 		auto shaderProgram = std::make_shared<GLShaderProgram>(programID, desc);
+		m_ProgramCache.Store(cacheKey, programID, shaderProgram->GetGLResource());
 
 		// Cleanup before returning shader program object
 		for (auto shaderID : compiledShaders)
@@ -898,8 +942,7 @@ namespace Aurora
 				return;
 			}
 
-			glBindVertexArray(m_nVAOEmpty); // FIXME: idk why, but when frustum clips all geometry and nothing renders,then this call happens, it will throw error in non bound Array (maybe it does NanoVG?)
-			m_LastVao = m_nVAOEmpty;
+			BindVertexArray(m_nVAOEmpty, 0); // FIXME: idk why, but when frustum clips all geometry and nothing renders,then this call happens, it will throw error in non bound Array (maybe it does NanoVG?)
 		}
 
 		if(bindState)
@@ -919,8 +962,6 @@ namespace Aurora
 
 	#define BUFFER_OFFSET(i) ((char *)NULL + (i))
 
-	GLuint lastUsedElementBuffer = 0;
-
 	void GLRenderDevice::DrawIndexed(const DrawCallState &state, const std::vector<DrawArguments> &args, bool bindState)
 	{
 		CPU_DEBUG_SCOPE("DrawIndexed");
@@ -936,13 +977,7 @@ namespace Aurora
 
 		CHECK_GL_ERROR();
 
-		GLBuffer* ib = GetBuffer(state.IndexBuffer.Buffer);
-
-		if (lastUsedElementBuffer != ib->Handle())
-		{
-			lastUsedElementBuffer = ib->Handle();
-		}
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ib->Handle());
+		BindElementBuffer(GetBuffer(state.IndexBuffer.Buffer));
 
 		GLenum primitiveType = ConvertPrimType(state.PrimitiveType);
 		GLenum ibFormat = ConvertIndexBufferFormat(state.IndexBuffer.Format);
@@ -951,8 +986,7 @@ namespace Aurora
 		{
 			if (args[0].InstanceCount > 1)
 			{
-				//glDrawElementsInstancedBaseVertex(primitiveType, GLsizei(drawArg.VertexCount), ibFormat, (const void*)size_t(drawArg.StartIndexLocation), GLsizei(drawArg.InstanceCount), GLint(drawArg.StartVertexLocation));
-				glDrawElementsInstanced(primitiveType, GLsizei(args[0].VertexCount), ibFormat, BUFFER_OFFSET(args[0].StartIndexLocation), GLsizei(args[0].InstanceCount));
+				glDrawElementsInstancedBaseVertex(primitiveType, GLsizei(args[0].VertexCount), ibFormat, BUFFER_OFFSET(args[0].StartIndexLocation), GLsizei(args[0].InstanceCount), GLint(args[0].StartVertexLocation));
 			}
 			else
 			{
@@ -965,14 +999,14 @@ namespace Aurora
 
 		GLsizei* count = nullptr;
 		uintptr_t* indices = nullptr;
+		GLint* baseVertices = nullptr;
 		uint16_t multiDrawCount = 0;
 
 		for (const auto& drawArg : args)
 		{
 			if (drawArg.InstanceCount > 1)
 			{
-				//glDrawElementsInstancedBaseVertex(primitiveType, GLsizei(drawArg.VertexCount), ibFormat, (const void*)size_t(drawArg.StartIndexLocation), GLsizei(drawArg.InstanceCount), GLint(drawArg.StartVertexLocation));
-				glDrawElementsInstanced(primitiveType, GLsizei(drawArg.VertexCount), ibFormat, BUFFER_OFFSET(drawArg.StartIndexLocation), GLsizei(drawArg.InstanceCount));
+				glDrawElementsInstancedBaseVertex(primitiveType, GLsizei(drawArg.VertexCount), ibFormat, BUFFER_OFFSET(drawArg.StartIndexLocation), GLsizei(drawArg.InstanceCount), GLint(drawArg.StartVertexLocation));
 			}
 			else
 			{
@@ -983,16 +1017,19 @@ namespace Aurora
 					count = (GLsizei*)alloca( sizeof(GLsizei) * args.size());
 				if (!indices)
 					indices = (uintptr_t*)alloca( sizeof(uintptr_t) * args.size());
+				if (!baseVertices)
+					baseVertices = (GLint*)alloca( sizeof(GLint) * args.size());
 
 				count[multiDrawCount] = GLsizei(drawArg.VertexCount);
 				indices[multiDrawCount] = drawArg.StartIndexLocation;
+				baseVertices[multiDrawCount] = GLint(drawArg.StartVertexLocation);
 				multiDrawCount++;
 			}
 			m_FrameRenderStatistics.VertexCount += drawArg.VertexCount * 3 * drawArg.InstanceCount;
 		}
 
 		if (multiDrawCount > 0)
-			glMultiDrawElements(primitiveType, count, ibFormat, (const void* const*)indices, multiDrawCount);
+			glMultiDrawElementsBaseVertex(primitiveType, count, ibFormat, (const void* const*)indices, multiDrawCount, baseVertices);
 
 		/*glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_NONE);
 		glBindBuffer(GL_ARRAY_BUFFER, GL_NONE);*/
@@ -1000,21 +1037,22 @@ namespace Aurora
 		m_FrameRenderStatistics.DrawCalls++;
 	}
 
-	void GLRenderDevice::DrawIndirect(const DrawCallState &state, const Buffer_ptr &indirectParams, uint32_t offsetBytes)
+	void GLRenderDevice::DrawIndirect(const DrawCallState &state, const Buffer_ptr &indirectParams, uint32_t offsetBytes, uint32_t drawCount)
 	{
 		CPU_DEBUG_SCOPE("DrawIndirect");
 
 		GLenum primitiveType = ConvertPrimType(state.PrimitiveType);
 		GLenum ibFormat = ConvertIndexBufferFormat(state.IndexBuffer.Format);
 
-		GLBuffer* indexbuff = GetBuffer(state.IndexBuffer.Buffer);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexbuff->Handle());
+		BindElementBuffer(GetBuffer(state.IndexBuffer.Buffer));
 
 		GLBuffer* ib = GetBuffer(indirectParams);
 		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, ib->Handle());
 		//glDrawElementsIndirect(primitiveType, ibFormat, nullptr);
 
-		glMultiDrawElementsIndirect(primitiveType, ibFormat, (const void*)0, offsetBytes, sizeof(DrawElementsIndirectCommand));
+		glMultiDrawElementsIndirect(primitiveType, ibFormat, BUFFER_OFFSET(offsetBytes), GLsizei(drawCount), sizeof(DrawElementsIndirectCommand));
+
+		m_FrameRenderStatistics.DrawCalls++;
 	}
 
 	void GLRenderDevice::ApplyDrawCallState(const DrawCallState &state)
@@ -1034,47 +1072,30 @@ namespace Aurora
 		ClearRenderTargets(state);
 	}
 
-	void GLRenderDevice::BindShaderInputsCached(const DrawCallState &state)
+	void GLRenderDevice::BindVertexArray(GLuint vao, GLuint elementBuffer)
 	{
-		auto glShader = GetShader(state.Shader);
-
-		if (
-				(glShader == nullptr && m_LastVao != m_nVAOEmpty) ||
-				(glShader != nullptr && glShader->GetInputVariables().empty()) ||
-				(state.InputLayoutHandle == nullptr))
+		if (vao != m_LastVao)
 		{
-			m_LastVao = m_nVAOEmpty;
-			glBindVertexArray(m_nVAOEmpty);
-			return;
+			m_LastVao = vao;
+			glBindVertexArray(vao);
 		}
 
-		VaoKey key = {
-			.Shader = state.Shader,
-			.Buffers = state.VertexBuffers
-		};
-
-		auto it = m_CachedVaos.find(key);
+		m_LastElementBuffer = elementBuffer;
+	}
 
-		// Find existing
-		if (it != m_CachedVaos.end())
+	void GLRenderDevice::BindElementBuffer(GLBuffer* buffer)
+	{
+		// The element buffer is part of the vertex array, cached arrays already have theirs
+		if (m_LastElementBuffer != buffer->Handle())
 		{
-			GLuint vao = it->second;
-
-			if (vao != m_LastVao)
-			{
-				m_LastVao = vao;
-				glBindVertexArray(vao);
-			}
-			return;
+			m_LastElementBuffer = buffer->Handle();
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer->Handle());
 		}
+	}
 
-		const auto& inputVars = glShader->GetInputVariables();
-
-		GLuint vao;
-		glGenVertexArrays(1, &vao);
-		glBindVertexArray(vao);
-
-		for (const auto& [location, inputVariable] : inputVars)
+	void GLRenderDevice::SpecifyVertexAttributes(GLShaderProgram* shader, const DrawCallState& state)
+	{
+		for (const auto& [location, inputVariable] : shader->GetInputVariables())
 		{
 			VertexAttributeDesc layoutAttribute;
 
@@ -1128,125 +1149,67 @@ namespace Aurora
 			glVertexAttribDivisor(location, layoutAttribute.IsInstanced ? 1 : 0);
 		}
 
-		m_CachedVaos[key] = vao;
+		//glBindBuffer(GL_ARRAY_BUFFER, GL_NONE); Do not do this, android render will fail !
 	}
 
 	void GLRenderDevice::BindShaderInputs(const DrawCallState &state, bool force)
 	{
-		/*if (true)
-		{
-		    // FIXME: Sometime the screen in black wher rotating camera
-			BindShaderInputsCached(state);
-			return;
-		}*/
-
 		auto glShader = GetShader(state.Shader);
-		const auto& inputVars = glShader->GetInputVariables();
 
-		if (inputVars.empty() || state.InputLayoutHandle == nullptr)
+		// Vertex arrays can be changed by GL calls outside of the device, force binds again
+		if (force)
 		{
-			if (m_LastVao != m_nVAOEmpty)
-			{
-				m_LastVao = m_nVAOEmpty;
-				glBindVertexArray(m_nVAOEmpty);
-			}
-			return;
+			m_LastVao = 0;
 		}
 
-		if (m_LastVao != m_nVAO)
+		if (glShader->GetInputVariables().empty() || state.InputLayoutHandle == nullptr)
 		{
-			m_LastVao = m_nVAO;
-			glBindVertexArray(m_nVAO);
-		}
-
-		if (state.InputLayoutHandle == m_LastInputLayout && !force)
+			BindVertexArray(m_nVAOEmpty, 0);
 			return;
-		m_LastInputLayout = state.InputLayoutHandle;
+		}
 
-		for (const auto& [location, inputVariable] : inputVars)
-		{
-			VertexAttributeDesc layoutAttribute;
+		VertexArrayKey key;
+		key.LayoutHash = state.InputLayoutHandle->GetHash();
+		HashCombine(key.LayoutHash, glShader->GetInputVariablesHash());
 
-			/*if (!state.InputLayoutHandle->GetDescriptorBySemanticID(location, layoutAttribute))
-			{
-				AU_LOG_FATAL("Input layout from DrawState is not supported by that in the shader !");
-				continue;
-			}*/
+		GLBuffer* indexBuffer = state.IndexBuffer.Buffer ? GetBuffer(state.IndexBuffer.Buffer) : nullptr;
+		key.IndexBuffer = indexBuffer ? indexBuffer->GetUniqueID() : 0;
 
-			if (!state.InputLayoutHandle->GetDescriptorByName(inputVariable.Name, layoutAttribute))
+		for (const auto& [slot, buffer] : state.VertexBuffers)
+		{
+			if (slot >= VertexArrayKey::MaxVertexBuffers)
 			{
-				//AU_LOG_FATAL("Input layout from DrawState is not supported by that in the shader (" , inputVariable.Name, ") !");
+				AU_LOG_ERROR("Vertex buffer slot ", slot, " is not supported !");
 				continue;
 			}
 
-			if (inputVariable.Format != layoutAttribute.Format)
-			{
-				AU_LOG_FATAL("Input descriptor format is not the same !");
-			};
-
-			const FormatMapping& formatMapping = GetFormatMapping(layoutAttribute.Format);
+			key.VertexBuffers[slot] = buffer ? GetBuffer(buffer)->GetUniqueID() : 0;
+		}
 
-			auto vertexBufferIt = state.VertexBuffers.find(layoutAttribute.BufferIndex);
-			auto glBuffer = GetBuffer(vertexBufferIt->second);
-			glBindBuffer(GL_ARRAY_BUFFER, glBuffer->Handle());
+		GLuint elementBuffer = indexBuffer ? indexBuffer->Handle() : 0;
 
-			glEnableVertexAttribArray(location);
+		auto it = m_CachedVaos.find(key);
 
-			if (formatMapping.Type == GL_INT || formatMapping.Type == GL_UNSIGNED_INT || formatMapping.Type == GL_UNSIGNED_SHORT || formatMapping.Type == GL_SHORT)
-			{
-				glVertexAttribIPointer(
-						location,
-						GLint(formatMapping.Components),
-						formatMapping.Type,
-						GLsizei(layoutAttribute.Stride),
-						(const void*)size_t(layoutAttribute.Offset));
-			}
-			else
-			{
-				glVertexAttribPointer(
-						location,
-						GLint(formatMapping.Components),
-						formatMapping.Type,
-						layoutAttribute.Normalized ? GL_TRUE : GL_FALSE,
-						GLsizei(layoutAttribute.Stride),
-						(const void*)size_t(layoutAttribute.Offset));
-			}
+		if (it != m_CachedVaos.end())
+		{
+			BindVertexArray(it->second, elementBuffer);
+			return;
+		}
 
-			m_FrameRenderStatistics.GPUMemoryUsage += formatMapping.Components * sizeof(float);
+		CPU_DEBUG_SCOPE("CreateVertexArray");
 
-			glVertexAttribDivisor(location, layoutAttribute.IsInstanced ? 1 : 0);
-		}
+		GLuint vao;
+		glGenVertexArrays(1, &vao);
+		BindVertexArray(vao, 0);
 
-		//glBindBuffer(GL_ARRAY_BUFFER, GL_NONE); Do not do this, android render will fail !
+		SpecifyVertexAttributes(glShader, state);
 
-		/*if (m_LastInputLayout != nullptr)
+		if (indexBuffer)
 		{
-			if (inputVars.size() == m_LastInputLayout->GetDescriptors().size())
-			{
-				return;
-			}
+			BindElementBuffer(indexBuffer);
 		}
 
-		static GLint nMaxVertexAttrs = 0;
-		if (nMaxVertexAttrs == 0)
-			glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &nMaxVertexAttrs);
-
-		for (auto semanticIndex = 0; semanticIndex < nMaxVertexAttrs; semanticIndex++)
-		{
-			bool foundSemantic = false;
-			for (const auto& var : inputVars)
-			{
-				if (semanticIndex == var.first)
-				{
-					foundSemantic = true;
-					break;
-				}
-			}
-			if (!foundSemantic)
-			{
-				glDisableVertexAttribArray(GLuint(semanticIndex));
-			}
-		}*/
+		m_CachedVaos[key] = vao;
 	}
 
 	void GLRenderDevice::Dispatch(const DispatchState &state, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
@@ -1277,14 +1240,8 @@ namespace Aurora
 	{
 		m_ContextState.Invalidate();
 
-		m_LastRasterState = FRasterState();
-		m_LastDepthState = FDepthStencilState();
-
-		m_LastRasterState.FillMode = EFillMode::Solid;
-		m_LastRasterState.CullMode = ECullMode::Front;
-		m_LastRasterState.DepthClipEnable = false;
-
-		m_LastDepthState.DepthEnable = false;
+		m_LastVao = 0;
+		m_LastElementBuffer = 0;
 	}
 
 	void GLRenderDevice::ApplyDispatchState(const DispatchState &state)
@@ -1303,17 +1260,7 @@ namespace Aurora
 
 		for (const auto& imageResource : shader->GetGLResource().GetSamplers())
 		{
-			auto boundTextureIt = state.BoundTextures.find(imageResource.Name);
-
-			const TextureBinding* targetTextureBinding = nullptr;
-
-			if (boundTextureIt == state.BoundTextures.end())
-			{
-				m_ContextState.BindTexture(imageResource.Binding, nullptr);
-				continue;
-			}
-
-			targetTextureBinding = &boundTextureIt->second;
+			const TextureBinding* targetTextureBinding = state.BoundTextures.Find(imageResource.NameID);
 
 			if (targetTextureBinding == nullptr)
 			{
@@ -1338,21 +1285,11 @@ namespace Aurora
 
 		for (const auto& imageResource : shader->GetGLResource().GetImages())
 		{
-			auto boundTextureIt = state.BoundTextures.find(imageResource.Name);
-
-			const TextureBinding* targetTextureBinding = nullptr;
-
-			if (boundTextureIt == state.BoundTextures.end())
-			{
-				m_ContextState.BindImage(imageResource.Binding, nullptr, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGB16F);
-				continue;
-			}
-
-			targetTextureBinding = &boundTextureIt->second;
+			const TextureBinding* targetTextureBinding = state.BoundTextures.Find(imageResource.NameID);
 
 			if (targetTextureBinding == nullptr)
 			{
-				// TODO: Set placeholder texture or throw error
+				m_ContextState.BindImage(imageResource.Binding, nullptr, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGB16F);
 				continue;
 			}
 
@@ -1386,26 +1323,20 @@ namespace Aurora
 		// TODO: Samplers
 		for(const auto& samplerResource : shader->GetGLResource().GetSamplers())
 		{
-			auto boundSamplerIt = state.BoundSamplers.find(samplerResource.Name);
-
-			Sampler_ptr targetSampler = nullptr;
+			const Sampler_ptr* targetSampler = state.BoundSamplers.Find(samplerResource.NameID);
 
-			if (boundSamplerIt != state.BoundSamplers.end()) {
-				targetSampler = boundSamplerIt->second;
-			}
-
-			m_ContextState.BindSampler(samplerResource.Binding, GetSampler(targetSampler));
+			m_ContextState.BindSampler(samplerResource.Binding, GetSampler(targetSampler ? *targetSampler : nullptr));
 		}
 
 		// binding constant buffers
 		for(const auto& uniformResource : shader->GetGLResource().GetUniformBlocks())
 		{
-			auto uniformBufferIt = state.BoundUniformBuffers.find(uniformResource.Name);
+			const BufferBinding* boundUniformBuffer = state.BoundUniformBuffers.Find(uniformResource.NameID);
 
 			BufferBinding uniformBinding;
 
-			if (uniformBufferIt != state.BoundUniformBuffers.end()) {
-				uniformBinding = uniformBufferIt->second;
+			if (boundUniformBuffer) {
+				uniformBinding = *boundUniformBuffer;
 			}
 
 			GLBuffer* glBuffer = nullptr;
@@ -1431,12 +1362,12 @@ namespace Aurora
 		// binding ssbo`s
 		for (const auto& uniformResource : shader->GetGLResource().GetStorageBlocks())
 		{
-			auto ssboIt = state.SSBOBuffers.find(uniformResource.Name);
+			const BufferBinding* boundSSBO = state.SSBOBuffers.Find(uniformResource.NameID);
 
 			BufferBinding ssboBinding;
 
-			if (ssboIt != state.SSBOBuffers.end()) {
-				ssboBinding = ssboIt->second;
+			if (boundSSBO) {
+				ssboBinding = *boundSSBO;
 			}
 
 			GLBuffer* glBuffer = nullptr;
@@ -1461,6 +1392,22 @@ namespace Aurora
 		ApplyShaderUniformResources(state.Shader, state.Uniforms);
 	}
 
+	void GLRenderDevice::BindStorageBlockRange(const BaseState& state, StrHashID nameID, const Buffer_ptr& buffer, uint32_t offset, uint32_t size)
+	{
+		if (state.Shader == nullptr) return;
+
+		auto shader = static_cast<GLShaderProgram*>(state.Shader.get()); // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+
+		for (const auto& storageResource : shader->GetGLResource().GetStorageBlocks())
+		{
+			if (storageResource.NameID != nameID)
+				continue;
+
+			m_ContextState.BindStorageBlock(storageResource.Binding, GetBuffer(buffer), offset, size);
+			return;
+		}
+	}
+
 	void GLRenderDevice::ApplyShaderUniformResources(const Shader_ptr& shader, const UniformResources& resources)
 	{
 		CPU_DEBUG_SCOPE("ApplyShaderUniformResources");
@@ -1755,175 +1702,29 @@ namespace Aurora
 
 	void GLRenderDevice::NotifyBufferDestroy(class GLBuffer* buffer)
 	{
-		std::vector<VaoKey> vaosToRemove;
-
-		for (const auto& [key, vao]: m_CachedVaos)
-		{
-			for (const auto& [location, cachedBuffer]: key.Buffers)
-			{
-				if (buffer == cachedBuffer.get())
-				{
-					vaosToRemove.push_back(key);
-					continue;
-				}
-			}
-		}
-
-		for (const auto& item: vaosToRemove)
-		{
-			m_CachedVaos.erase(item);
-		}
-	}
-
-	void GLRenderDevice::SetBlendState(const FBlendState& state)
-	{
-		if (state.AlphaToCoverage)
-		{
-			glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-		}
-
-		// TODO: Finish proper blending
-
-		if (state.Enabled)
-		{
-			glEnable(GL_BLEND);
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		}
-		else
-		{
-			glDisable(GL_BLEND);
-		}
-
-		/*for (uint32_t i = 0; i < targetCount; ++i)
-		{
-			if (blendState.blendEnable[i])
-				glEnablei(GL_BLEND, i);
-
-			uint32_t BlendOpRGB = convertBlendOp(blendState.blendOp[i]);
-			uint32_t BlendOpAlpha = convertBlendOp(blendState.blendOpAlpha[i]);
-			glBlendEquationSeparatei(i, BlendOpRGB, BlendOpAlpha);
-
-			uint32_t SrcBlendRGB = convertBlendValue(blendState.srcBlend[i]);
-			uint32_t DstBlendRGB = convertBlendValue(blendState.destBlend[i]);
-			uint32_t SrcBlendAlpha = convertBlendValue(blendState.srcBlendAlpha[i]);
-			uint32_t DstBlendAlpha = convertBlendValue(blendState.destBlendAlpha[i]);
-			glBlendFuncSeparatei(i, SrcBlendRGB, DstBlendRGB, SrcBlendAlpha, DstBlendAlpha);
-
-			glColorMaski(i,
-				(blendState.colorWriteEnable[i] & BlendState::COLOR_MASK_RED) != 0,
-				(blendState.colorWriteEnable[i] & BlendState::COLOR_MASK_GREEN) != 0,
-				(blendState.colorWriteEnable[i] & BlendState::COLOR_MASK_BLUE) != 0,
-				(blendState.colorWriteEnable[i] & BlendState::COLOR_MASK_ALPHA) != 0);
-		}*/
-	}
-
-	void GLRenderDevice::SetRasterState(const FRasterState& rasterState)
-	{
-		// FIXME: This do not works if some gl call from ImGui set some state, find a fix here!
-
-		if (m_LastRasterState.FillMode != rasterState.FillMode || true)
-		{
-			switch (rasterState.FillMode)
-			{
-				case EFillMode::Line:
-					glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-					break;
-				case EFillMode::Solid:
-					glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-					break;
+		UniqueIdentifier bufferID = buffer->GetUniqueID();
 
-				default:
-					AU_LOG_WARNING("Unknown fill mode specified");
-					break;
-			}
-			m_LastRasterState.FillMode = rasterState.FillMode;
-		}
-
-		if (m_LastRasterState.CullMode != rasterState.CullMode)
+		for (auto it = m_CachedVaos.begin(); it != m_CachedVaos.end();)
 		{
-			switch (rasterState.CullMode)
+			if (!it->first.UsesBuffer(bufferID))
 			{
-				case ECullMode::Back:
-					glCullFace(GL_BACK);
-					glEnable(GL_CULL_FACE);
-					break;
-				case ECullMode::Front:
-					glCullFace(GL_FRONT);
-					glEnable(GL_CULL_FACE);
-					break;
-				case ECullMode::None:
-					glDisable(GL_CULL_FACE);
-					break;
-				default:
-					AU_LOG_WARNING("Unknown cullMode");
-			}
-			m_LastRasterState.CullMode = rasterState.CullMode;
-		}
-
-		if (m_LastRasterState.FrontCounterClockwise != rasterState.FrontCounterClockwise || true)
-		{
-			glFrontFace(rasterState.FrontCounterClockwise ? GL_CCW : GL_CW);
-			m_LastRasterState.FrontCounterClockwise = rasterState.FrontCounterClockwise;
-		}
-
-		if (m_LastRasterState.DepthClipEnable)
-		{
-			if (rasterState.DepthClipEnable)
-			{
-				glEnable(GL_DEPTH_CLAMP);
-			}
-			else
-			{
-				glDisable(GL_DEPTH_CLAMP);
-			}
-			m_LastRasterState.DepthClipEnable = rasterState.DepthClipEnable;
-		}
-
-		if (m_LastRasterState.ScissorEnable != rasterState.ScissorEnable)
-		{
-			if (rasterState.ScissorEnable)
-			{
-				glEnable(GL_SCISSOR_TEST);
-			}
-			else
-			{
-				glDisable(GL_SCISSOR_TEST);
+				++it;
+				continue;
 			}
-			m_LastRasterState.ScissorEnable = rasterState.ScissorEnable;
-		}
 
-		if (m_LastRasterState.DepthBias != rasterState.DepthBias || m_LastRasterState.SlopeScaledDepthBias != rasterState.SlopeScaledDepthBias)
-		{
-			if (rasterState.DepthBias != 0 || rasterState.SlopeScaledDepthBias != 0.f)
+			if (it->second == m_LastVao)
 			{
-				glEnable(GL_POLYGON_OFFSET_FILL);
-				glPolygonOffset(rasterState.SlopeScaledDepthBias, float(rasterState.DepthBias));
+				BindVertexArray(m_nVAOEmpty, 0);
 			}
 
-			m_LastRasterState.DepthBias = rasterState.DepthBias;
-			m_LastRasterState.SlopeScaledDepthBias = rasterState.SlopeScaledDepthBias;
-		}
-
-		if (rasterState.MultisampleEnable != m_LastRasterState.MultisampleEnable)
-		{
-			m_LastRasterState.MultisampleEnable = rasterState.MultisampleEnable;
-
-			if (rasterState.MultisampleEnable)
-			{
-				glEnable(GL_MULTISAMPLE);
-				glSampleMaski(0, ~0u);
-				CHECK_GL_ERROR();
-			}
-			else
-			{
-				glDisable(GL_MULTISAMPLE);
-			}
+			glDeleteVertexArrays(1, &it->second);
+			it = m_CachedVaos.erase(it);
 		}
 
-		if (rasterState.LineWidth != m_LastRasterState.LineWidth)
+		// GL can hand the handle out again, so the bound element buffer is no longer known
+		if (m_LastElementBuffer == buffer->Handle())
 		{
-			m_LastRasterState.LineWidth = rasterState.LineWidth;
-			glLineWidth(rasterState.LineWidth);
+			m_LastElementBuffer = 0;
 		}
 	}
 
@@ -1954,63 +1755,51 @@ namespace Aurora
 		}
 	}
 
-	void GLRenderDevice::SetDepthStencilState(FDepthStencilState depthState)
+	void GLRenderDevice::SetBlendState(const FBlendState& state)
 	{
-		if (depthState.DepthEnable)
-		{
-			glEnable(GL_DEPTH_TEST);
-			glDepthMask((depthState.DepthWriteMask == EDepthWriteMask::All) ? GL_TRUE : GL_FALSE);
-			glDepthFunc(ConvertComparisonFunc(depthState.DepthFunc));
-		}
-		else
-		{
-			glDisable(GL_DEPTH_TEST);
-		}
+		m_ContextState.SetBlendState(state);
+	}
 
-		/*if (m_LastDepthState.DepthEnable != depthState.DepthEnable || m_LastDepthState.DepthWriteMask != depthState.DepthWriteMask || m_LastDepthState.DepthFunc != depthState.DepthFunc)
-		{
-			if (depthState.DepthEnable)
-			{
-				glEnable(GL_DEPTH_TEST);
-				glDepthMask((depthState.DepthWriteMask == EDepthWriteMask::All) ? GL_TRUE : GL_FALSE);
-				glDepthFunc(ConvertComparisonFunc(depthState.DepthFunc));
-			}
-			else
-			{
-				glDisable(GL_DEPTH_TEST);
-			}
+	void GLRenderDevice::SetRasterState(const FRasterState& rasterState)
+	{
+		m_ContextState.SetRasterState(rasterState);
+	}
 
-			m_LastDepthState.DepthEnable = depthState.DepthEnable;
-			m_LastDepthState.DepthWriteMask = depthState.DepthWriteMask;
-			m_LastDepthState.DepthFunc = depthState.DepthFunc;
-		}*/
+	void GLRenderDevice::SetDepthStencilState(FDepthStencilState state)
+	{
+		m_ContextState.SetDepthStencilState(state);
+	}
+
+	PipelineState_ptr GLRenderDevice::CreatePipelineState(const PipelineStateDesc& desc)
+	{
+		uint64_t hash = desc.Hash();
+		std::vector<std::weak_ptr<PipelineState>>& bucket = m_PipelineStates[hash];
 
-		if (m_LastDepthState.StencilEnable != depthState.StencilEnable)
+		for (size_t i = bucket.size(); i --> 0;)
 		{
-			//TODO: Other props needs to be checked too, but I think that we will never user stencil
+			PipelineState_ptr pipelineState = bucket[i].lock();
 
-			if (depthState.StencilEnable)
+			if (pipelineState == nullptr)
 			{
-				glEnable(GL_STENCIL_TEST);
+				bucket.erase(bucket.begin() + i);
+				continue;
+			}
 
-				glStencilFuncSeparate(GL_FRONT, ConvertComparisonFunc(depthState.FrontFace.StencilFunc), depthState.StencilRefValue, depthState.StencilReadMask);
-				glStencilOpSeparate(GL_FRONT, ConvertStencilOp(depthState.FrontFace.StencilFailOp),
-				                    ConvertStencilOp(depthState.FrontFace.StencilDepthFailOp),
-				                    ConvertStencilOp(depthState.FrontFace.StencilPassOp));
+			if (pipelineState->GetDesc() == desc)
+				return pipelineState;
+		}
 
-				glStencilFuncSeparate(GL_BACK, ConvertComparisonFunc(depthState.BackFace.StencilFunc), depthState.StencilRefValue, depthState.StencilReadMask);
-				glStencilOpSeparate(GL_BACK, ConvertStencilOp(depthState.BackFace.StencilFailOp),
-				                    ConvertStencilOp(depthState.BackFace.StencilDepthFailOp),
-				                    ConvertStencilOp(depthState.BackFace.StencilPassOp));
+		auto pipelineState = std::make_shared<PipelineState>(desc, m_NextPipelineStateID++);
+		bucket.emplace_back(pipelineState);
+		return pipelineState;
+	}
 
-				glStencilMask(depthState.StencilWriteMask);
-			}
-			else
-			{
-				glDisable(GL_STENCIL_TEST);
-			}
-			m_LastDepthState.StencilEnable = depthState.StencilEnable;
-		}
+	void GLRenderDevice::SetPipelineState(const PipelineState_ptr& pipelineState)
+	{
+		if (pipelineState == nullptr)
+			return;
+
+		m_ContextState.SetPipelineState(*pipelineState, GetShader(pipelineState->GetDesc().Shader));
 	}
 
 	void GLRenderDevice::Blit(const Texture_ptr &src, const Texture_ptr &dest)
@@ -2062,11 +1851,11 @@ namespace Aurora
 		// This not works on: Intel(R) UHD Graphics 630
 		/*SetShader(m_BlitShader);
 
-		FRasterState rasterState = m_LastRasterState;
+		FRasterState rasterState = m_ContextState.GetRasterState();
 		rasterState.CullMode = ECullMode::None;
 		SetRasterState(rasterState);
 
-		FDepthStencilState depthStencilState = m_LastDepthState;
+		FDepthStencilState depthStencilState = m_ContextState.GetDepthStencilState();
 		depthStencilState.DepthEnable = false;
 		SetDepthStencilState(depthStencilState);
 
@@ -2094,6 +1883,23 @@ namespace Aurora
 		CHECK_GL_ERROR();*/
 	}
 
+	void GLRenderDevice::CopyTextureLayer(const Texture_ptr& src, uint32_t srcLayer, const Texture_ptr& dest, uint32_t destLayer)
+	{
+		GPU_DEBUG_SCOPE("CopyTextureLayer");
+
+		au_assert(src != nullptr && dest != nullptr);
+		au_assert(src->GetDesc().Width == dest->GetDesc().Width && src->GetDesc().Height == dest->GetDesc().Height);
+
+		GLTexture* glSrc = GetTexture(src);
+		GLTexture* glDest = GetTexture(dest);
+
+		glCopyImageSubData(
+			glSrc->Handle(), glSrc->BindTarget(), 0, 0, 0, GLint(srcLayer),
+			glDest->Handle(), glDest->BindTarget(), 0, 0, 0, GLint(destLayer),
+			GLsizei(src->GetDesc().Width), GLsizei(src->GetDesc().Height), 1);
+		CHECK_GL_ERROR();
+	}
+
 	void GLRenderDevice::SetViewPort(const FViewPort &wp)
 	{
 		au_assert(wp.Width > 0);
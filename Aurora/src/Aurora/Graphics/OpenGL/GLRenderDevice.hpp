@@ -1,9 +1,13 @@
 #pragma once
 
 #include <vector>
+#include <array>
+#include <algorithm>
 #include "../Base/IRenderDevice.hpp"
 #include "GL.hpp"
 #include "GLContextState.hpp"
+#include "GLProgramCache.hpp"
+#include "Aurora/Core/Hash.hpp"
 #include "Aurora/Tools/robin_hood.h"
 
 namespace Aurora
@@ -64,47 +68,40 @@ namespace Aurora
 		{ return compare(other) == 0; }
 	};
 
-	struct VaoKey
+	// Everything a vertex array object captures, the layout hash covers both the input layout and the program inputs
+	struct VertexArrayKey
 	{
-		Shader_ptr Shader;
-		robin_hood::unordered_map<uint32_t, Buffer_ptr> Buffers;
+		static constexpr uint32_t MaxVertexBuffers = 4;
 
-		[[nodiscard]] int compare(const VaoKey &other) const
+		uint64_t LayoutHash = 0;
+		UniqueIdentifier IndexBuffer = 0;
+		std::array<UniqueIdentifier, MaxVertexBuffers> VertexBuffers{};
+
+		[[nodiscard]] bool UsesBuffer(UniqueIdentifier buffer) const
 		{
-			if (Shader < other.Shader) return -1;
-			if (Shader > other.Shader) return 1;
+			return IndexBuffer == buffer || std::find(VertexBuffers.begin(), VertexBuffers.end(), buffer) != VertexBuffers.end();
+		}
 
-			size_t bufferSize = Buffers.size();
+		bool operator==(const VertexArrayKey& other) const
+		{
+			return LayoutHash == other.LayoutHash && IndexBuffer == other.IndexBuffer && VertexBuffers == other.VertexBuffers;
+		}
+	};
 
-			if(bufferSize < other.Buffers.size()) return -1;
-			if(bufferSize > other.Buffers.size()) return 1;
+	struct VertexArrayKeyHasher
+	{
+		size_t operator()(const VertexArrayKey& key) const
+		{
+			uint64_t hash = key.LayoutHash;
+			HashCombine(hash, key.IndexBuffer);
 
-			for (const auto& [location, buffer]: Buffers)
+			for (UniqueIdentifier buffer : key.VertexBuffers)
 			{
-				auto it = other.Buffers.find(location);
-
-				if (it == other.Buffers.end())
-				{
-					return -1;
-				}
-
-				const Buffer_ptr bufferOther = it->second;
-
-				if (buffer < bufferOther) return -1;
-				if (buffer > bufferOther) return 1;
+				HashCombine(hash, buffer);
 			}
 
-			return 0;
+			return hash;
 		}
-
-		bool operator<(const VaoKey &other) const
-		{ return compare(other) < 0; }
-
-		bool operator>(const VaoKey &other) const
-		{ return compare(other) > 0; }
-
-		bool operator==(const VaoKey &other) const
-		{ return compare(other) == 0; }
 	};
 
 	class FrameBuffer
@@ -137,25 +134,29 @@ namespace Aurora
 		friend class GLTexture;
 		friend class ShellRenderInterfaceOpenGL;
 	private:
-		GLuint m_nVAO;
 		GLuint m_nVAOEmpty;
 		GLuint m_LastVao;
 		FrameBuffer_ptr m_CurrentFrameBuffer = nullptr;
 		std::map<FrameBufferKey, FrameBuffer_ptr> m_CachedFrameBuffers;
-		std::map<VaoKey, GLuint> m_CachedVaos;
+		robin_hood::unordered_map<VertexArrayKey, GLuint, VertexArrayKeyHasher> m_CachedVaos;
+		// Element buffer captured by the bound vertex array, zero when unknown
+		GLuint m_LastElementBuffer;
 
 		GLContextState m_ContextState;
+		// Created pipeline states by description hash, expired ones are dropped on lookup
+		robin_hood::unordered_map<uint64_t, std::vector<std::weak_ptr<PipelineState>>> m_PipelineStates;
+		uint32_t m_NextPipelineStateID;
 
 		FViewPort m_LastViewPort;
-		FRasterState m_LastRasterState;
-		FDepthStencilState m_LastDepthState;
-		InputLayout_ptr m_LastInputLayout;
-		std::vector<uint8_t> m_LastVertexAttribs;
 
 		// Embedded shaders
 		Shader_ptr m_BlitShader;
 
+		GLProgramCache m_ProgramCache;
+
 		EGpuVendor m_GpuVendor;
+		// GL_ARB_shader_draw_parameters, vertex shaders are compiled with SHADER_DRAW_PARAMETERS and can read gl_BaseInstanceARB
+		bool m_ShaderDrawParameters;
 	public:
 		GLRenderDevice();
 		~GLRenderDevice() override;
@@ -167,6 +168,9 @@ namespace Aurora
 		Shader_ptr CreateShaderProgram(const ShaderProgramDesc& desc) override;
 		static GLuint CompileShaderRaw(const std::string& sourceString, const EShaderType& shaderType, std::string* errorOutput);
 		void SetShader(const Shader_ptr& shader) override;
+		// Pipeline states
+		PipelineState_ptr CreatePipelineState(const PipelineStateDesc& desc) override;
+		void SetPipelineState(const PipelineState_ptr& pipelineState) override;
 		// Textures
 		Texture_ptr CreateTexture(const TextureDesc& desc, TextureData textureData) override;
 		void WriteTexture(const Texture_ptr &texture, uint32_t mipLevel, uint32_t subresource, const void *data) override;
@@ -190,7 +194,8 @@ namespace Aurora
 		// Drawing
 		void Draw(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState) override;
 		void DrawIndexed(const DrawCallState& state, const std::vector<DrawArguments>& args, bool bindState) override;
-		void DrawIndirect(const DrawCallState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes) override;
+		void DrawIndirect(const DrawCallState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes, uint32_t drawCount) override;
+		[[nodiscard]] bool IsMultiDrawIndirectSupported() const override { return m_ShaderDrawParameters; }
 
 		void Dispatch(const DispatchState& state, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
 		void DispatchIndirect(const DispatchState& state, const Buffer_ptr& indirectParams, uint32_t offsetBytes) override;
@@ -198,6 +203,7 @@ namespace Aurora
 		void InvalidateState() override;
 
 		void Blit(const Texture_ptr &src, const Texture_ptr &dest) override;
+		void CopyTextureLayer(const Texture_ptr& src, uint32_t srcLayer, const Texture_ptr& dest, uint32_t destLayer) override;
 
 		void SetViewPort(const FViewPort& wp) override;
 		[[nodiscard]] const FViewPort& GetCurrentViewPort() const override;
@@ -205,10 +211,10 @@ namespace Aurora
 		size_t GetUsedGPUMemory() override;
 	public:
 		void BindShaderResources(const BaseState& state) override;
+		void BindStorageBlockRange(const BaseState& state, StrHashID nameID, const Buffer_ptr& buffer, uint32_t offset, uint32_t size) override;
 		void ApplyShaderUniformResources(const Shader_ptr& shader, const UniformResources& resources) override;
 		void ApplyDispatchState(const DispatchState& state) override;
 		void ApplyDrawCallState(const DrawCallState& state) override;
-		void BindShaderInputsCached(const DrawCallState &state);
 		void BindShaderInputs(const DrawCallState &state, bool force) override;
 		void BindRenderTargets(const DrawCallState &state) override;
 		void SetBlendState(const FBlendState& state) override;
@@ -219,5 +225,9 @@ namespace Aurora
 		void NotifyTextureDestroy(class GLTexture* texture);
 		void NotifyBufferDestroy(class GLBuffer* buffer);
 		FrameBuffer_ptr GetCachedFrameBuffer(const DrawCallState &state);
+	private:
+		void BindVertexArray(GLuint vao, GLuint elementBuffer);
+		void BindElementBuffer(GLBuffer* buffer);
+		void SpecifyVertexAttributes(GLShaderProgram* shader, const DrawCallState& state);
 	};
 }
\ No newline at end of file
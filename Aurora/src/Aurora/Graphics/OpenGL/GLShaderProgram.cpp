@@ -5,11 +5,22 @@
 namespace Aurora
 {
 	GLShaderProgram::GLShaderProgram(GLuint handle, ShaderProgramDesc desc)
-	: m_Desc(std::move(desc)), m_Handle(handle), m_Resources(), m_HasInputLayout(false), m_InputVariables(), m_ConstantBufferDescriptorCacheInitialized(false), m_SamplerDescriptorCacheInitialized(false)
+	: m_Desc(std::move(desc)), m_Handle(handle), m_Resources(), m_HasInputLayout(false), m_InputVariables(), m_InputVariablesHash(0), m_ConstantBufferDescriptorCacheInitialized(false), m_SamplerDescriptorCacheInitialized(false)
 	{
 		//std::cout << "Loading uniforms for " << m_Desc.GetName() << std::endl;
 		m_Resources.LoadUniforms(m_Handle);
+		LoadInputVariables();
+	}
+
+	GLShaderProgram::GLShaderProgram(GLuint handle, ShaderProgramDesc desc, GLShaderResources resources)
+	: m_Desc(std::move(desc)), m_Handle(handle), m_Resources(std::move(resources)), m_HasInputLayout(false), m_InputVariables(), m_InputVariablesHash(0), m_ConstantBufferDescriptorCacheInitialized(false), m_SamplerDescriptorCacheInitialized(false)
+	{
+		m_Resources.ApplyBindings(m_Handle);
+		LoadInputVariables();
+	}
 
+	void GLShaderProgram::LoadInputVariables()
+	{
 		if(m_Desc.HasShader(EShaderType::Vertex)) { // Get input attributes
 			GLint attributeCount;
 			glGetProgramiv(m_Handle, GL_ACTIVE_ATTRIBUTES, &attributeCount);
@@ -81,6 +92,12 @@ namespace Aurora
 				m_HasInputLayout = true;
 				m_InputVariables = inputVariables;
 			}
+
+			for (const auto& [location, inputVariable] : m_InputVariables) {
+				HashCombine(m_InputVariablesHash, location);
+				HashCombine(m_InputVariablesHash, HashDjb2(inputVariable.Name));
+				HashCombine(m_InputVariablesHash, inputVariable.Format);
+			}
 		}
 	}
 
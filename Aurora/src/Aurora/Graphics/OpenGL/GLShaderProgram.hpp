@@ -16,6 +16,8 @@ namespace Aurora
 		GLShaderResources m_Resources;
 		bool m_HasInputLayout : 1;
 		ShaderInputVariables_t m_InputVariables;
+		// Locations, names and formats of the inputs, programs with equal hashes can share vertex arrays
+		uint64_t m_InputVariablesHash;
 
 		std::vector<ShaderResourceDesc> m_ConstantBufferDescriptorCache;
 		bool m_ConstantBufferDescriptorCacheInitialized;
@@ -24,8 +26,12 @@ namespace Aurora
 		bool m_SamplerDescriptorCacheInitialized;
 
 		robin_hood::unordered_map<StrHashID, GLint> m_UniformLocationCache;
+	private:
+		void LoadInputVariables();
 	public:
 		GLShaderProgram(GLuint handle, ShaderProgramDesc desc);
+		// Program loaded from a binary, its resources were reflected when it was first linked
+		GLShaderProgram(GLuint handle, ShaderProgramDesc desc, GLShaderResources resources);
 		~GLShaderProgram();
 	public:
 		[[nodiscard]] const ShaderProgramDesc& GetDesc() const override { return m_Desc; }
@@ -35,6 +41,7 @@ namespace Aurora
 		[[nodiscard]] inline uint8_t GetInputVariablesCount() const noexcept override { return m_InputVariables.size(); }
 		[[nodiscard]] inline const ShaderInputVariables_t& GetInputVariables() const noexcept override { return m_InputVariables; }
 	public:
+		[[nodiscard]] uint64_t GetInputVariablesHash() const noexcept { return m_InputVariablesHash; }
 		[[nodiscard]] GLuint Handle() const noexcept { return m_Handle; }
 		[[nodiscard]] const GLShaderResources& GetGLResource() const { return m_Resources; }
 
@@ -27,7 +27,8 @@ namespace Aurora
 	  m_UniformBlocks(),
 	  m_Samplers(),
 	  m_Images(),
-	  m_StorageBlocks()
+	  m_StorageBlocks(),
+	  m_BindingAssignments()
 	{
 
 	}
@@ -185,6 +186,7 @@ namespace Aurora
 
 						m_Samplers.push_back(
 							{*NamesPool.emplace(strName).first,
+							 HashDjb2(strName),
 							 ResourceType,
 							 m_SamplerBinding,
 							 static_cast<uint32_t>(size),
@@ -195,6 +197,7 @@ namespace Aurora
 						// glProgramUniform1i is not available in GLES3.0
 						glUniform1i(UniformLocation + arr_ind, m_SamplerBinding);
 						CHECK_GL_ERROR_ARG("Failed to set binding point for sampler uniform '", Name.data(), '\'');
+						m_BindingAssignments.push_back({GL_UNIFORM, UniformLocation + arr_ind, m_SamplerBinding});
 						m_SamplerBinding++;
 					}
 
@@ -254,6 +257,7 @@ namespace Aurora
 					m_Images.push_back(
 							{
 									*NamesPool.emplace(Name.data()).first,
+									HashDjb2(Name.data()),
 									ResourceType,
 									m_ImageBinding,
 									static_cast<uint32_t>(size),
@@ -267,6 +271,7 @@ namespace Aurora
 						// glUniform1i for image uniforms is not supported in at least GLES3.2.
 						// glProgramUniform1i is not available in GLES3.0
 						glUniform1i(UniformLocation + arr_ind, m_ImageBinding);
+						m_BindingAssignments.push_back({GL_UNIFORM, UniformLocation + arr_ind, m_ImageBinding});
 						if (glGetError() != GL_NO_ERROR)
 						{
 							if (size > 1)
@@ -319,7 +324,7 @@ namespace Aurora
 
 					if (uniformLocation >= 0)
 					{
-						m_Uniforms[HashDjb2(basicUniform.Name.c_str())] = {basicUniform.Name, ShaderResourceType::Uniform, 0, uint32_t(size), uniformLocation, glType.ComponentCount, glType.Size, GetGLVarType(dataType)};
+						m_Uniforms[HashDjb2(basicUniform.Name.c_str())] = {basicUniform.Name, HashDjb2(basicUniform.Name.c_str()), ShaderResourceType::Uniform, 0, uint32_t(size), uniformLocation, glType.ComponentCount, glType.Size, GetGLVarType(dataType)};
 					}
 
 					break;
@@ -461,6 +466,7 @@ namespace Aurora
 #endif
 				m_UniformBlocks.push_back({
 												*NamesPool.emplace(Name.data()).first,
+												HashDjb2(Name.data()),
 												ShaderResourceType::ConstantBuffer,
 												m_UniformBufferBinding,
 												static_cast<uint32_t>(ArraySize),
@@ -471,6 +477,7 @@ namespace Aurora
 										});
 			}
 
+			m_BindingAssignments.push_back({GL_UNIFORM_BLOCK, static_cast<GLint>(UniformBlockIndex), m_UniformBufferBinding});
 			glUniformBlockBinding(program, UniformBlockIndex, m_UniformBufferBinding++);
 			CHECK_GL_ERROR_ARG("glUniformBlockBinding() failed");
 		}
@@ -521,6 +528,7 @@ namespace Aurora
 			{
 				m_StorageBlocks.push_back({
 												*NamesPool.emplace(Name.data()).first,
+												HashDjb2(Name.data()),
 												ShaderResourceType::BufferUAV,
 												m_StorageBufferBinding,
 												static_cast<uint32_t>(ArraySize),
@@ -532,6 +540,7 @@ namespace Aurora
 			{
 				glShaderStorageBlockBinding(program, SBIndex, m_StorageBufferBinding);
 				CHECK_GL_ERROR_ARG("glShaderStorageBlockBinding() failed");
+				m_BindingAssignments.push_back({GL_SHADER_STORAGE_BLOCK, static_cast<GLint>(SBIndex), m_StorageBufferBinding});
 			}
 			else
 			{
@@ -549,4 +558,196 @@ namespace Aurora
 
 		glUseProgram(lastUsedProgramID);
 	}
+
+	void GLShaderResources::ApplyBindings(GLuint program) const
+	{
+		GLint lastUsedProgramID = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &lastUsedProgramID);
+
+		glUseProgram(program);
+		CHECK_GL_ERROR_AND_THROW("Unable to use program");
+
+		for (const GLBindingAssignment& assignment : m_BindingAssignments)
+		{
+			switch (assignment.Interface)
+			{
+				case GL_UNIFORM:
+					glUniform1i(assignment.Index, static_cast<GLint>(assignment.Binding));
+					// Images may fail here the same way they did in LoadUniforms, which already warned about it
+					glGetError();
+					break;
+				case GL_UNIFORM_BLOCK:
+					glUniformBlockBinding(program, assignment.Index, assignment.Binding);
+					CHECK_GL_ERROR_ARG("glUniformBlockBinding() failed");
+					break;
+				case GL_SHADER_STORAGE_BLOCK:
+					glShaderStorageBlockBinding(program, assignment.Index, assignment.Binding);
+					CHECK_GL_ERROR_ARG("glShaderStorageBlockBinding() failed");
+					break;
+				default:
+					break;
+			}
+		}
+
+		glUseProgram(lastUsedProgramID);
+	}
+
+	static void SerializeAttribs(Archive& archive, const GLResourceAttribs& attribs)
+	{
+		archive << attribs.Name;
+		archive << attribs.NameID;
+		archive << static_cast<uint32_t>(attribs.ResourceType);
+		archive << attribs.Binding;
+		archive << attribs.ArraySize;
+	}
+
+	static void DeserializeAttribs(Archive& archive, GLResourceAttribs& attribs)
+	{
+		attribs.Name.clear();
+		archive >> attribs.Name;
+		archive >> attribs.NameID;
+		attribs.ResourceType = static_cast<ShaderResourceType>(archive.Read<uint32_t>());
+		archive >> attribs.Binding;
+		archive >> attribs.ArraySize;
+	}
+
+	void GLShaderResources::Serialize(Archive& archive) const
+	{
+		archive << m_UniformBufferBinding;
+		archive << m_SamplerBinding;
+		archive << m_ImageBinding;
+		archive << m_StorageBufferBinding;
+
+		archive << static_cast<uint32_t>(m_UniformBlocks.size());
+		for (const UniformBufferInfo& block : m_UniformBlocks)
+		{
+			SerializeAttribs(archive, block);
+			archive << block.UBIndex;
+			archive << static_cast<uint8_t>(block.ShadersIn);
+			archive << static_cast<uint64_t>(block.Size);
+
+			archive << static_cast<uint32_t>(block.Variables.size());
+			for (const ShaderVariable& variable : block.Variables)
+			{
+				archive << variable.Name;
+				archive << static_cast<uint64_t>(variable.Size);
+				archive << static_cast<uint64_t>(variable.Offset);
+				archive << static_cast<uint64_t>(variable.ArrayStride);
+				archive << static_cast<uint64_t>(variable.MatrixStride);
+			}
+		}
+
+		archive << static_cast<uint32_t>(m_Uniforms.size());
+		for (const auto& [nameID, uniform] : m_Uniforms)
+		{
+			SerializeAttribs(archive, uniform);
+			archive << uniform.Location;
+			archive << uniform.ComponentCount;
+			archive << static_cast<uint64_t>(uniform.Size);
+			archive << static_cast<uint8_t>(uniform.Type);
+		}
+
+		archive << static_cast<uint32_t>(m_Samplers.size());
+		for (const SamplerInfo& sampler : m_Samplers)
+		{
+			SerializeAttribs(archive, sampler);
+			archive << sampler.Location;
+			archive << sampler.SamplerType;
+		}
+
+		archive << static_cast<uint32_t>(m_Images.size());
+		for (const ImageInfo& image : m_Images)
+		{
+			SerializeAttribs(archive, image);
+			archive << image.Location;
+			archive << image.ImageType;
+		}
+
+		archive << static_cast<uint32_t>(m_StorageBlocks.size());
+		for (const StorageBlockInfo& block : m_StorageBlocks)
+		{
+			SerializeAttribs(archive, block);
+			archive << block.SBIndex;
+		}
+
+		archive << static_cast<uint32_t>(m_BindingAssignments.size());
+		for (const GLBindingAssignment& assignment : m_BindingAssignments)
+		{
+			archive << assignment.Interface;
+			archive << assignment.Index;
+			archive << assignment.Binding;
+		}
+	}
+
+	void GLShaderResources::Deserialize(Archive& archive)
+	{
+		archive >> m_UniformBufferBinding;
+		archive >> m_SamplerBinding;
+		archive >> m_ImageBinding;
+		archive >> m_StorageBufferBinding;
+
+		m_UniformBlocks.resize(archive.Read<uint32_t>());
+		for (UniformBufferInfo& block : m_UniformBlocks)
+		{
+			DeserializeAttribs(archive, block);
+			archive >> block.UBIndex;
+			block.ShadersIn = static_cast<EShaderType>(archive.Read<uint8_t>());
+			block.Size = archive.Read<uint64_t>();
+
+			block.Variables.resize(archive.Read<uint32_t>());
+			for (ShaderVariable& variable : block.Variables)
+			{
+				archive >> variable.Name;
+				variable.Size = archive.Read<uint64_t>();
+				variable.Offset = archive.Read<uint64_t>();
+				variable.ArrayStride = archive.Read<uint64_t>();
+				variable.MatrixStride = archive.Read<uint64_t>();
+			}
+		}
+
+		m_Uniforms.clear();
+		uint32_t uniformCount = archive.Read<uint32_t>();
+		for (uint32_t i = 0; i < uniformCount; ++i)
+		{
+			UniformInfo uniform;
+			DeserializeAttribs(archive, uniform);
+			archive >> uniform.Location;
+			archive >> uniform.ComponentCount;
+			uniform.Size = archive.Read<uint64_t>();
+			uniform.Type = static_cast<VarType>(archive.Read<uint8_t>());
+
+			m_Uniforms[uniform.NameID] = uniform;
+		}
+
+		m_Samplers.resize(archive.Read<uint32_t>());
+		for (SamplerInfo& sampler : m_Samplers)
+		{
+			DeserializeAttribs(archive, sampler);
+			archive >> sampler.Location;
+			archive >> sampler.SamplerType;
+		}
+
+		m_Images.resize(archive.Read<uint32_t>());
+		for (ImageInfo& image : m_Images)
+		{
+			DeserializeAttribs(archive, image);
+			archive >> image.Location;
+			archive >> image.ImageType;
+		}
+
+		m_StorageBlocks.resize(archive.Read<uint32_t>());
+		for (StorageBlockInfo& block : m_StorageBlocks)
+		{
+			DeserializeAttribs(archive, block);
+			archive >> block.SBIndex;
+		}
+
+		m_BindingAssignments.resize(archive.Read<uint32_t>());
+		for (GLBindingAssignment& assignment : m_BindingAssignments)
+		{
+			archive >> assignment.Interface;
+			archive >> assignment.Index;
+			archive >> assignment.Binding;
+		}
+	}
 }
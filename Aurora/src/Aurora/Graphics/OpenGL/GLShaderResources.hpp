@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "Aurora/Core/Hash.hpp"
+#include "Aurora/Core/Archive.hpp"
 #include "Aurora/Core/Map.hpp"
 #include "Aurora/Tools/robin_hood.h"
 #include "../Base/ShaderBase.hpp"
@@ -18,6 +19,8 @@ namespace Aurora
 	struct GLResourceAttribs
 	{
 		std::string Name = "Unknown";
+		// Hash of Name, states bind resources by it
+		StrHashID NameID = 0;
 		ShaderResourceType ResourceType = ShaderResourceType::Unknown;
 		uint32_t Binding = 0;
 		uint32_t ArraySize = 0;
@@ -56,6 +59,16 @@ namespace Aurora
 		GLuint SBIndex = 0;
 	};
 
+	// Binding point assigned to a program resource, program binaries do not keep them
+	struct GLBindingAssignment
+	{
+		// GL_UNIFORM for samplers and images, GL_UNIFORM_BLOCK or GL_SHADER_STORAGE_BLOCK
+		GLenum Interface;
+		// Uniform location or block index
+		GLint Index;
+		GLuint Binding;
+	};
+
 	class AU_API GLShaderResources
 	{
 	private:
@@ -69,10 +82,17 @@ namespace Aurora
 		std::vector<SamplerInfo>       m_Samplers;
 		std::vector<ImageInfo>         m_Images;
 		std::vector<StorageBlockInfo>  m_StorageBlocks;
+
+		std::vector<GLBindingAssignment> m_BindingAssignments;
 	public:
 		GLShaderResources();
 
 		void LoadUniforms(GLuint program);
+		// Assigns the binding points found by LoadUniforms again, used for programs loaded from a binary
+		void ApplyBindings(GLuint program) const;
+
+		void Serialize(Archive& archive) const;
+		void Deserialize(Archive& archive);
 
 		[[nodiscard]] inline const std::vector<UniformBufferInfo>& GetUniformBlocks() const noexcept { return m_UniformBlocks; }
 		[[nodiscard]] inline const FastMap<StrHashID, UniformInfo>& GetUniforms() const noexcept { return m_Uniforms; }
@@ -27,7 +27,7 @@ namespace Aurora
 
 	RenderManager::RenderManager(IRenderDevice *renderDevice)
 	: m_RenderDevice(renderDevice),
-	m_UniformBufferCache(m_RenderDevice, EBufferType::UniformBuffer, 3, 65536 * 3, false) // We don't use GPU mapped memory because on OpenGL is too slow...
+	m_UniformBufferCache(m_RenderDevice, EBufferType::UniformBuffer, 3 * 1024 * 1024) // Room for about three frames of uniforms
 	{
 		{
 			ShaderProgramDesc desc("Blit");
@@ -314,6 +314,28 @@ namespace Aurora
 		m_RenderDevice->Blit(src, dest);
 	}
 
+	GPUBufferHeap& RenderManager::GetMeshVertexHeap(uint32_t stride)
+	{
+		std::unique_ptr<GPUBufferHeap>& heap = m_MeshVertexHeaps[stride];
+
+		if (!heap)
+		{
+			heap = std::make_unique<GPUBufferHeap>(m_RenderDevice, "Mesh Vertex Heap " + std::to_string(stride), EBufferType::VertexBuffer, stride, 64 * 1024 * 1024);
+		}
+
+		return *heap;
+	}
+
+	GPUBufferHeap& RenderManager::GetMeshIndexHeap()
+	{
+		if (!m_MeshIndexHeap)
+		{
+			m_MeshIndexHeap = std::make_unique<GPUBufferHeap>(m_RenderDevice, "Mesh Index Heap", EBufferType::IndexBuffer, sizeof(uint32_t), 32 * 1024 * 1024);
+		}
+
+		return *m_MeshIndexHeap;
+	}
+
 	void RenderManager::EndFrame()
 	{
 		double currentTime = GetTimeInSeconds();
@@ -340,7 +362,6 @@ namespace Aurora
 			AU_LOG_WARNING("Temporal render target count exceeded 50, are you sure you are not doing something wrong ?");
 		}
 
-		m_UniformBufferCache.Reset();
 		m_UniformBufferCache.OnFrameEnd();
 	}
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "Base/Sampler.hpp"
 #include "Base/Buffer.hpp"
 #include "BufferCache.hpp"
+#include "GPUBufferHeap.hpp"
 
 namespace Aurora
 {
@@ -138,6 +139,10 @@ namespace Aurora
 		std::vector<TemporalRenderTargetStorage> m_TemporalRenderTargets;
 
 		BufferCache m_UniformBufferCache;
+
+		// Static mesh data is sub-allocated from shared buffers, vertex heaps are split by stride so offsets stay in vertices
+		robin_hood::unordered_map<uint32_t, std::unique_ptr<GPUBufferHeap>> m_MeshVertexHeaps;
+		std::unique_ptr<GPUBufferHeap> m_MeshIndexHeap;
 	public:
 		explicit RenderManager(IRenderDevice *renderDevice);
 
@@ -173,12 +178,14 @@ namespace Aurora
 			Blit(src, nullptr);
 		}
 
-		// Not used for now
 		BufferCache &GetUniformBufferCache()
 		{
 			return m_UniformBufferCache;
 		}
 
+		GPUBufferHeap& GetMeshVertexHeap(uint32_t stride);
+		GPUBufferHeap& GetMeshIndexHeap();
+
 		void EndFrame();
 	};
 
@@ -117,7 +117,7 @@ namespace Aurora
 			corners[7] = m_Max;
 
 			auto min = Vector3(std::numeric_limits<float>::max());
-			auto max = Vector3(std::numeric_limits<float>::min());
+			auto max = Vector3(std::numeric_limits<float>::lowest());
 
 			for(auto & corner : corners) {
 				Vector4 transformed = matrix * Vector4(corner, 1.0);
@@ -35,6 +35,7 @@ namespace Aurora
 		}
 	};
 
+	// The tree is not rebalanced so its depth is not bounded, traversals keep their stack growable
 	template<typename T>
 	class AABBTree
 	{
@@ -86,6 +87,42 @@ namespace Aurora
 			UpdateLeaf(nodeIndex, aabb);
 		}
 
+		[[nodiscard]] bool ContainsObject(T* Object) const { return _objectNodeIndexMap.find(Object) != _objectNodeIndexMap.end(); }
+		[[nodiscard]] const AABB& GetObjectAABB(T* Object) const { return _nodes[_objectNodeIndexMap.at(Object)].aabb; }
+
+		// Depth first walk carrying a state from parents to children. enter(aabb, parentState, state) fills the state of the node
+		// and returns false to skip its subtree, leaf(object, state) is called for every entered leaf.
+		template<typename State, typename Enter, typename Leaf>
+		void Traverse(const State& rootState, Enter&& enter, Leaf&& leaf) const
+		{
+			if (_rootNodeIndex == AABB_NULL_NODE) return;
+
+			std::vector<std::pair<unsigned, State>> stack;
+			stack.reserve(64);
+			stack.emplace_back(_rootNodeIndex, rootState);
+
+			while (!stack.empty())
+			{
+				const auto [nodeIndex, parentState] = stack.back();
+				stack.pop_back();
+
+				const AABBNode<T>& node = _nodes[nodeIndex];
+				State state;
+
+				if (!enter(node.aabb, parentState, state)) continue;
+
+				if (node.IsLeaf())
+				{
+					leaf(node.Object, state);
+				}
+				else
+				{
+					stack.emplace_back(node.leftNodeIndex, state);
+					stack.emplace_back(node.rightNodeIndex, state);
+				}
+			}
+		}
+
 		std::forward_list<T*> QueryOverlaps(T* Object, const AABB& aabb) const
 		{
 			std::forward_list<T*> overlaps;
@@ -117,14 +154,98 @@ namespace Aurora
 
 			return overlaps;
 		}
+
+		// Appends every leaf object whose bounds overlap the aabb, without allocating per node
+		void QueryOverlaps(const AABB& aabb, std::vector<T*>& objects) const
+		{
+			if (_rootNodeIndex == AABB_NULL_NODE) return;
+
+			std::vector<unsigned> stack;
+			stack.reserve(64);
+			stack.push_back(_rootNodeIndex);
+
+			while (!stack.empty())
+			{
+				const AABBNode<T>& node = _nodes[stack.back()];
+				stack.pop_back();
+
+				if (!node.aabb.Overlaps(aabb)) continue;
+
+				if (node.IsLeaf())
+				{
+					objects.push_back(node.Object);
+				}
+				else
+				{
+					stack.push_back(node.leftNodeIndex);
+					stack.push_back(node.rightNodeIndex);
+				}
+			}
+		}
+
+		// Appends every leaf object whose bounds, grown by halfExtent, are crossed by the segment origin + direction * [0, maxDistance].
+		// Growing the nodes instead of the query keeps the swept volume tight for sphere, capsule and box casts.
+		void QuerySweep(const Vector3& origin, const Vector3& direction, float maxDistance, const Vector3& halfExtent, std::vector<T*>& objects) const
+		{
+			if (_rootNodeIndex == AABB_NULL_NODE) return;
+
+			std::vector<unsigned> stack;
+			stack.reserve(64);
+			stack.push_back(_rootNodeIndex);
+
+			while (!stack.empty())
+			{
+				const AABBNode<T>& node = _nodes[stack.back()];
+				stack.pop_back();
+
+				if (!SegmentOverlaps(node.aabb.GetMin() - halfExtent, node.aabb.GetMax() + halfExtent, origin, direction, maxDistance)) continue;
+
+				if (node.IsLeaf())
+				{
+					objects.push_back(node.Object);
+				}
+				else
+				{
+					stack.push_back(node.leftNodeIndex);
+					stack.push_back(node.rightNodeIndex);
+				}
+			}
+		}
 	private:
+		static bool SegmentOverlaps(const Vector3& min, const Vector3& max, const Vector3& origin, const Vector3& direction, float maxDistance)
+		{
+			float tEnter = 0.0f;
+			float tExit = maxDistance;
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				if (std::abs(direction[axis]) < 1e-8f)
+				{
+					if (origin[axis] < min[axis] || origin[axis] > max[axis]) return false;
+					continue;
+				}
+
+				float invDirection = 1.0f / direction[axis];
+				float t0 = (min[axis] - origin[axis]) * invDirection;
+				float t1 = (max[axis] - origin[axis]) * invDirection;
+
+				if (t0 > t1) std::swap(t0, t1);
+
+				tEnter = std::max(tEnter, t0);
+				tExit = std::min(tExit, t1);
+
+				if (tEnter > tExit) return false;
+			}
+
+			return true;
+		}
+
 		unsigned allocateNode()
 		{
 			// if we have no free tree nodes then grow the pool
 			if (_nextFreeNodeIndex == AABB_NULL_NODE)
 			{
-				// FIXME: This does not work correctly
-
+				// Growing moves the nodes, callers must not hold node references across allocateNode
 				assert(_allocatedNodeCount == _nodeCapacity);
 
 				_nodeCapacity += _growthSize;
@@ -174,7 +295,7 @@ namespace Aurora
 			// search for the best place to put the new leaf in the tree
 			// we use surface area and depth as search heuristics
 			unsigned treeNodeIndex = _rootNodeIndex;
-			AABBNode<T>& leafNode = _nodes[leafNodeIndex];
+			const AABB leafAabb = _nodes[leafNodeIndex].aabb;
 			while (!_nodes[treeNodeIndex].IsLeaf())
 			{
 				// because of the test in the while loop above we know we are never a leaf inside it
@@ -184,7 +305,7 @@ namespace Aurora
 				const AABBNode<T>& leftNode = _nodes[leftNodeIndex];
 				const AABBNode<T>& rightNode = _nodes[rightNodeIndex];
 
-				AABB combinedAabb = treeNode.aabb.Merge(leafNode.aabb);
+				AABB combinedAabb = treeNode.aabb.Merge(leafAabb);
 
 				float newParentNodeCost = 2.0f * combinedAabb.GetSurfaceArea();
 				float minimumPushDownCost = 2.0f * (combinedAabb.GetSurfaceArea() - treeNode.aabb.GetSurfaceArea());
@@ -194,20 +315,20 @@ namespace Aurora
 				float costRight;
 				if (leftNode.IsLeaf())
 				{
-					costLeft = leafNode.aabb.Merge(leftNode.aabb).GetSurfaceArea() + minimumPushDownCost;
+					costLeft = leafAabb.Merge(leftNode.aabb).GetSurfaceArea() + minimumPushDownCost;
 				}
 				else
 				{
-					AABB newLeftAabb = leafNode.aabb.Merge(leftNode.aabb);
+					AABB newLeftAabb = leafAabb.Merge(leftNode.aabb);
 					costLeft = (newLeftAabb.GetSurfaceArea() - leftNode.aabb.GetSurfaceArea()) + minimumPushDownCost;
 				}
 				if (rightNode.IsLeaf())
 				{
-					costRight = leafNode.aabb.Merge(rightNode.aabb).GetSurfaceArea() + minimumPushDownCost;
+					costRight = leafAabb.Merge(rightNode.aabb).GetSurfaceArea() + minimumPushDownCost;
 				}
 				else
 				{
-					AABB newRightAabb = leafNode.aabb.Merge(rightNode.aabb);
+					AABB newRightAabb = leafAabb.Merge(rightNode.aabb);
 					costRight = (newRightAabb.GetSurfaceArea() - rightNode.aabb.GetSurfaceArea()) + minimumPushDownCost;
 				}
 
@@ -232,9 +353,10 @@ namespace Aurora
 			// the leafs sibling is going to be the node we found above and we are going to create a new
 			// parent node and attach the leaf and this item
 			unsigned leafSiblingIndex = treeNodeIndex;
-			AABBNode<T>& leafSibling = _nodes[leafSiblingIndex];
-			unsigned oldParentIndex = leafSibling.parentNodeIndex;
+			unsigned oldParentIndex = _nodes[leafSiblingIndex].parentNodeIndex;
 			unsigned newParentIndex = allocateNode();
+			AABBNode<T>& leafNode = _nodes[leafNodeIndex];
+			AABBNode<T>& leafSibling = _nodes[leafSiblingIndex];
 			AABBNode<T>& newParent = _nodes[newParentIndex];
 			newParent.parentNodeIndex = oldParentIndex;
 			newParent.aabb = leafNode.aabb.Merge(leafSibling.aabb); // the new parents aabb is the leaf aabb combined with it's siblings aabb
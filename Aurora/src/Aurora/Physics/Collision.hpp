@@ -10,7 +10,8 @@ namespace Aurora
 {
 	namespace BroadPhase
 	{
-		static bool FromAABB(BoxColliderComponent* current, const AABBTree<ColliderComponent>& bvhTree, Vector3& velocity, bool* axes, double updateRate)
+		// Resolves velocity per axis against the colliders touched by the swept bounds, with proxiesOnly set the box colliders are left to the continuous sweep
+		static bool FromAABB(BoxColliderComponent* current, const AABBTree<ColliderComponent>& bvhTree, Vector3& velocity, bool* axes, double updateRate, bool proxiesOnly = false)
 		{
 			AABB currentBounds = current->GetTransformedAABB();
 
@@ -51,6 +52,10 @@ namespace Aurora
 							continue;
 						}
 					}
+					else if (proxiesOnly)
+					{
+						continue;
+					}
 
 					//DShapes::Box(collisionObject->GetTransformedAABB() * 1.1f, Color::green(), true, 1.0f);
 
@@ -74,4 +79,286 @@ namespace Aurora
 			return collision;
 		}
 	}
+
+	// Swept and static shape tests against axis aligned boxes, directions are expected to be normalized
+	namespace NarrowPhase
+	{
+		// Ray vs box slab test, returns the entry distance and the face normal that was crossed
+		static bool SweepRayAABB(const Vector3& origin, const Vector3& direction, float maxDistance, const Vector3& min, const Vector3& max, float& distance, Vector3& normal)
+		{
+			float tEnter = 0.0f;
+			float tExit = maxDistance;
+			int enterAxis = -1;
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				if (glm::abs(direction[axis]) < glm::epsilon<float>())
+				{
+					if (origin[axis] < min[axis] || origin[axis] > max[axis])
+						return false;
+					continue;
+				}
+
+				float invDirection = 1.0f / direction[axis];
+				float t0 = (min[axis] - origin[axis]) * invDirection;
+				float t1 = (max[axis] - origin[axis]) * invDirection;
+
+				if (t0 > t1) std::swap(t0, t1);
+
+				if (t0 > tEnter)
+				{
+					tEnter = t0;
+					enterAxis = axis;
+				}
+
+				tExit = std::min(tExit, t1);
+
+				if (tEnter > tExit)
+					return false;
+			}
+
+			distance = tEnter;
+			normal = {0, 0, 0};
+
+			if (enterAxis >= 0)
+				normal[enterAxis] = -glm::sign(direction[enterAxis]);
+			else // Started inside
+				normal = -direction;
+
+			return true;
+		}
+
+		static bool SweepRaySphere(const Vector3& origin, const Vector3& direction, float maxDistance, const Vector3& center, float radius, float& distance)
+		{
+			Vector3 m = origin - center;
+			float b = glm::dot(m, direction);
+			float c = glm::dot(m, m) - radius * radius;
+
+			if (c > 0.0f && b > 0.0f)
+				return false;
+
+			float discriminant = b * b - c;
+
+			if (discriminant < 0.0f)
+				return false;
+
+			distance = std::max(-b - glm::sqrt(discriminant), 0.0f);
+			return distance <= maxDistance;
+		}
+
+		// Ray vs finite cylinder aligned with the given axis, caps are not tested because the rounded box covers them with spheres and slabs
+		static bool SweepRayAxisCylinder(const Vector3& origin, const Vector3& direction, float maxDistance, const Vector3& axisPoint, uint8_t axis, float axisMin, float axisMax, float radius, float& distance)
+		{
+			uint8_t u = (axis + 1) % 3;
+			uint8_t v = (axis + 2) % 3;
+
+			Vector2 d(direction[u], direction[v]);
+			Vector2 m(origin[u] - axisPoint[u], origin[v] - axisPoint[v]);
+
+			float a = glm::dot(d, d);
+
+			if (a < glm::epsilon<float>())
+				return false;
+
+			float b = glm::dot(m, d);
+			float c = glm::dot(m, m) - radius * radius;
+			float discriminant = b * b - a * c;
+
+			if (discriminant < 0.0f)
+				return false;
+
+			float t = (-b - glm::sqrt(discriminant)) / a;
+
+			if (t < 0.0f || t > maxDistance)
+				return false;
+
+			float axisPosition = origin[axis] + direction[axis] * t;
+
+			if (axisPosition < axisMin || axisPosition > axisMax)
+				return false;
+
+			distance = t;
+			return true;
+		}
+
+		static bool OverlapSphereAABB(const Vector3& center, float radius, const AABB& box)
+		{
+			Vector3 closest = glm::clamp(center, box.GetMin(), box.GetMax());
+			return glm::length2(center - closest) <= radius * radius;
+		}
+
+		static bool OverlapAABBAABB(const Vector3& center, const Vector3& halfExtent, const AABB& box)
+		{
+			return box.IntersectsWith(AABB(center - halfExtent, center + halfExtent));
+		}
+
+		static bool SweepBoxAABB(const Vector3& center, const Vector3& halfExtent, const Vector3& direction, float maxDistance, const AABB& box, float& distance, Vector3& normal)
+		{
+			// Minkowski sum of two boxes is a box, so this is a plain ray test
+			return SweepRayAABB(center, direction, maxDistance, box.GetMin() - halfExtent, box.GetMax() + halfExtent, distance, normal);
+		}
+
+		// Exact sphere sweep: the ray is tested against the box rounded by the radius,
+		// which is the union of three face slabs, twelve edge cylinders and eight corner spheres
+		static bool SweepSphereAABB(const Vector3& center, float radius, const Vector3& direction, float maxDistance, const AABB& box, float& distance, Vector3& normal)
+		{
+			const Vector3& min = box.GetMin();
+			const Vector3& max = box.GetMax();
+
+			if (OverlapSphereAABB(center, radius, box))
+			{
+				Vector3 closest = glm::clamp(center, min, max);
+				Vector3 away = center - closest;
+
+				distance = 0.0f;
+				normal = glm::length2(away) > 0.0f ? glm::normalize(away) : -direction;
+				return true;
+			}
+
+			bool hit = false;
+			float best = maxDistance;
+			float t;
+			Vector3 slabNormal;
+
+			for (uint8_t axis = 0; axis < 3; ++axis)
+			{
+				Vector3 expand(0.0f);
+				expand[axis] = radius;
+
+				if (SweepRayAABB(center, direction, best, min - expand, max + expand, t, slabNormal) && t <= best)
+				{
+					best = t;
+					normal = slabNormal;
+					hit = true;
+				}
+			}
+
+			for (uint8_t corner = 0; corner < 8; ++corner)
+			{
+				Vector3 cornerPoint((corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z);
+
+				if (SweepRaySphere(center, direction, best, cornerPoint, radius, t) && t <= best)
+				{
+					best = t;
+					normal = glm::normalize(center + direction * t - cornerPoint);
+					hit = true;
+				}
+			}
+
+			for (uint8_t axis = 0; axis < 3; ++axis)
+			{
+				uint8_t u = (axis + 1) % 3;
+				uint8_t v = (axis + 2) % 3;
+
+				for (uint8_t edge = 0; edge < 4; ++edge)
+				{
+					Vector3 edgePoint(0.0f);
+					edgePoint[u] = (edge & 1) ? max[u] : min[u];
+					edgePoint[v] = (edge & 2) ? max[v] : min[v];
+
+					if (SweepRayAxisCylinder(center, direction, best, edgePoint, axis, min[axis], max[axis], radius, t) && t <= best)
+					{
+						best = t;
+						Vector3 away = center + direction * t - edgePoint;
+						away[axis] = 0.0f;
+						normal = glm::normalize(away);
+						hit = true;
+					}
+				}
+			}
+
+			if (hit)
+				distance = best;
+
+			return hit;
+		}
+
+		// Capsule standing along the Y axis, the inner segment spans center +- halfHeight.
+		// Sweeping it equals sweeping a sphere against the box stretched by the segment, which is exact for the upright capsules character controllers use.
+		static bool SweepCapsuleAABB(const Vector3& center, float halfHeight, float radius, const Vector3& direction, float maxDistance, const AABB& box, float& distance, Vector3& normal)
+		{
+			Vector3 segmentExtent(0.0f, halfHeight, 0.0f);
+			return SweepSphereAABB(center, radius, direction, maxDistance, AABB(box.GetMin() - segmentExtent, box.GetMax() + segmentExtent), distance, normal);
+		}
+
+		static bool OverlapCapsuleAABB(const Vector3& center, float halfHeight, float radius, const AABB& box)
+		{
+			Vector3 segmentExtent(0.0f, halfHeight, 0.0f);
+			return OverlapSphereAABB(center, radius, AABB(box.GetMin() - segmentExtent, box.GetMax() + segmentExtent));
+		}
+
+		// Time of impact of a box moving by displacement against a static box, in [0, 1] of the displacement.
+		// Boxes that only touch along an axis they do not move on are treated as separated so bodies can slide along surfaces.
+		static bool SweepAABBAABB(const AABB& moving, const Vector3& displacement, const AABB& target, float& timeOfImpact, Vector3& normal)
+		{
+			float tEnter = -std::numeric_limits<float>::infinity();
+			float tExit = std::numeric_limits<float>::infinity();
+			int enterAxis = -1;
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				if (glm::abs(displacement[axis]) < glm::epsilon<float>())
+				{
+					if (moving.GetMax()[axis] <= target.GetMin()[axis] || moving.GetMin()[axis] >= target.GetMax()[axis])
+						return false;
+					continue;
+				}
+
+				float invDisplacement = 1.0f / displacement[axis];
+				float t0 = (target.GetMin()[axis] - moving.GetMax()[axis]) * invDisplacement;
+				float t1 = (target.GetMax()[axis] - moving.GetMin()[axis]) * invDisplacement;
+
+				if (t0 > t1) std::swap(t0, t1);
+
+				if (t0 > tEnter)
+				{
+					tEnter = t0;
+					enterAxis = axis;
+				}
+
+				tExit = std::min(tExit, t1);
+			}
+
+			if (enterAxis < 0 || tEnter >= tExit || tEnter > 1.0f || tExit <= 0.0f)
+				return false;
+
+			timeOfImpact = std::max(tEnter, 0.0f);
+			normal = {0, 0, 0};
+			normal[enterAxis] = -glm::sign(displacement[enterAxis]);
+			return true;
+		}
+	}
+
+	namespace BroadPhase
+	{
+		// Swept AABB query for fast bodies, finds the earliest impact of the collider against box colliders of other actors
+		static bool SweepBoxColliders(BoxColliderComponent* current, const AABBTree<ColliderComponent>& bvhTree, const Vector3& displacement, float& timeOfImpact, Vector3& normal)
+		{
+			AABB currentBounds = current->GetTransformedAABB();
+			AABB targetBounds = currentBounds;
+			targetBounds.SetOffset(displacement);
+
+			bool hit = false;
+			timeOfImpact = 1.0f;
+
+			for (ColliderComponent* collisionObject : bvhTree.QueryOverlaps(current, currentBounds.Merge(targetBounds)))
+			{
+				auto* box = BoxColliderComponent::SafeCast(collisionObject);
+
+				if (box == nullptr || box->GetOwner() == current->GetOwner())
+					continue;
+
+				float toi;
+				Vector3 hitNormal;
+				if (NarrowPhase::SweepAABBAABB(currentBounds, displacement, box->GetTransformedAABB(), toi, hitNormal) && toi < timeOfImpact)
+				{
+					timeOfImpact = toi;
+					normal = hitNormal;
+					hit = true;
+				}
+			}
+
+			return hit;
+		}
+	}
 }
\ No newline at end of file
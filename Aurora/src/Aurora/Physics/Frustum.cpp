@@ -0,0 +1,132 @@
+#include "Frustum.hpp"
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+	#define AU_FRUSTUM_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define AU_FRUSTUM_SSE 1
+#endif
+
+namespace Aurora
+{
+	void FFrustum::CullBoxes(const FBoundsSoA& bounds, std::vector<uint64_t>& visibility) const
+	{
+		const size_t count = bounds.Size();
+
+		const float* cx = bounds.CenterX.data();
+		const float* cy = bounds.CenterY.data();
+		const float* cz = bounds.CenterZ.data();
+		const float* ex = bounds.ExtentX.data();
+		const float* ey = bounds.ExtentY.data();
+		const float* ez = bounds.ExtentZ.data();
+
+		size_t i = 0;
+
+		// A box is outside a plane when its most positive corner is behind it: dot(n, c) + w + dot(|n|, e) < 0
+#if defined(AU_FRUSTUM_AVX)
+		__m256 planeX[Count], planeY[Count], planeZ[Count], planeW[Count];
+		__m256 absPlaneX[Count], absPlaneY[Count], absPlaneZ[Count];
+
+		for (int p = 0; p < Count; ++p)
+		{
+			planeX[p] = _mm256_set1_ps(m_planes[p].x);
+			planeY[p] = _mm256_set1_ps(m_planes[p].y);
+			planeZ[p] = _mm256_set1_ps(m_planes[p].z);
+			planeW[p] = _mm256_set1_ps(m_planes[p].w);
+			absPlaneX[p] = _mm256_set1_ps(glm::abs(m_planes[p].x));
+			absPlaneY[p] = _mm256_set1_ps(glm::abs(m_planes[p].y));
+			absPlaneZ[p] = _mm256_set1_ps(glm::abs(m_planes[p].z));
+		}
+
+		const __m256 pointsMinX = _mm256_set1_ps(m_pointsMin.x), pointsMinY = _mm256_set1_ps(m_pointsMin.y), pointsMinZ = _mm256_set1_ps(m_pointsMin.z);
+		const __m256 pointsMaxX = _mm256_set1_ps(m_pointsMax.x), pointsMaxY = _mm256_set1_ps(m_pointsMax.y), pointsMaxZ = _mm256_set1_ps(m_pointsMax.z);
+		const __m256 zero = _mm256_setzero_ps();
+
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 centerX = _mm256_loadu_ps(cx + i), centerY = _mm256_loadu_ps(cy + i), centerZ = _mm256_loadu_ps(cz + i);
+			__m256 extentX = _mm256_loadu_ps(ex + i), extentY = _mm256_loadu_ps(ey + i), extentZ = _mm256_loadu_ps(ez + i);
+
+			__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+			for (int p = 0; p < Count; ++p)
+			{
+				__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(centerX, planeX[p]), _mm256_mul_ps(centerY, planeY[p])), _mm256_add_ps(_mm256_mul_ps(centerZ, planeZ[p]), planeW[p]));
+				__m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(extentX, absPlaneX[p]), _mm256_mul_ps(extentY, absPlaneY[p])), _mm256_mul_ps(extentZ, absPlaneZ[p]));
+				visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+			}
+
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_sub_ps(centerX, extentX), pointsMaxX, _CMP_LE_OQ));
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_sub_ps(centerY, extentY), pointsMaxY, _CMP_LE_OQ));
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_sub_ps(centerZ, extentZ), pointsMaxZ, _CMP_LE_OQ));
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(centerX, extentX), pointsMinX, _CMP_GE_OQ));
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(centerY, extentY), pointsMinY, _CMP_GE_OQ));
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(centerZ, extentZ), pointsMinZ, _CMP_GE_OQ));
+
+			visibility[i >> 6] &= ~((uint64_t)(~_mm256_movemask_ps(visible) & 0xFF) << (i & 63));
+		}
+#elif defined(AU_FRUSTUM_SSE)
+		__m128 planeX[Count], planeY[Count], planeZ[Count], planeW[Count];
+		__m128 absPlaneX[Count], absPlaneY[Count], absPlaneZ[Count];
+
+		for (int p = 0; p < Count; ++p)
+		{
+			planeX[p] = _mm_set1_ps(m_planes[p].x);
+			planeY[p] = _mm_set1_ps(m_planes[p].y);
+			planeZ[p] = _mm_set1_ps(m_planes[p].z);
+			planeW[p] = _mm_set1_ps(m_planes[p].w);
+			absPlaneX[p] = _mm_set1_ps(glm::abs(m_planes[p].x));
+			absPlaneY[p] = _mm_set1_ps(glm::abs(m_planes[p].y));
+			absPlaneZ[p] = _mm_set1_ps(glm::abs(m_planes[p].z));
+		}
+
+		const __m128 pointsMinX = _mm_set1_ps(m_pointsMin.x), pointsMinY = _mm_set1_ps(m_pointsMin.y), pointsMinZ = _mm_set1_ps(m_pointsMin.z);
+		const __m128 pointsMaxX = _mm_set1_ps(m_pointsMax.x), pointsMaxY = _mm_set1_ps(m_pointsMax.y), pointsMaxZ = _mm_set1_ps(m_pointsMax.z);
+		const __m128 zero = _mm_setzero_ps();
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 centerX = _mm_loadu_ps(cx + i), centerY = _mm_loadu_ps(cy + i), centerZ = _mm_loadu_ps(cz + i);
+			__m128 extentX = _mm_loadu_ps(ex + i), extentY = _mm_loadu_ps(ey + i), extentZ = _mm_loadu_ps(ez + i);
+
+			__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			for (int p = 0; p < Count; ++p)
+			{
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(centerX, planeX[p]), _mm_mul_ps(centerY, planeY[p])), _mm_add_ps(_mm_mul_ps(centerZ, planeZ[p]), planeW[p]));
+				__m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(extentX, absPlaneX[p]), _mm_mul_ps(extentY, absPlaneY[p])), _mm_mul_ps(extentZ, absPlaneZ[p]));
+				visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+			}
+
+			visible = _mm_and_ps(visible, _mm_cmple_ps(_mm_sub_ps(centerX, extentX), pointsMaxX));
+			visible = _mm_and_ps(visible, _mm_cmple_ps(_mm_sub_ps(centerY, extentY), pointsMaxY));
+			visible = _mm_and_ps(visible, _mm_cmple_ps(_mm_sub_ps(centerZ, extentZ), pointsMaxZ));
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(centerX, extentX), pointsMinX));
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(centerY, extentY), pointsMinY));
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(centerZ, extentZ), pointsMinZ));
+
+			visibility[i >> 6] &= ~((uint64_t)(~_mm_movemask_ps(visible) & 0xF) << (i & 63));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			bool visible = true;
+
+			for (int p = 0; p < Count && visible; ++p)
+			{
+				float distance = cx[i] * m_planes[p].x + cy[i] * m_planes[p].y + cz[i] * m_planes[p].z + m_planes[p].w;
+				float radius = ex[i] * glm::abs(m_planes[p].x) + ey[i] * glm::abs(m_planes[p].y) + ez[i] * glm::abs(m_planes[p].z);
+				visible = distance + radius >= 0.0f;
+			}
+
+			visible = visible &&
+				cx[i] - ex[i] <= m_pointsMax.x && cy[i] - ey[i] <= m_pointsMax.y && cz[i] - ez[i] <= m_pointsMax.z &&
+				cx[i] + ex[i] >= m_pointsMin.x && cy[i] + ey[i] >= m_pointsMin.y && cz[i] + ez[i] >= m_pointsMin.z;
+
+			if (!visible)
+				visibility[i >> 6] &= ~(1ull << (i & 63));
+		}
+	}
+}
@@ -1,13 +1,73 @@
 #pragma once
 
+#include <vector>
+
 #include "AABB.hpp"
 
 namespace Aurora
 {
+	// World space boxes stored as structure of arrays for FFrustum::CullBoxes
+	struct FBoundsSoA
+	{
+		std::vector<float> CenterX, CenterY, CenterZ;
+		std::vector<float> ExtentX, ExtentY, ExtentZ;
+
+		[[nodiscard]] inline size_t Size() const { return CenterX.size(); }
+
+		inline void Clear()
+		{
+			CenterX.clear(); CenterY.clear(); CenterZ.clear();
+			ExtentX.clear(); ExtentY.clear(); ExtentZ.clear();
+		}
+
+		inline void Reserve(size_t count)
+		{
+			CenterX.reserve(count); CenterY.reserve(count); CenterZ.reserve(count);
+			ExtentX.reserve(count); ExtentY.reserve(count); ExtentZ.reserve(count);
+		}
+
+		inline void Resize(size_t count)
+		{
+			CenterX.resize(count); CenterY.resize(count); CenterZ.resize(count);
+			ExtentX.resize(count); ExtentY.resize(count); ExtentZ.resize(count);
+		}
+
+		inline void Add(const AABB& bounds)
+		{
+			Vector3 center = (bounds.GetMin() + bounds.GetMax()) * 0.5f;
+			Vector3 extent = (bounds.GetMax() - bounds.GetMin()) * 0.5f;
+
+			CenterX.push_back(center.x); CenterY.push_back(center.y); CenterZ.push_back(center.z);
+			ExtentX.push_back(extent.x); ExtentY.push_back(extent.y); ExtentZ.push_back(extent.z);
+		}
+
+		// Writes only the slot at index, so disjoint ranges can be filled from different threads
+		inline void Set(size_t index, const AABB& bounds)
+		{
+			Vector3 center = (bounds.GetMin() + bounds.GetMax()) * 0.5f;
+			Vector3 extent = (bounds.GetMax() - bounds.GetMin()) * 0.5f;
+
+			CenterX[index] = center.x; CenterY[index] = center.y; CenterZ[index] = center.z;
+			ExtentX[index] = extent.x; ExtentY[index] = extent.y; ExtentZ[index] = extent.z;
+		}
+	};
+
+	[[nodiscard]] inline bool IsVisibleInMask(const std::vector<uint64_t>& visibility, size_t index)
+	{
+		return (visibility[index >> 6] >> (index & 63)) & 1;
+	}
+
 	// Source: https://gist.github.com/podgorskiy/e698d18879588ada9014768e3e82a644
 	class FFrustum
 	{
 	public:
+		enum class EContainment : uint8_t
+		{
+			Outside,
+			Intersects,
+			Inside
+		};
+
 		FFrustum() = default;
 
 		// m = ProjectionMatrix * ViewMatrix
@@ -18,6 +78,11 @@ namespace Aurora
 		// http://iquilezles.org/www/articles/frustumcorrect/frustumcorrect.htm
 		[[nodiscard]] bool IsBoxVisible(const glm::vec3& minp, const glm::vec3& maxp) const;
 		[[nodiscard]] bool IsBoxVisible(const AABB& boundingBox) const;
+		// Outside matches !IsBoxVisible, Inside means the whole box is in front of every plane
+		[[nodiscard]] EContainment ClassifyBox(const glm::vec3& minp, const glm::vec3& maxp) const;
+
+		// Same test as IsBoxVisible for many boxes, 8 (AVX) or 4 (SSE) at a time. Clears bit i of visibility when box i is outside, other bits are kept.
+		AU_API void CullBoxes(const FBoundsSoA& bounds, std::vector<uint64_t>& visibility) const;
 
 	private:
 		enum Planes
@@ -45,6 +110,9 @@ namespace Aurora
 
 		glm::vec4   m_planes[Count]{};
 		glm::vec3   m_points[8]{};
+		// Bounds of m_points, a box is outside when it lies fully beyond them on an axis
+		glm::vec3   m_pointsMin{};
+		glm::vec3   m_pointsMax{};
 	};
 
 	inline FFrustum::FFrustum(glm::mat4 m)
@@ -88,6 +156,14 @@ namespace Aurora
 		m_points[5] = intersection<Left,  Top,    Far>(crosses);
 		m_points[6] = intersection<Right, Bottom, Far>(crosses);
 		m_points[7] = intersection<Right, Top,    Far>(crosses);
+
+		m_pointsMin = m_points[0];
+		m_pointsMax = m_points[0];
+		for (const glm::vec3& point : m_points)
+		{
+			m_pointsMin = glm::min(m_pointsMin, point);
+			m_pointsMax = glm::max(m_pointsMax, point);
+		}
 	}
 
 	inline AABB FFrustum::GetBounds() const
@@ -138,6 +214,35 @@ namespace Aurora
 		return IsBoxVisible(boundingBox.GetMin(), boundingBox.GetMax());
 	}
 
+	inline FFrustum::EContainment FFrustum::ClassifyBox(const glm::vec3& minp, const glm::vec3& maxp) const
+	{
+		const glm::vec3 center = (minp + maxp) * 0.5f;
+		const glm::vec3 extent = (maxp - minp) * 0.5f;
+		bool inside = true;
+
+		for (const glm::vec4& plane : m_planes)
+		{
+			float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+			float radius = glm::dot(glm::abs(glm::vec3(plane)), extent);
+
+			if (distance + radius < 0.0f)
+				return EContainment::Outside;
+
+			if (distance - radius < 0.0f)
+				inside = false;
+		}
+
+		if (inside)
+			return EContainment::Inside;
+
+		if (m_pointsMin.x > maxp.x || m_pointsMax.x < minp.x ||
+		    m_pointsMin.y > maxp.y || m_pointsMax.y < minp.y ||
+		    m_pointsMin.z > maxp.z || m_pointsMax.z < minp.z)
+			return EContainment::Outside;
+
+		return EContainment::Intersects;
+	}
+
 	template<FFrustum::Planes a, FFrustum::Planes b, FFrustum::Planes c>
 	inline glm::vec3 FFrustum::intersection(const glm::vec3* crosses) const
 	{
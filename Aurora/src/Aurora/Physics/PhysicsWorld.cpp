@@ -1,8 +1,12 @@
 #include "PhysicsWorld.hpp"
 
+#include <chrono>
+
+#include "Aurora/Core/Common.hpp"
 #include "Aurora/Core/Profiler.hpp"
 #include "Aurora/Framework/Scene.hpp"
 #include "Aurora/Framework/Physics/RigidBodyComponent.hpp"
+#include "Aurora/Framework/MeshComponent.hpp"
 #include "Aurora/Graphics/DShape.hpp"
 
 #include "Integration.hpp"
@@ -17,6 +21,8 @@ namespace Aurora
 		m_DebugRender(false),
 		m_Gravity(0, -30.0f, 0),
 		m_UpdateRate(1.0 / 120.0),
+		m_MaxStepsPerFrame(8),
+		m_Interpolate(true),
 		m_AABBTree(1)
 	{
 
@@ -27,14 +33,26 @@ namespace Aurora
 		CPU_DEBUG_SCOPE("PhysicsWorld");
 
 		m_Accumulator += frameTime;
+		m_Stats = {};
 
-		while (m_Accumulator >= m_UpdateRate)
+		uint32_t steps = 0;
+		while (m_Accumulator >= m_UpdateRate && steps < m_MaxStepsPerFrame)
 		{
 			RunPhysics();
 			m_Time += m_UpdateRate;
 			m_Accumulator -= m_UpdateRate;
+			steps++;
 		}
 
+		m_Stats.Steps = steps;
+
+		if (m_Accumulator >= m_UpdateRate)
+		{
+			m_Accumulator = std::fmod(m_Accumulator, m_UpdateRate);
+		}
+
+		InterpolateBodies();
+
 		if (IsDebugRender())
 		{
 			for (const auto& node : m_AABBTree.GetNodes())
@@ -50,8 +68,36 @@ namespace Aurora
 		}
 	}
 
+	void PhysicsWorld::InterpolateBodies()
+	{
+		float alpha = (float)GetInterpolationAlpha();
+
+		for (RigidBodyComponent* rigidBodyComponent : m_Scene->GetComponents<RigidBodyComponent>())
+		{
+			SceneComponent* root = rigidBodyComponent->GetOwner()->GetRootComponent();
+			const Vector3& location = root->GetTransform().GetLocation();
+
+			// Skip bodies that did not step or were moved outside of physics, lerping would drag them back to the old spot
+			if (!m_Interpolate || !rigidBodyComponent->m_HasPhysicsState || location != rigidBodyComponent->m_CurrentLocation)
+			{
+				root->SetInterpolationOffset(Vector3(0.0f));
+				continue;
+			}
+
+			Vector3 renderLocation = glm::mix(rigidBodyComponent->m_PreviousLocation, rigidBodyComponent->m_CurrentLocation, alpha);
+			root->SetInterpolationOffset(renderLocation - location);
+		}
+	}
+
+	static double ElapsedMilliseconds(std::chrono::high_resolution_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
 	void PhysicsWorld::RunPhysics()
 	{
+		auto broadphaseStart = std::chrono::high_resolution_clock::now();
+
 		ComponentView<ColliderComponent> colliderComponents = m_Scene->GetComponents<ColliderComponent>();
 
 		if (colliderComponents.empty())
@@ -69,15 +115,27 @@ namespace Aurora
 				continue;
 
 			m_AABBTree.InsertObject(collider, collider->GetTransformedAABB());
+			m_Stats.Colliders++;
 		}
 
+		// Every registered collider is in the rebuilt tree
+		m_PendingColliders.clear();
+
+		m_Stats.BroadphaseTime += ElapsedMilliseconds(broadphaseStart);
+		auto integrationStart = std::chrono::high_resolution_clock::now();
+
 		ComponentView<RigidBodyComponent> bodyComponents = m_Scene->GetComponents<RigidBodyComponent>();
 		for (RigidBodyComponent* rigidBodyComponent : bodyComponents)
 		{
 			if (rigidBodyComponent->IsKinematic() || !rigidBodyComponent->IsActive() || !rigidBodyComponent->GetOwner()->IsActive())
+			{
+				rigidBodyComponent->m_HasPhysicsState = false;
 				continue;
+			}
 
 			rigidBodyComponent->GetOwner()->FixedStep();
+			m_Stats.Bodies++;
+			rigidBodyComponent->m_PreviousLocation = rigidBodyComponent->GetOwner()->GetRootComponent()->GetTransform().GetLocation();
 
 			if (rigidBodyComponent->HasGravity())
 				rigidBodyComponent->AddAcceleration(m_Gravity * (float)m_UpdateRate);
@@ -101,23 +159,33 @@ namespace Aurora
 			rigidBodyComponent->CollidedSides[1] = false;
 			rigidBodyComponent->CollidedSides[2] = false;
 
-			if (isMoving)
+			if (isMoving && rigidBodyComponent->IsContinuousCollision() && !colliders.empty())
 			{
-				for (BoxColliderComponent* collider : colliders)
+				IntegrateContinuous(rigidBodyComponent, colliders, velocity);
+			}
+			else
+			{
+				if (isMoving)
 				{
-					BroadPhase::FromAABB(collider, m_AABBTree, velocity, rigidBodyComponent->CollidedSides, m_UpdateRate);
+					for (BoxColliderComponent* collider : colliders)
+					{
+						BroadPhase::FromAABB(collider, m_AABBTree, velocity, rigidBodyComponent->CollidedSides, m_UpdateRate);
+					}
 				}
-			}
 
-			/*Vector3 location = transform.GetLocation();
-			MotionIntegrators::ModifiedEuler(location, velocity, rigidBodyComponent->GetAcceleration(), (float)m_UpdateRate);
-			transform.SetLocation(location);*/
-			Transform& transform = rigidBodyComponent->GetOwner()->GetRootComponent()->GetTransform();
-			transform.SetLocation(transform.GetLocation() + velocity * (float)m_UpdateRate);
+				/*Vector3 location = transform.GetLocation();
+				MotionIntegrators::ModifiedEuler(location, velocity, rigidBodyComponent->GetAcceleration(), (float)m_UpdateRate);
+				transform.SetLocation(location);*/
+				Transform& transform = rigidBodyComponent->GetOwner()->GetRootComponent()->GetTransform();
+				transform.SetLocation(transform.GetLocation() + velocity * (float)m_UpdateRate);
+			}
 
 			rigidBodyComponent->SetVelocity(velocity);
 			rigidBodyComponent->SetAcceleration({0, 0, 0});
 
+			rigidBodyComponent->m_CurrentLocation = rigidBodyComponent->GetOwner()->GetRootComponent()->GetTransform().GetLocation();
+			rigidBodyComponent->m_HasPhysicsState = true;
+
 			if (isMoving)
 			{
 				for (BoxColliderComponent* collider : colliders)
@@ -127,10 +195,130 @@ namespace Aurora
 				}
 			}
 		}
+
+		m_Stats.IntegrationTime += ElapsedMilliseconds(integrationStart);
+	}
+
+	// Distance kept from the surface after an impact so the next sweep does not start in contact
+	static constexpr float ContinuousCollisionSkin = 0.001f;
+
+	void PhysicsWorld::IntegrateContinuous(RigidBodyComponent* rigidBodyComponent, const std::vector<BoxColliderComponent*>& colliders, Vector3& velocity)
+	{
+		Transform& transform = rigidBodyComponent->GetOwner()->GetRootComponent()->GetTransform();
+
+		// Box colliders are swept exactly, the substeps keep each move under the smallest collider half extent
+		// so proxy colliders, which are only resolved discretely, are not skipped over either
+		float minHalfExtent = std::numeric_limits<float>::max();
+		for (BoxColliderComponent* collider : colliders)
+		{
+			Vector3 extent = collider->GetAABB().GetExtent();
+			minHalfExtent = std::min(minHalfExtent, std::min(extent.x, std::min(extent.y, extent.z)));
+		}
+
+		float stepLength = glm::length(velocity) * (float)m_UpdateRate;
+		auto substeps = (uint32_t)glm::ceil(stepLength / std::max(minHalfExtent, glm::epsilon<float>()));
+		substeps = glm::clamp(substeps, 1u, rigidBodyComponent->GetMaxSubsteps());
+
+		double substepRate = m_UpdateRate / substeps;
+
+		for (uint32_t substep = 0; substep < substeps; ++substep)
+		{
+			for (BoxColliderComponent* collider : colliders)
+			{
+				BroadPhase::FromAABB(collider, m_AABBTree, velocity, rigidBodyComponent->CollidedSides, substepRate, true);
+			}
+
+			float remaining = 1.0f;
+
+			// Every impact zeroes one velocity axis and slides along the surface, so three iterations cover a corner
+			for (uint8_t iteration = 0; iteration < 3 && remaining > 0.0f; ++iteration)
+			{
+				Vector3 displacement = velocity * (float)substepRate * remaining;
+
+				if (glm::length2(displacement) == 0.0f)
+					break;
+
+				float timeOfImpact = 1.0f;
+				Vector3 normal;
+				bool hit = false;
+
+				for (BoxColliderComponent* collider : colliders)
+				{
+					float toi;
+					Vector3 hitNormal;
+					if (BroadPhase::SweepBoxColliders(collider, m_AABBTree, displacement, toi, hitNormal) && toi < timeOfImpact)
+					{
+						timeOfImpact = toi;
+						normal = hitNormal;
+						hit = true;
+					}
+				}
+
+				if (!hit)
+				{
+					transform.AddLocation(displacement);
+					break;
+				}
+
+				float length = glm::length(displacement);
+				float travel = std::max(timeOfImpact * length - ContinuousCollisionSkin, 0.0f);
+				transform.AddLocation(displacement * (travel / length));
+
+				uint8_t axis = normal.x != 0.0f ? 0 : (normal.y != 0.0f ? 1 : 2);
+				velocity[axis] = 0;
+				rigidBodyComponent->CollidedSides[axis] = true;
+
+				remaining *= 1.0f - timeOfImpact;
+			}
+		}
 	}
 
 	PhysicsWorld::~PhysicsWorld() = default;
 
+	void PhysicsWorld::AddCollider(ColliderComponent* collider)
+	{
+		m_PendingColliders.push_back(collider);
+	}
+
+	void PhysicsWorld::RemoveCollider(ColliderComponent* collider)
+	{
+		if (m_AABBTree.ContainsObject(collider))
+		{
+			m_AABBTree.RemoveObject(collider);
+		}
+
+		VectorRemove(m_PendingColliders, collider);
+	}
+
+	void PhysicsWorld::UpdateCollider(ColliderComponent* collider)
+	{
+		if (m_AABBTree.ContainsObject(collider))
+		{
+			m_AABBTree.UpdateObject(collider, collider->GetTransformedAABB());
+		}
+	}
+
+	void PhysicsWorld::SyncBroadphase()
+	{
+		m_Scene->FlushMovedComponents();
+
+		for (size_t i = 0; i < m_PendingColliders.size();)
+		{
+			ColliderComponent* collider = m_PendingColliders[i];
+
+			if (collider->GetParent() == nullptr)
+			{
+				++i;
+				continue;
+			}
+
+			m_AABBTree.InsertObject(collider, collider->GetTransformedAABB());
+
+			m_PendingColliders[i] = m_PendingColliders.back();
+			m_PendingColliders.pop_back();
+		}
+	}
+
 	int32_t PhysicsWorld::RayCast(const Vector3& fromPos, const Vector3& toPos, std::vector<RayCastHitResult>& results) const
 	{
 		ComponentView<ColliderComponent> colliderComponents = m_Scene->GetComponents<ColliderComponent>();
@@ -142,6 +330,19 @@ namespace Aurora
 
 		for (ColliderComponent* collider : colliderComponents)
 		{
+			if (MeshColliderComponent* meshCollider = MeshColliderComponent::SafeCast(collider))
+			{
+				float distance;
+				Vector3 normal;
+				if (meshCollider->RayCast(fromPos, direction, maxDistance, distance, normal))
+				{
+					results.emplace_back(RayCastHitResult{collider->GetOwner(), fromPos + direction * distance, normal, distance});
+					count++;
+				}
+
+				continue;
+			}
+
 			AABB bounds = collider->GetAABB();
 			bounds.SetOffset(collider->GetParent()->GetWorldPosition());
 
@@ -168,4 +369,168 @@ namespace Aurora
 
 		return count;
 	}
-}
\ No newline at end of file
+
+	int32_t PhysicsWorld::RayCastMeshes(const Vector3& fromPos, const Vector3& toPos, std::vector<RayCastHitResult>& results) const
+	{
+		float maxDistance = glm::length(toPos - fromPos);
+
+		if (maxDistance <= 0.0f)
+			return 0;
+
+		Vector3 direction = (toPos - fromPos) / maxDistance;
+
+		int32_t count = 0;
+
+		for (MeshComponent* meshComponent : m_Scene->GetComponents<MeshComponent>())
+		{
+			if (!meshComponent->HasMesh() || !meshComponent->IsActive() || !meshComponent->IsParentActive())
+				continue;
+
+			Mesh_ptr mesh = meshComponent->GetMesh();
+
+			if (!mesh->CollisionBVH)
+				continue;
+
+			Matrix4 transform = meshComponent->GetTransformationMatrix();
+
+			std::vector<AABBHit> boundsHits;
+			if (!mesh->m_Bounds.Transform(transform).CollideWithRay(fromPos, direction, boundsHits))
+				continue;
+
+			TriangleHit hit = {};
+			if (mesh->CollisionBVH->RayCast(transform, fromPos, direction, maxDistance, hit))
+			{
+				results.emplace_back(RayCastHitResult{meshComponent->GetOwner(), fromPos + direction * hit.Distance, hit.Normal, hit.Distance});
+				count++;
+			}
+		}
+
+		if (count == 0)
+			return 0;
+
+		std::sort(results.begin(), results.end(), [](const RayCastHitResult& left, const RayCastHitResult& right) -> bool { return left.HitDistance < right.HitDistance; });
+
+		return count;
+	}
+
+	template<typename SweepFn>
+	static int32_t SweepTree(const AABBTree<ColliderComponent>& tree, const Vector3& fromPos, const Vector3& toPos, const Vector3& sweepExtent, std::vector<RayCastHitResult>& results, const Actor* ignoredActor, SweepFn&& sweep)
+	{
+		float maxDistance = glm::length(toPos - fromPos);
+
+		if (maxDistance <= 0.0f)
+			return 0;
+
+		Vector3 direction = (toPos - fromPos) / maxDistance;
+
+		std::vector<ColliderComponent*> candidates;
+		tree.QuerySweep(fromPos, direction, maxDistance, sweepExtent, candidates);
+
+		size_t firstResult = results.size();
+
+		for (ColliderComponent* candidate : candidates)
+		{
+			auto* collider = BoxColliderComponent::SafeCast(candidate);
+
+			if (collider == nullptr || collider->GetOwner() == ignoredActor || !collider->IsActive() || !collider->IsParentActive())
+				continue;
+
+			AABB bounds = collider->GetTransformedAABB();
+
+			float distance;
+			Vector3 normal;
+			if (!sweep(fromPos, direction, maxDistance, bounds, distance, normal))
+				continue;
+
+			Vector3 contact = glm::clamp(fromPos + direction * distance, bounds.GetMin(), bounds.GetMax());
+			results.emplace_back(RayCastHitResult{collider->GetOwner(), contact, normal, distance});
+		}
+
+		auto count = static_cast<int32_t>(results.size() - firstResult);
+
+		if (count == 0)
+			return 0;
+
+		std::sort(results.begin(), results.end(), [](const RayCastHitResult& left, const RayCastHitResult& right) -> bool { return left.HitDistance < right.HitDistance; });
+
+		return count;
+	}
+
+	template<typename OverlapFn>
+	static int32_t OverlapTree(const AABBTree<ColliderComponent>& tree, const AABB& queryBounds, std::vector<ColliderComponent*>& results, const Actor* ignoredActor, OverlapFn&& overlap)
+	{
+		std::vector<ColliderComponent*> candidates;
+		tree.QueryOverlaps(queryBounds, candidates);
+
+		int32_t count = 0;
+
+		for (ColliderComponent* candidate : candidates)
+		{
+			auto* collider = BoxColliderComponent::SafeCast(candidate);
+
+			if (collider == nullptr || collider->GetOwner() == ignoredActor || !collider->IsActive() || !collider->IsParentActive())
+				continue;
+
+			if (!overlap(collider->GetTransformedAABB()))
+				continue;
+
+			results.push_back(collider);
+			count++;
+		}
+
+		return count;
+	}
+
+	int32_t PhysicsWorld::SphereCast(const Vector3& fromPos, const Vector3& toPos, float radius, std::vector<RayCastHitResult>& results, const Actor* ignoredActor)
+	{
+		SyncBroadphase();
+
+		return SweepTree(m_AABBTree, fromPos, toPos, Vector3(radius), results, ignoredActor,
+			[radius](const Vector3& origin, const Vector3& direction, float maxDistance, const AABB& bounds, float& distance, Vector3& normal) -> bool
+		{
+			return NarrowPhase::SweepSphereAABB(origin, radius, direction, maxDistance, bounds, distance, normal);
+		});
+	}
+
+	int32_t PhysicsWorld::CapsuleCast(const Vector3& fromPos, const Vector3& toPos, float halfHeight, float radius, std::vector<RayCastHitResult>& results, const Actor* ignoredActor)
+	{
+		SyncBroadphase();
+
+		return SweepTree(m_AABBTree, fromPos, toPos, Vector3(radius, radius + halfHeight, radius), results, ignoredActor,
+			[halfHeight, radius](const Vector3& origin, const Vector3& direction, float maxDistance, const AABB& bounds, float& distance, Vector3& normal) -> bool
+		{
+			return NarrowPhase::SweepCapsuleAABB(origin, halfHeight, radius, direction, maxDistance, bounds, distance, normal);
+		});
+	}
+
+	int32_t PhysicsWorld::BoxCast(const Vector3& fromPos, const Vector3& toPos, const Vector3& halfExtent, std::vector<RayCastHitResult>& results, const Actor* ignoredActor)
+	{
+		SyncBroadphase();
+
+		return SweepTree(m_AABBTree, fromPos, toPos, halfExtent, results, ignoredActor,
+			[&halfExtent](const Vector3& origin, const Vector3& direction, float maxDistance, const AABB& bounds, float& distance, Vector3& normal) -> bool
+		{
+			return NarrowPhase::SweepBoxAABB(origin, halfExtent, direction, maxDistance, bounds, distance, normal);
+		});
+	}
+
+	int32_t PhysicsWorld::OverlapSphere(const Vector3& center, float radius, std::vector<ColliderComponent*>& results, const Actor* ignoredActor)
+	{
+		SyncBroadphase();
+
+		return OverlapTree(m_AABBTree, AABB(center - Vector3(radius), center + Vector3(radius)), results, ignoredActor, [&center, radius](const AABB& bounds) -> bool
+		{
+			return NarrowPhase::OverlapSphereAABB(center, radius, bounds);
+		});
+	}
+
+	int32_t PhysicsWorld::OverlapBox(const Vector3& center, const Vector3& halfExtent, std::vector<ColliderComponent*>& results, const Actor* ignoredActor)
+	{
+		SyncBroadphase();
+
+		return OverlapTree(m_AABBTree, AABB(center - halfExtent, center + halfExtent), results, ignoredActor, [&center, &halfExtent](const AABB& bounds) -> bool
+		{
+			return NarrowPhase::OverlapAABBAABB(center, halfExtent, bounds);
+		});
+	}
+}
@@ -8,6 +8,7 @@
 namespace Aurora
 {
 	class Scene;
+	class Actor;
 
 	struct RayCastHitResult
 	{
@@ -17,6 +18,16 @@ namespace Aurora
 		double HitDistance;
 	};
 
+	// Counters of the last PhysicsWorld::Update call, times are in milliseconds
+	struct PhysicsStats
+	{
+		uint32_t Steps = 0;
+		uint32_t Colliders = 0;
+		uint32_t Bodies = 0;
+		double BroadphaseTime = 0;
+		double IntegrationTime = 0;
+	};
+
 	class AU_API PhysicsWorld
 	{
 	private:
@@ -28,8 +39,14 @@ namespace Aurora
 
 		Vector3 m_Gravity;
 		double m_UpdateRate;
+		uint32_t m_MaxStepsPerFrame;
+		bool m_Interpolate;
 
+		// Rebuilt every step, between steps colliders are added, removed and refitted as the scene changes
 		AABBTree<ColliderComponent> m_AABBTree;
+		// Registered colliders waiting for the next query or step, their bounds are not set yet when they register
+		std::vector<ColliderComponent*> m_PendingColliders;
+		PhysicsStats m_Stats;
 	public:
 		explicit PhysicsWorld(Scene* scene);
 		~PhysicsWorld();
@@ -40,8 +57,44 @@ namespace Aurora
 
 		void Update(double frameTime);
 
+		inline void SetUpdateRate(double updateRate) { m_UpdateRate = updateRate; }
+		[[nodiscard]] inline double GetUpdateRate() const { return m_UpdateRate; }
+
+		// Time over the step budget is dropped, so a hitch slows the simulation down instead of stalling the next frames
+		inline void SetMaxStepsPerFrame(uint32_t maxSteps) { m_MaxStepsPerFrame = std::max(maxSteps, 1u); }
+		[[nodiscard]] inline uint32_t GetMaxStepsPerFrame() const { return m_MaxStepsPerFrame; }
+
+		inline void SetInterpolation(bool interpolate) { m_Interpolate = interpolate; }
+		[[nodiscard]] inline bool IsInterpolation() const { return m_Interpolate; }
+
+		[[nodiscard]] inline const PhysicsStats& GetLastUpdateStats() const { return m_Stats; }
+		[[nodiscard]] inline const AABBTree<ColliderComponent>& GetBroadphaseTree() const { return m_AABBTree; }
+
+		// How far the frame is between the last and the next physics step, in [0, 1)
+		[[nodiscard]] inline double GetInterpolationAlpha() const { return m_Accumulator / m_UpdateRate; }
+
 		int32_t RayCast(const Vector3& fromPos, const Vector3& toPos, std::vector<RayCastHitResult>& results) const;
+		// Exact ray cast against rendered meshes that have StaticMesh::CollisionBVH, for picking and hitscan
+		int32_t RayCastMeshes(const Vector3& fromPos, const Vector3& toPos, std::vector<RayCastHitResult>& results) const;
+
+		// Shape queries first bring the broadphase tree up to date with the scene, only box colliders are narrowphased.
+		// Casts append hits sorted by distance, HitPosition is the contact point on the collider.
+		int32_t SphereCast(const Vector3& fromPos, const Vector3& toPos, float radius, std::vector<RayCastHitResult>& results, const Actor* ignoredActor = nullptr);
+		// Capsule is aligned with the Y axis, halfHeight is the half length of its inner segment
+		int32_t CapsuleCast(const Vector3& fromPos, const Vector3& toPos, float halfHeight, float radius, std::vector<RayCastHitResult>& results, const Actor* ignoredActor = nullptr);
+		int32_t BoxCast(const Vector3& fromPos, const Vector3& toPos, const Vector3& halfExtent, std::vector<RayCastHitResult>& results, const Actor* ignoredActor = nullptr);
+
+		int32_t OverlapSphere(const Vector3& center, float radius, std::vector<ColliderComponent*>& results, const Actor* ignoredActor = nullptr);
+		int32_t OverlapBox(const Vector3& center, const Vector3& halfExtent, std::vector<ColliderComponent*>& results, const Actor* ignoredActor = nullptr);
+
+		// Called by the scene as colliders are registered, unregistered and moved
+		void AddCollider(ColliderComponent* collider);
+		void RemoveCollider(ColliderComponent* collider);
+		void UpdateCollider(ColliderComponent* collider);
 	private:
+		void SyncBroadphase();
 		void RunPhysics();
+		void InterpolateBodies();
+		void IntegrateContinuous(class RigidBodyComponent* rigidBodyComponent, const std::vector<BoxColliderComponent*>& colliders, Vector3& velocity);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,414 @@
+#include "TriangleBVH.hpp"
+
+#include <limits>
+#include <algorithm>
+
+namespace Aurora
+{
+	static constexpr uint32_t SAHBinCount = 12;
+	static constexpr float SAHTraversalCost = 1.0f;
+
+	static inline float HalfSurfaceArea(const Vector3& min, const Vector3& max)
+	{
+		Vector3 size = max - min;
+		return size.x * size.y + size.y * size.z + size.z * size.x;
+	}
+
+	// Returns the entry distance or infinity when the ray misses the box
+	static inline float RayBoxDistance(const Vector3& origin, const Vector3& invDirection, float maxDistance, const Vector3& min, const Vector3& max)
+	{
+		Vector3 t0 = (min - origin) * invDirection;
+		Vector3 t1 = (max - origin) * invDirection;
+		Vector3 tMin = glm::min(t0, t1);
+		Vector3 tMax = glm::max(t0, t1);
+
+		float tEnter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+		float tExit = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+
+		return tEnter <= tExit ? tEnter : std::numeric_limits<float>::infinity();
+	}
+
+	static inline bool BoxesOverlap(const Vector3& minA, const Vector3& maxA, const Vector3& minB, const Vector3& maxB)
+	{
+		return minA.x <= maxB.x && maxA.x >= minB.x &&
+			minA.y <= maxB.y && maxA.y >= minB.y &&
+			minA.z <= maxB.z && maxA.z >= minB.z;
+	}
+
+	// Moller-Trumbore, two sided
+	static inline bool RayTriangle(const Vector3& origin, const Vector3& direction, const Vector3& v0, const Vector3& v1, const Vector3& v2, float& t, float& u, float& v)
+	{
+		Vector3 edge1 = v1 - v0;
+		Vector3 edge2 = v2 - v0;
+		Vector3 p = glm::cross(direction, edge2);
+		float determinant = glm::dot(edge1, p);
+
+		if (glm::abs(determinant) < 1e-12f)
+			return false;
+
+		float invDeterminant = 1.0f / determinant;
+		Vector3 s = origin - v0;
+		u = glm::dot(s, p) * invDeterminant;
+
+		if (u < 0.0f || u > 1.0f)
+			return false;
+
+		Vector3 q = glm::cross(s, edge1);
+		v = glm::dot(direction, q) * invDeterminant;
+
+		if (v < 0.0f || u + v > 1.0f)
+			return false;
+
+		t = glm::dot(edge2, q) * invDeterminant;
+		return t >= 0.0f;
+	}
+
+	// Separating axis test between a triangle and a box (Akenine-Moller)
+	static bool TriangleOverlapsBox(const Vector3& center, const Vector3& halfExtent, Vector3 v0, Vector3 v1, Vector3 v2)
+	{
+		v0 -= center;
+		v1 -= center;
+		v2 -= center;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float min = std::min(v0[axis], std::min(v1[axis], v2[axis]));
+			float max = std::max(v0[axis], std::max(v1[axis], v2[axis]));
+
+			if (min > halfExtent[axis] || max < -halfExtent[axis])
+				return false;
+		}
+
+		const Vector3 edges[3] = {v1 - v0, v2 - v1, v0 - v2};
+
+		for (const Vector3& edge : edges)
+		{
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				Vector3 unitAxis(0.0f);
+				unitAxis[axis] = 1.0f;
+				Vector3 testAxis = glm::cross(unitAxis, edge);
+
+				float p0 = glm::dot(v0, testAxis);
+				float p1 = glm::dot(v1, testAxis);
+				float p2 = glm::dot(v2, testAxis);
+				float radius = glm::dot(halfExtent, glm::abs(testAxis));
+
+				if (std::min(p0, std::min(p1, p2)) > radius || std::max(p0, std::max(p1, p2)) < -radius)
+					return false;
+			}
+		}
+
+		Vector3 normal = glm::cross(edges[0], edges[1]);
+		return glm::abs(glm::dot(normal, v0)) <= glm::dot(halfExtent, glm::abs(normal));
+	}
+
+	void TriangleBVH::Build(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices)
+	{
+		m_Nodes.clear();
+		m_Vertices.clear();
+		m_TriangleIndices.clear();
+
+		auto triangleCount = (uint32_t)(indices.size() / 3);
+
+		if (triangleCount == 0)
+			return;
+
+		std::vector<Vector3> centroids(triangleCount);
+		std::vector<Vector3> triangleMin(triangleCount);
+		std::vector<Vector3> triangleMax(triangleCount);
+		std::vector<uint32_t> order(triangleCount);
+
+		for (uint32_t i = 0; i < triangleCount; ++i)
+		{
+			const Vector3& v0 = positions[indices[i * 3 + 0]];
+			const Vector3& v1 = positions[indices[i * 3 + 1]];
+			const Vector3& v2 = positions[indices[i * 3 + 2]];
+
+			triangleMin[i] = glm::min(v0, glm::min(v1, v2));
+			triangleMax[i] = glm::max(v0, glm::max(v1, v2));
+			centroids[i] = (v0 + v1 + v2) / 3.0f;
+			order[i] = i;
+		}
+
+		m_Nodes.reserve(triangleCount * 2);
+		m_Nodes.emplace_back(Node{Vector3(0.0f), 0, Vector3(0.0f), triangleCount});
+
+		Subdivide(0, 0, order, centroids, triangleMin, triangleMax);
+
+		m_Nodes.shrink_to_fit();
+
+		m_Vertices.reserve(triangleCount * 3);
+		m_TriangleIndices = std::move(order);
+
+		for (uint32_t triangle : m_TriangleIndices)
+		{
+			m_Vertices.push_back(positions[indices[triangle * 3 + 0]]);
+			m_Vertices.push_back(positions[indices[triangle * 3 + 1]]);
+			m_Vertices.push_back(positions[indices[triangle * 3 + 2]]);
+		}
+	}
+
+	void TriangleBVH::Subdivide(uint32_t nodeIndex, uint32_t depth, std::vector<uint32_t>& order, const std::vector<Vector3>& centroids, const std::vector<Vector3>& triangleMin, const std::vector<Vector3>& triangleMax)
+	{
+		uint32_t first = m_Nodes[nodeIndex].LeftOrFirst;
+		uint32_t count = m_Nodes[nodeIndex].TriangleCount;
+
+		Vector3 nodeMin(std::numeric_limits<float>::max());
+		Vector3 nodeMax(std::numeric_limits<float>::lowest());
+		Vector3 centroidMin = nodeMin;
+		Vector3 centroidMax = nodeMax;
+
+		for (uint32_t i = first; i < first + count; ++i)
+		{
+			uint32_t triangle = order[i];
+			nodeMin = glm::min(nodeMin, triangleMin[triangle]);
+			nodeMax = glm::max(nodeMax, triangleMax[triangle]);
+			centroidMin = glm::min(centroidMin, centroids[triangle]);
+			centroidMax = glm::max(centroidMax, centroids[triangle]);
+		}
+
+		m_Nodes[nodeIndex].Min = nodeMin;
+		m_Nodes[nodeIndex].Max = nodeMax;
+
+		if (count <= 1 || depth + 1 >= MaxDepth)
+			return;
+
+		struct Bin
+		{
+			Vector3 Min = Vector3(std::numeric_limits<float>::max());
+			Vector3 Max = Vector3(std::numeric_limits<float>::lowest());
+			uint32_t Count = 0;
+		};
+
+		float bestCost = std::numeric_limits<float>::max();
+		int bestAxis = -1;
+		uint32_t bestSplit = 0;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float extent = centroidMax[axis] - centroidMin[axis];
+
+			if (extent <= 0.0f)
+				continue;
+
+			Bin bins[SAHBinCount];
+			float binScale = (float)SAHBinCount / extent;
+
+			for (uint32_t i = first; i < first + count; ++i)
+			{
+				uint32_t triangle = order[i];
+				auto binIndex = std::min(SAHBinCount - 1, (uint32_t)((centroids[triangle][axis] - centroidMin[axis]) * binScale));
+				Bin& bin = bins[binIndex];
+				bin.Min = glm::min(bin.Min, triangleMin[triangle]);
+				bin.Max = glm::max(bin.Max, triangleMax[triangle]);
+				bin.Count++;
+			}
+
+			// Sweep from both sides to get the area and count of every split plane
+			float leftArea[SAHBinCount - 1];
+			uint32_t leftCount[SAHBinCount - 1];
+			Bin accumulated;
+			uint32_t accumulatedCount = 0;
+
+			for (uint32_t i = 0; i < SAHBinCount - 1; ++i)
+			{
+				accumulatedCount += bins[i].Count;
+				accumulated.Min = glm::min(accumulated.Min, bins[i].Min);
+				accumulated.Max = glm::max(accumulated.Max, bins[i].Max);
+				leftCount[i] = accumulatedCount;
+				leftArea[i] = accumulatedCount > 0 ? HalfSurfaceArea(accumulated.Min, accumulated.Max) : 0.0f;
+			}
+
+			accumulated = Bin();
+			accumulatedCount = 0;
+
+			for (uint32_t i = SAHBinCount - 1; i > 0; --i)
+			{
+				accumulatedCount += bins[i].Count;
+				accumulated.Min = glm::min(accumulated.Min, bins[i].Min);
+				accumulated.Max = glm::max(accumulated.Max, bins[i].Max);
+
+				float rightArea = accumulatedCount > 0 ? HalfSurfaceArea(accumulated.Min, accumulated.Max) : 0.0f;
+				float cost = (float)leftCount[i - 1] * leftArea[i - 1] + (float)accumulatedCount * rightArea;
+
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = i;
+				}
+			}
+		}
+
+		float nodeArea = HalfSurfaceArea(nodeMin, nodeMax);
+		float leafCost = (float)count;
+		float splitCost = nodeArea > 0.0f ? SAHTraversalCost + bestCost / nodeArea : leafCost;
+
+		if (bestAxis < 0 || (splitCost >= leafCost && count <= MaxLeafTriangles))
+			return;
+
+		float binScale = (float)SAHBinCount / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+
+		auto middle = std::partition(order.begin() + first, order.begin() + first + count, [&](uint32_t triangle) -> bool
+		{
+			auto binIndex = std::min(SAHBinCount - 1, (uint32_t)((centroids[triangle][bestAxis] - centroidMin[bestAxis]) * binScale));
+			return binIndex < bestSplit;
+		});
+
+		auto leftCount = (uint32_t)(middle - (order.begin() + first));
+
+		if (leftCount == 0 || leftCount == count)
+			return;
+
+		auto leftIndex = (uint32_t)m_Nodes.size();
+		m_Nodes.emplace_back(Node{Vector3(0.0f), first, Vector3(0.0f), leftCount});
+		m_Nodes.emplace_back(Node{Vector3(0.0f), first + leftCount, Vector3(0.0f), count - leftCount});
+
+		m_Nodes[nodeIndex].LeftOrFirst = leftIndex;
+		m_Nodes[nodeIndex].TriangleCount = 0;
+
+		Subdivide(leftIndex, depth + 1, order, centroids, triangleMin, triangleMax);
+		Subdivide(leftIndex + 1, depth + 1, order, centroids, triangleMin, triangleMax);
+	}
+
+	AABB TriangleBVH::GetBounds() const
+	{
+		if (m_Nodes.empty())
+			return {};
+
+		return {m_Nodes[0].Min, m_Nodes[0].Max};
+	}
+
+	bool TriangleBVH::RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, TriangleHit& hit) const
+	{
+		if (m_Nodes.empty())
+			return false;
+
+		// Division by zero gives infinity, which the slab test handles
+		Vector3 invDirection = 1.0f / direction;
+
+		float closest = maxDistance;
+		bool found = false;
+
+		if (RayBoxDistance(origin, invDirection, closest, m_Nodes[0].Min, m_Nodes[0].Max) == std::numeric_limits<float>::infinity())
+			return false;
+
+		uint32_t stack[MaxDepth];
+		uint32_t stackSize = 0;
+		uint32_t nodeIndex = 0;
+
+		while (true)
+		{
+			const Node& node = m_Nodes[nodeIndex];
+
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = node.LeftOrFirst; i < node.LeftOrFirst + node.TriangleCount; ++i)
+				{
+					float t, u, v;
+					if (RayTriangle(origin, direction, m_Vertices[i * 3 + 0], m_Vertices[i * 3 + 1], m_Vertices[i * 3 + 2], t, u, v) && t <= closest)
+					{
+						closest = t;
+						found = true;
+
+						hit.TriangleIndex = m_TriangleIndices[i];
+						hit.Distance = t;
+						hit.Barycentric = {u, v};
+						hit.Normal = glm::normalize(glm::cross(m_Vertices[i * 3 + 1] - m_Vertices[i * 3 + 0], m_Vertices[i * 3 + 2] - m_Vertices[i * 3 + 0]));
+					}
+				}
+
+				if (stackSize == 0)
+					break;
+
+				nodeIndex = stack[--stackSize];
+				continue;
+			}
+
+			uint32_t nearIndex = node.LeftOrFirst;
+			uint32_t farIndex = node.LeftOrFirst + 1;
+			float nearDistance = RayBoxDistance(origin, invDirection, closest, m_Nodes[nearIndex].Min, m_Nodes[nearIndex].Max);
+			float farDistance = RayBoxDistance(origin, invDirection, closest, m_Nodes[farIndex].Min, m_Nodes[farIndex].Max);
+
+			if (farDistance < nearDistance)
+			{
+				std::swap(nearIndex, farIndex);
+				std::swap(nearDistance, farDistance);
+			}
+
+			if (nearDistance == std::numeric_limits<float>::infinity())
+			{
+				if (stackSize == 0)
+					break;
+
+				nodeIndex = stack[--stackSize];
+				continue;
+			}
+
+			nodeIndex = nearIndex;
+
+			if (farDistance != std::numeric_limits<float>::infinity())
+				stack[stackSize++] = farIndex;
+		}
+
+		// Report the normal facing the ray
+		if (found && glm::dot(hit.Normal, direction) > 0.0f)
+			hit.Normal = -hit.Normal;
+
+		return found;
+	}
+
+	bool TriangleBVH::RayCast(const Matrix4& transform, const Vector3& origin, const Vector3& direction, float maxDistance, TriangleHit& hit) const
+	{
+		Matrix4 inverseTransform = glm::inverse(transform);
+
+		// The direction is transformed without normalizing, so the hit parameter stays in world units
+		Vector3 localOrigin = inverseTransform * Vector4(origin, 1.0f);
+		Vector3 localDirection = inverseTransform * Vector4(direction, 0.0f);
+
+		if (!RayCast(localOrigin, localDirection, maxDistance, hit))
+			return false;
+
+		hit.Normal = glm::normalize(Vector3(glm::transpose(inverseTransform) * Vector4(hit.Normal, 0.0f)));
+		return true;
+	}
+
+	bool TriangleBVH::OverlapsBox(const AABB& box) const
+	{
+		if (m_Nodes.empty())
+			return false;
+
+		const Vector3& boxMin = box.GetMin();
+		const Vector3& boxMax = box.GetMax();
+		Vector3 center = (boxMin + boxMax) * 0.5f;
+		Vector3 halfExtent = (boxMax - boxMin) * 0.5f;
+
+		uint32_t stack[MaxDepth];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const Node& node = m_Nodes[stack[--stackSize]];
+
+			if (!BoxesOverlap(node.Min, node.Max, boxMin, boxMax))
+				continue;
+
+			if (!node.IsLeaf())
+			{
+				stack[stackSize++] = node.LeftOrFirst;
+				stack[stackSize++] = node.LeftOrFirst + 1;
+				continue;
+			}
+
+			for (uint32_t i = node.LeftOrFirst; i < node.LeftOrFirst + node.TriangleCount; ++i)
+			{
+				if (TriangleOverlapsBox(center, halfExtent, m_Vertices[i * 3 + 0], m_Vertices[i * 3 + 1], m_Vertices[i * 3 + 2]))
+					return true;
+			}
+		}
+
+		return false;
+	}
+}
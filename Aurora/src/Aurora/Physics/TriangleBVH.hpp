@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Core/Math.hpp"
+#include "AABB.hpp"
+
+namespace Aurora
+{
+	struct TriangleHit
+	{
+		// Index of the triangle in the source index list, first index of the triangle is TriangleIndex * 3
+		uint32_t TriangleIndex;
+		// Ray parameter of the hit, equals distance when the direction is normalized
+		float Distance;
+		Vector2 Barycentric;
+		Vector3 Normal;
+	};
+
+	// Bounding volume hierarchy over static triangles, built with binned SAH and flattened to 32 byte nodes.
+	// Leaf triangles are copied in traversal order so a leaf reads one contiguous block of positions.
+	class AU_API TriangleBVH
+	{
+	public:
+		struct Node
+		{
+			Vector3 Min;
+			// First triangle for leaves, left child for inner nodes, the right child always follows the left one
+			uint32_t LeftOrFirst;
+			Vector3 Max;
+			uint32_t TriangleCount;
+
+			[[nodiscard]] inline bool IsLeaf() const { return TriangleCount > 0; }
+		};
+
+		static_assert(sizeof(Node) == 32, "TriangleBVH::Node must stay 32 bytes");
+
+		static constexpr uint32_t MaxLeafTriangles = 4;
+		static constexpr uint32_t MaxDepth = 64;
+	private:
+		std::vector<Node> m_Nodes;
+		std::vector<Vector3> m_Vertices;
+		std::vector<uint32_t> m_TriangleIndices;
+	public:
+		TriangleBVH() = default;
+
+		// Indices are a triangle list, degenerate triangles are kept so triangle indices stay stable
+		void Build(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices);
+
+		[[nodiscard]] bool IsEmpty() const { return m_Nodes.empty(); }
+		[[nodiscard]] size_t GetTriangleCount() const { return m_TriangleIndices.size(); }
+		[[nodiscard]] const std::vector<Node>& GetNodes() const { return m_Nodes; }
+		[[nodiscard]] AABB GetBounds() const;
+
+		// Closest two sided hit along the ray up to maxDistance, direction does not need to be normalized
+		bool RayCast(const Vector3& origin, const Vector3& direction, float maxDistance, TriangleHit& hit) const;
+		// World space ray against the hierarchy placed by transform, distance and normal of the hit are in world space
+		bool RayCast(const Matrix4& transform, const Vector3& origin, const Vector3& direction, float maxDistance, TriangleHit& hit) const;
+
+		[[nodiscard]] bool OverlapsBox(const AABB& box) const;
+	private:
+		void Subdivide(uint32_t nodeIndex, uint32_t depth, std::vector<uint32_t>& order, const std::vector<Vector3>& centroids, const std::vector<Vector3>& triangleMin, const std::vector<Vector3>& triangleMax);
+	};
+}
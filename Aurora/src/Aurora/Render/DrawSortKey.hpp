@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+namespace Aurora
+{
+	// 64-bit draw order key, most significant field first:
+	//   pass | program | material | mesh | lod | section | depth         (front to back)
+	//   pass | inverted depth | program | material | mesh | lod | section (back to front)
+	// Ids are wrapped to their field width, a collision only costs an extra state change because batching compares the real pointers.
+	namespace DrawSortKey
+	{
+		static constexpr uint32_t PassBits = 3;
+		static constexpr uint32_t ProgramBits = 12;
+		static constexpr uint32_t MaterialBits = 14;
+		static constexpr uint32_t MeshBits = 11;
+		static constexpr uint32_t LodBits = 3;
+		static constexpr uint32_t SectionBits = 8;
+		static constexpr uint32_t DepthBits = 13;
+
+		static_assert(PassBits + ProgramBits + MaterialBits + MeshBits + LodBits + SectionBits + DepthBits == 64, "Draw sort key must fill 64 bits");
+
+		static constexpr uint64_t Mask(uint32_t bits) { return (1ull << bits) - 1; }
+
+		// Positive floats keep their order when compared as integers, the top bits are a coarse logarithmic depth
+		inline uint64_t QuantizeDepth(float depth)
+		{
+			depth = std::max(depth, 0.0f);
+
+			uint32_t bits;
+			std::memcpy(&bits, &depth, sizeof(float));
+			return (bits >> (31 - DepthBits)) & Mask(DepthBits);
+		}
+
+		inline uint64_t Encode(uint32_t pass, uint32_t program, uint32_t material, uint32_t mesh, uint32_t lod, uint32_t section, float depth, bool backToFront)
+		{
+			uint64_t key = pass & Mask(PassBits);
+
+			if (backToFront)
+			{
+				key = (key << DepthBits) | (Mask(DepthBits) - QuantizeDepth(depth));
+			}
+
+			key = (key << ProgramBits) | (program & Mask(ProgramBits));
+			key = (key << MaterialBits) | (material & Mask(MaterialBits));
+			key = (key << MeshBits) | (mesh & Mask(MeshBits));
+			key = (key << LodBits) | (lod & Mask(LodBits));
+			key = (key << SectionBits) | (section & Mask(SectionBits));
+
+			if (!backToFront)
+			{
+				key = (key << DepthBits) | QuantizeDepth(depth);
+			}
+
+			return key;
+		}
+	}
+
+	// Stable LSD radix sort over the 64-bit Key member of Entry, one byte per pass.
+	// Passes where every key has the same byte are skipped, so keys with unused high fields cost less.
+	template<typename Entry>
+	void RadixSortByKey(std::vector<Entry>& entries, std::vector<Entry>& scratch)
+	{
+		const size_t count = entries.size();
+
+		if (count < 2)
+			return;
+
+		uint32_t histograms[8][256] = {};
+
+		for (const Entry& entry : entries)
+		{
+			for (uint32_t pass = 0; pass < 8; ++pass)
+			{
+				++histograms[pass][(entry.Key >> (pass * 8)) & 0xFF];
+			}
+		}
+
+		scratch.resize(count);
+
+		Entry* source = entries.data();
+		Entry* destination = scratch.data();
+
+		for (uint32_t pass = 0; pass < 8; ++pass)
+		{
+			uint32_t* histogram = histograms[pass];
+			uint32_t shift = pass * 8;
+
+			if (histogram[(source[0].Key >> shift) & 0xFF] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t digit = 0; digit < 256; ++digit)
+			{
+				uint32_t digitCount = histogram[digit];
+				histogram[digit] = offset;
+				offset += digitCount;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				destination[histogram[(source[i].Key >> shift) & 0xFF]++] = source[i];
+			}
+
+			std::swap(source, destination);
+		}
+
+		if (source != entries.data())
+		{
+			entries.swap(scratch);
+		}
+	}
+}
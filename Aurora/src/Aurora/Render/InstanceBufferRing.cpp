@@ -0,0 +1,68 @@
+#include "InstanceBufferRing.hpp"
+
+#include <algorithm>
+
+#include "Aurora/Engine.hpp"
+#include "Aurora/Core/Common.hpp"
+#include "Aurora/Core/String.hpp"
+#include "Aurora/Core/Profiler.hpp"
+#include "Aurora/Graphics/OpenGL/GLBufferLock.hpp"
+
+namespace Aurora
+{
+	InstanceBufferRing::InstanceBufferRing(uint32_t size) : m_Data(nullptr), m_Size(0), m_Alignment(1), m_Head(0), m_LockStart(0)
+	{
+		GLint alignment = 0;
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		m_Alignment = std::max<uint32_t>(alignment, 1);
+
+		CreateBuffer(Align(size));
+	}
+
+	InstanceBufferRing::~InstanceBufferRing() = default;
+
+	void InstanceBufferRing::CreateBuffer(uint32_t size)
+	{
+		// Dropping the old manager deletes its fences, the old buffer itself is kept alive by GL until the GPU is done with it
+		m_LockManager = std::make_unique<BufferLockManager>(true);
+		m_Buffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("Instances", size, EBufferType::ShaderStorageBuffer, EBufferUsage::DynamicDraw, true));
+		m_Data = GEngine->GetRenderDevice()->MapBuffer(m_Buffer, EBufferAccess::WriteOnly);
+		m_Size = size;
+		m_Head = 0;
+		m_LockStart = 0;
+	}
+
+	uint32_t InstanceBufferRing::Allocate(uint32_t size)
+	{
+		CPU_DEBUG_SCOPE("InstanceBufferRing::Allocate");
+
+		size = Align(size);
+
+		if (size > m_Size)
+		{
+			AU_LOG_WARNING("Instance ring of ", FormatBytes(m_Size), " is too small for ", FormatBytes(size), ", growing it");
+			CreateBuffer(Align(std::max(size, m_Size * 2)));
+		}
+		else if (m_Head + size > m_Size)
+		{
+			Lock();
+			m_Head = 0;
+			m_LockStart = 0;
+		}
+
+		m_LockManager->WaitForLockedRange(m_Head, size);
+
+		uint32_t offset = m_Head;
+		m_Head += size;
+		return offset;
+	}
+
+	void InstanceBufferRing::Lock()
+	{
+		if (m_Head > m_LockStart)
+		{
+			m_LockManager->LockRange(m_LockStart, m_Head - m_LockStart);
+			m_LockStart = m_Head;
+		}
+	}
+}
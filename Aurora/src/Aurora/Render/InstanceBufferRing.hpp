@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Graphics/Base/IRenderDevice.hpp"
+
+namespace Aurora
+{
+	class BufferLockManager;
+
+	// Persistently mapped storage buffer written as a ring.
+	// Every range handed out is fenced by Lock, the ring only blocks when it wraps onto a range the GPU still reads.
+	class AU_API InstanceBufferRing
+	{
+	public:
+		static constexpr uint32_t DefaultSize = 4 * 1024 * 1024;
+	private:
+		Buffer_ptr m_Buffer;
+		uint8_t* m_Data;
+		std::unique_ptr<BufferLockManager> m_LockManager;
+
+		uint32_t m_Size;
+		uint32_t m_Alignment;
+		uint32_t m_Head;
+		// Start of the ranges allocated since the last Lock
+		uint32_t m_LockStart;
+	public:
+		explicit InstanceBufferRing(uint32_t size = DefaultSize);
+		~InstanceBufferRing();
+
+		// Returns the offset of size writable bytes, the ring is grown when they do not fit at all
+		[[nodiscard]] uint32_t Allocate(uint32_t size);
+		// Fences everything allocated since the last Lock, call after submitting the draws that read it
+		void Lock();
+
+		// Offsets returned by Allocate are aligned for storage block binding, sizes should be padded the same way
+		[[nodiscard]] uint32_t Align(uint32_t size) const { return (size + m_Alignment - 1) / m_Alignment * m_Alignment; }
+
+		[[nodiscard]] uint8_t* GetData(uint32_t offset) const { return m_Data + offset; }
+		[[nodiscard]] const Buffer_ptr& GetBuffer() const { return m_Buffer; }
+	private:
+		void CreateBuffer(uint32_t size);
+	};
+}
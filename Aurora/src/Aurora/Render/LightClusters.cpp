@@ -0,0 +1,276 @@
+#include "LightClusters.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#include "Aurora/Engine.hpp"
+#include "Aurora/Core/Profiler.hpp"
+
+namespace Aurora
+{
+	// Projections with an infinite far plane are binned up to this multiple of the near plane
+	static constexpr float MaxClusterDepthRange = 10000.0f;
+
+	static bool IsPerspective(const Matrix4& projection)
+	{
+		return projection[3][3] == 0.0f;
+	}
+
+	// Near and far distances of an OpenGL style perspective projection
+	static void GetClipDistances(const Matrix4& projection, float& zNear, float& zFar)
+	{
+		zNear = projection[3][2] / (projection[2][2] - 1.0f);
+		zFar = std::abs(projection[2][2] + 1.0f) > 1e-6f ? projection[3][2] / (projection[2][2] + 1.0f) : zNear * MaxClusterDepthRange;
+		zFar = std::min(zFar, zNear * MaxClusterDepthRange);
+	}
+
+	LightClusters::LightClusters() = default;
+
+	void LightClusters::AddPointLight(const Vector3& position, float radius, const Vector3& color, float intensity)
+	{
+		m_Lights.push_back({Vector4(position, intensity), Vector4(color, radius)});
+	}
+
+	void LightClusters::Build(const Matrix4& view, const Matrix4& projection, const Vector2& viewPort)
+	{
+		CPU_DEBUG_SCOPE("LightClusters::Build");
+
+		Bin(view, projection, viewPort);
+		Upload();
+
+		m_Lights.clear();
+	}
+
+	void LightClusters::Bin(const Matrix4& view, const Matrix4& projection, const Vector2& viewPort)
+	{
+		m_Info.ClusterViewMatrix = view;
+
+		if (IsPerspective(projection))
+		{
+			float zNear, zFar;
+			GetClipDistances(projection, zNear, zFar);
+
+			m_Info.ClusterCountX = LIGHT_CLUSTERS_X;
+			m_Info.ClusterCountY = LIGHT_CLUSTERS_Y;
+			m_Info.ClusterCountZ = LIGHT_CLUSTERS_Z;
+			m_Info.ClusterDepthAndTileScale = Vector4(zNear, float(LIGHT_CLUSTERS_Z) / std::log(zFar / zNear), float(LIGHT_CLUSTERS_X) / viewPort.x, float(LIGHT_CLUSTERS_Y) / viewPort.y);
+
+			if (projection != m_ClusterProjection)
+			{
+				BuildClusterBounds(projection);
+			}
+		}
+		else
+		{
+			m_Info.ClusterCountX = 1;
+			m_Info.ClusterCountY = 1;
+			m_Info.ClusterCountZ = 1;
+			m_Info.ClusterDepthAndTileScale = Vector4(1.0f, 0.0f, 0.0f, 0.0f);
+		}
+
+		m_Info.ClusterLightCount = uint32_t(m_Lights.size());
+
+		BinLights(view, projection);
+	}
+
+	void LightClusters::BuildClusterBounds(const Matrix4& projection)
+	{
+		m_ClusterProjection = projection;
+
+		float zNear, zFar;
+		GetClipDistances(projection, zNear, zFar);
+
+		const Matrix4 inverseProjection = glm::inverse(projection);
+		const size_t clusterCount = LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y * LIGHT_CLUSTERS_Z;
+		m_ClusterMin.resize(clusterCount);
+		m_ClusterMax.resize(clusterCount);
+
+		// View space direction through a point of the near plane, scaled so its depth is one
+		auto rayAt = [&inverseProjection](float ndcX, float ndcY) -> Vector3
+		{
+			Vector4 point = inverseProjection * Vector4(ndcX, ndcY, -1.0f, 1.0f);
+			Vector3 position = Vector3(point) / point.w;
+			return position / -position.z;
+		};
+
+		for (uint32_t y = 0; y < LIGHT_CLUSTERS_Y; ++y)
+		{
+			for (uint32_t x = 0; x < LIGHT_CLUSTERS_X; ++x)
+			{
+				float x0 = -1.0f + 2.0f * float(x) / LIGHT_CLUSTERS_X;
+				float x1 = -1.0f + 2.0f * float(x + 1) / LIGHT_CLUSTERS_X;
+				float y0 = -1.0f + 2.0f * float(y) / LIGHT_CLUSTERS_Y;
+				float y1 = -1.0f + 2.0f * float(y + 1) / LIGHT_CLUSTERS_Y;
+
+				const Vector3 rays[4] = {rayAt(x0, y0), rayAt(x1, y0), rayAt(x0, y1), rayAt(x1, y1)};
+
+				for (uint32_t z = 0; z < LIGHT_CLUSTERS_Z; ++z)
+				{
+					float sliceNear = zNear * std::pow(zFar / zNear, float(z) / LIGHT_CLUSTERS_Z);
+					float sliceFar = zNear * std::pow(zFar / zNear, float(z + 1) / LIGHT_CLUSTERS_Z);
+
+					Vector3 min(std::numeric_limits<float>::max());
+					Vector3 max(std::numeric_limits<float>::lowest());
+
+					for (const Vector3& ray : rays)
+					{
+						min = glm::min(min, glm::min(ray * sliceNear, ray * sliceFar));
+						max = glm::max(max, glm::max(ray * sliceNear, ray * sliceFar));
+					}
+
+					size_t cluster = (z * LIGHT_CLUSTERS_Y + y) * LIGHT_CLUSTERS_X + x;
+					m_ClusterMin[cluster] = min;
+					m_ClusterMax[cluster] = max;
+				}
+			}
+		}
+	}
+
+	void LightClusters::BinLights(const Matrix4& view, const Matrix4& projection)
+	{
+		const uint32_t countX = m_Info.ClusterCountX;
+		const uint32_t countY = m_Info.ClusterCountY;
+		const uint32_t countZ = m_Info.ClusterCountZ;
+		const uint32_t clusterCount = countX * countY * countZ;
+
+		// (cluster << 32 | light) for every light touching a cluster, in light order
+		m_LightClusterPairs.clear();
+
+		const bool perspective = clusterCount > 1;
+		const float zNear = m_Info.ClusterDepthAndTileScale.x;
+		const float sliceScale = m_Info.ClusterDepthAndTileScale.y;
+		const float zFar = perspective ? zNear * std::exp(float(countZ) / sliceScale) : 0.0f;
+
+		for (uint32_t lightIndex = 0; lightIndex < uint32_t(m_Lights.size()); ++lightIndex)
+		{
+			const PointLightGPU& light = m_Lights[lightIndex];
+
+			if (!perspective)
+			{
+				m_LightClusterPairs.push_back(lightIndex);
+				continue;
+			}
+
+			const Vector3 center = Vector3(view * Vector4(Vector3(light.PositionIntensity), 1.0f));
+			const float radius = light.ColorRadius.w;
+
+			float depthMin = -center.z - radius;
+			float depthMax = -center.z + radius;
+
+			if (depthMax < zNear || depthMin > zFar)
+				continue;
+
+			depthMin = std::max(depthMin, zNear);
+			depthMax = std::min(depthMax, zFar);
+
+			auto sliceOf = [&](float depth) { return uint32_t(std::clamp(std::log(depth / zNear) * sliceScale, 0.0f, float(countZ - 1))); };
+			const uint32_t slice0 = sliceOf(depthMin);
+			const uint32_t slice1 = sliceOf(depthMax);
+
+			// Bounds of the projected box around the sphere, every corner lies in front of the near plane
+			Vector2 ndcMin(std::numeric_limits<float>::max());
+			Vector2 ndcMax(std::numeric_limits<float>::lowest());
+
+			for (uint32_t corner = 0; corner < 8; ++corner)
+			{
+				Vector4 point(center.x + ((corner & 1) ? radius : -radius),
+				              center.y + ((corner & 2) ? radius : -radius),
+				              (corner & 4) ? -depthMin : -depthMax, 1.0f);
+				Vector4 clip = projection * point;
+				Vector2 ndc = Vector2(clip) / clip.w;
+				ndcMin = glm::min(ndcMin, ndc);
+				ndcMax = glm::max(ndcMax, ndc);
+			}
+
+			if (ndcMax.x < -1.0f || ndcMax.y < -1.0f || ndcMin.x > 1.0f || ndcMin.y > 1.0f)
+				continue;
+
+			auto tileOf = [](float ndc, uint32_t count) { return uint32_t(std::clamp((ndc * 0.5f + 0.5f) * float(count), 0.0f, float(count - 1))); };
+			const uint32_t x0 = tileOf(ndcMin.x, countX), x1 = tileOf(ndcMax.x, countX);
+			const uint32_t y0 = tileOf(ndcMin.y, countY), y1 = tileOf(ndcMax.y, countY);
+
+			for (uint32_t z = slice0; z <= slice1; ++z)
+			{
+				for (uint32_t y = y0; y <= y1; ++y)
+				{
+					for (uint32_t x = x0; x <= x1; ++x)
+					{
+						uint32_t cluster = (z * countY + y) * countX + x;
+
+						// Sphere against the cluster box
+						Vector3 closest = glm::clamp(center, m_ClusterMin[cluster], m_ClusterMax[cluster]);
+						Vector3 offset = closest - center;
+
+						if (glm::dot(offset, offset) <= radius * radius)
+						{
+							m_LightClusterPairs.push_back((uint64_t(cluster) << 32) | lightIndex);
+						}
+					}
+				}
+			}
+		}
+
+		// Counting sort by cluster keeps the light order inside every cluster
+		m_Ranges.assign(clusterCount * 2, 0);
+
+		for (uint64_t pair : m_LightClusterPairs)
+		{
+			m_Ranges[(pair >> 32) * 2 + 1]++;
+		}
+
+		uint32_t offset = 0;
+		for (uint32_t cluster = 0; cluster < clusterCount; ++cluster)
+		{
+			m_Ranges[cluster * 2] = offset;
+			offset += m_Ranges[cluster * 2 + 1];
+			m_Ranges[cluster * 2 + 1] = 0;
+		}
+
+		m_Indices.resize(m_LightClusterPairs.size());
+
+		for (uint64_t pair : m_LightClusterPairs)
+		{
+			uint32_t cluster = uint32_t(pair >> 32);
+			m_Indices[m_Ranges[cluster * 2] + m_Ranges[cluster * 2 + 1]++] = uint32_t(pair & 0xFFFFFFFF);
+		}
+	}
+
+	void LightClusters::WriteGrowingBuffer(Buffer_ptr& buffer, const char* name, const void* data, size_t size)
+	{
+		// Empty storage buffers cannot be bound, keep at least a small one around
+		const size_t requiredSize = std::max<size_t>(size, 256);
+
+		if (buffer == nullptr || buffer->GetDesc().ByteSize < requiredSize)
+		{
+			buffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc(name, uint32_t(requiredSize + requiredSize / 2), EBufferType::ShaderStorageBuffer, EBufferUsage::DynamicDraw));
+		}
+
+		if (size > 0)
+		{
+			GEngine->GetRenderDevice()->WriteBuffer(buffer, data, size, 0);
+		}
+	}
+
+	void LightClusters::Upload()
+	{
+		// Created on the first upload, so the binning works without a render device
+		if (m_InfoBuffer == nullptr)
+		{
+			m_InfoBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("LightClusterInfo", sizeof(LightClusterInfo), EBufferType::UniformBuffer, EBufferUsage::DynamicDraw));
+		}
+
+		GEngine->GetRenderDevice()->WriteBuffer(m_InfoBuffer, &m_Info);
+
+		WriteGrowingBuffer(m_LightsBuffer, "ClusterPointLights", m_Lights.data(), m_Lights.size() * sizeof(PointLightGPU));
+		WriteGrowingBuffer(m_RangesBuffer, "ClusterRanges", m_Ranges.data(), m_Ranges.size() * sizeof(uint32_t));
+		WriteGrowingBuffer(m_IndicesBuffer, "ClusterLightIndices", m_Indices.data(), m_Indices.size() * sizeof(uint32_t));
+	}
+
+	void LightClusters::Bind(BaseState& state) const
+	{
+		state.BindUniformBuffer("LightClusterInfo", m_InfoBuffer);
+		state.BindSSBOBuffer("ClusterPointLights", m_LightsBuffer);
+		state.BindSSBOBuffer("ClusterRanges", m_RangesBuffer);
+		state.BindSSBOBuffer("ClusterLightIndices", m_IndicesBuffer);
+	}
+}
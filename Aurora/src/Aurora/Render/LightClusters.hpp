@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Core/Math.hpp"
+#include "Aurora/Graphics/Base/IRenderDevice.hpp"
+
+#include "Shaders/LightClusters.h"
+
+namespace Aurora
+{
+	// Bins point lights into a view space cluster grid on the CPU.
+	// Shaders include Shaders/LightClusters.h, find their cluster with GetLightCluster and loop only over its lights.
+	class AU_API LightClusters
+	{
+	private:
+		LightClusterInfo m_Info = {};
+
+		// View space bounds of every cluster, rebuilt when the projection changes
+		std::vector<Vector3> m_ClusterMin;
+		std::vector<Vector3> m_ClusterMax;
+		Matrix4 m_ClusterProjection = Matrix4(0.0f);
+
+		std::vector<PointLightGPU> m_Lights;
+		std::vector<uint64_t> m_LightClusterPairs;
+		std::vector<uint32_t> m_Ranges;
+		std::vector<uint32_t> m_Indices;
+
+		Buffer_ptr m_InfoBuffer;
+		Buffer_ptr m_LightsBuffer;
+		Buffer_ptr m_RangesBuffer;
+		Buffer_ptr m_IndicesBuffer;
+	public:
+		LightClusters();
+
+		void AddPointLight(const Vector3& position, float radius, const Vector3& color, float intensity);
+		// Lights binned by the last Bin or Build
+		[[nodiscard]] size_t GetPointLightCount() const { return m_Info.ClusterLightCount; }
+
+		// Bins the lights added since the last Build and uploads the grid, the lights are cleared afterwards
+		void Build(const Matrix4& view, const Matrix4& projection, const Vector2& viewPort);
+		// Only the CPU part of Build, the lights are kept
+		void Bin(const Matrix4& view, const Matrix4& projection, const Vector2& viewPort);
+		void Bind(BaseState& state) const;
+
+		// Offset and count per cluster into the indices, as written by the last Build
+		[[nodiscard]] const std::vector<uint32_t>& GetClusterRanges() const { return m_Ranges; }
+		[[nodiscard]] const std::vector<uint32_t>& GetClusterIndices() const { return m_Indices; }
+	private:
+		void BuildClusterBounds(const Matrix4& projection);
+		void BinLights(const Matrix4& view, const Matrix4& projection);
+		void Upload();
+		static void WriteGrowingBuffer(Buffer_ptr& buffer, const char* name, const void* data, size_t size);
+	};
+}
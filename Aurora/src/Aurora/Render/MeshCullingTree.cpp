@@ -0,0 +1,164 @@
+#include "MeshCullingTree.hpp"
+
+#include "Aurora/Core/Common.hpp"
+#include "Aurora/Core/Profiler.hpp"
+#include "Aurora/Framework/MeshComponent.hpp"
+#include "Aurora/Physics/Frustum.hpp"
+
+namespace Aurora
+{
+	// Dynamic boxes are grown by this fraction of their size, the tree is only touched when a component leaves its padded box
+	static constexpr float DynamicBoundsPadding = 0.1f;
+
+	static AABB PadBounds(const AABB& bounds)
+	{
+		Vector3 padding = (bounds.GetMax() - bounds.GetMin()) * DynamicBoundsPadding;
+		return {bounds.GetMin() - padding, bounds.GetMax() + padding};
+	}
+
+	MeshCullingTree::MeshCullingTree() : m_Tree(256)
+	{
+	}
+
+	void MeshCullingTree::Add(MeshComponent* meshComponent)
+	{
+		m_Pending.push_back(meshComponent);
+	}
+
+	void MeshCullingTree::Remove(MeshComponent* meshComponent)
+	{
+		if (m_Tree.ContainsObject(meshComponent))
+		{
+			m_Tree.RemoveObject(meshComponent);
+
+			// Tree entries that are not dynamic are static, the flag itself may already have changed
+			if (!VectorRemove(m_Dynamic, meshComponent))
+			{
+				++m_StaticVersion;
+			}
+		}
+
+		VectorRemove(m_Pending, meshComponent);
+
+		// Unculled entries do not remember if they were static, any of them may have been in a cached shadow
+		if (VectorRemove(m_Unculled, meshComponent))
+		{
+			++m_StaticVersion;
+		}
+	}
+
+	void MeshCullingTree::Refresh(MeshComponent* meshComponent)
+	{
+		Remove(meshComponent);
+		Add(meshComponent);
+	}
+
+	AABB MeshCullingTree::ComputeBounds(MeshComponent* meshComponent)
+	{
+		return meshComponent->GetMesh()->m_Bounds.Transform(meshComponent->GetRenderTransformationMatrix());
+	}
+
+	void MeshCullingTree::Update()
+	{
+		CPU_DEBUG_SCOPE("MeshCullingTree::Update");
+
+		for (size_t i = 0; i < m_Pending.size();)
+		{
+			MeshComponent* meshComponent = m_Pending[i];
+
+			if (!meshComponent->HasMesh())
+			{
+				++i;
+				continue;
+			}
+
+			if (meshComponent->IsIgnoringFrustumChecks())
+			{
+				m_Unculled.push_back(meshComponent);
+
+				if (meshComponent->IsStatic())
+					++m_StaticVersion;
+			}
+			else if (meshComponent->IsStatic())
+			{
+				m_Tree.InsertObject(meshComponent, ComputeBounds(meshComponent));
+				++m_StaticVersion;
+			}
+			else
+			{
+				m_Tree.InsertObject(meshComponent, PadBounds(ComputeBounds(meshComponent)));
+				m_Dynamic.push_back(meshComponent);
+			}
+
+			m_Pending[i] = m_Pending.back();
+			m_Pending.pop_back();
+		}
+
+		for (MeshComponent* meshComponent : m_Dynamic)
+		{
+			// A component that lost its mesh keeps its last box, it is skipped by the culling anyway
+			if (!meshComponent->HasMesh())
+				continue;
+
+			AABB bounds = ComputeBounds(meshComponent);
+
+			if (!m_Tree.GetObjectAABB(meshComponent).Contains(bounds))
+			{
+				m_Tree.UpdateObject(meshComponent, PadBounds(bounds));
+			}
+		}
+	}
+
+	void MeshCullingTree::Query(const FFrustum* const* frustums, size_t frustumCount, std::vector<MeshComponent*>& components, std::vector<uint32_t>& viewMasks) const
+	{
+		CPU_DEBUG_SCOPE("MeshCullingTree::Query");
+
+		struct QueryState
+		{
+			// Views the node touches
+			uint32_t Visible;
+			// Views the node is not fully inside of, only these are tested for the children
+			uint32_t Partial;
+		};
+
+		const uint32_t allViews = frustumCount >= 32 ? ~0u : (1u << frustumCount) - 1;
+
+		m_Tree.Traverse(QueryState{allViews, allViews}, [frustums, frustumCount](const AABB& aabb, const QueryState& parent, QueryState& state)
+		{
+			state = parent;
+
+			for (size_t v = 0; v < frustumCount && state.Partial; ++v)
+			{
+				const uint32_t bit = 1u << v;
+
+				if (!(parent.Partial & bit))
+					continue;
+
+				switch (frustums[v]->ClassifyBox(aabb.GetMin(), aabb.GetMax()))
+				{
+					case FFrustum::EContainment::Outside:
+						state.Visible &= ~bit;
+						state.Partial &= ~bit;
+						break;
+					case FFrustum::EContainment::Inside:
+						state.Partial &= ~bit;
+						break;
+					case FFrustum::EContainment::Intersects:
+						break;
+				}
+			}
+
+			return state.Visible != 0;
+		}, [&components, &viewMasks](MeshComponent* meshComponent, const QueryState& state)
+		{
+			components.push_back(meshComponent);
+			viewMasks.push_back(state.Visible);
+		});
+
+		for (MeshComponent* meshComponent : m_Unculled)
+		{
+			components.push_back(meshComponent);
+			viewMasks.push_back(allViews);
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Physics/AABBTree.hpp"
+
+namespace Aurora
+{
+	class MeshComponent;
+	class FFrustum;
+
+	// Dynamic AABB tree over the world bounds of the MeshComponents of a scene, owned by the Scene.
+	// Components enter the tree once they have a mesh. Dynamic components are refreshed every Update and keep a padded box,
+	// so small moves do not touch the tree. Static components are only read on insertion, the Scene refreshes them when
+	// they move. Call Refresh after changing the mesh or the frustum flag, SetStatic refreshes the component itself.
+	class AU_API MeshCullingTree
+	{
+	private:
+		AABBTree<MeshComponent> m_Tree;
+		// Registered components waiting for a mesh
+		std::vector<MeshComponent*> m_Pending;
+		std::vector<MeshComponent*> m_Dynamic;
+		// Components ignoring frustum checks are kept out of the tree and returned by every query
+		std::vector<MeshComponent*> m_Unculled;
+		// Bumped when a static component enters or leaves the tree or the unculled list, lights caching static shadows compare it
+		uint32_t m_StaticVersion = 0;
+	public:
+		MeshCullingTree();
+
+		void Add(MeshComponent* meshComponent);
+		void Remove(MeshComponent* meshComponent);
+		// Reads the component again on the next Update
+		void Refresh(MeshComponent* meshComponent);
+
+		// Inserts the pending components and refits the dynamic ones
+		void Update();
+
+		// Appends every component whose box touches at least one of the frustums, with bit v of its mask set when it touches frustums[v].
+		// Subtrees fully inside a frustum are accepted for it without testing their children.
+		void Query(const FFrustum* const* frustums, size_t frustumCount, std::vector<MeshComponent*>& components, std::vector<uint32_t>& viewMasks) const;
+
+		[[nodiscard]] const AABBTree<MeshComponent>& GetTree() const { return m_Tree; }
+		[[nodiscard]] uint32_t GetStaticVersion() const { return m_StaticVersion; }
+	private:
+		[[nodiscard]] static AABB ComputeBounds(MeshComponent* meshComponent);
+	};
+}
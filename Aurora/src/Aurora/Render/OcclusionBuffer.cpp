@@ -0,0 +1,365 @@
+#include "OcclusionBuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Aurora/Core/WorkerPool.hpp"
+#include "Aurora/Physics/Frustum.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define AU_OCCLUSION_SSE 1
+#endif
+
+namespace Aurora
+{
+	static_assert(OcclusionBuffer::Width % OcclusionBuffer::TileSize == 0 && OcclusionBuffer::Height % OcclusionBuffer::TileSize == 0, "Occlusion buffer has to be made of whole tiles");
+	static_assert(OcclusionBuffer::TileSize % 4 == 0, "Tiles are rasterized 4 pixels at a time");
+
+	// Vertices closer than this to the eye plane count as behind the camera
+	static constexpr float MinClipW = 1e-5f;
+
+	static Vector4 Transform(const Matrix4& matrix, const Vector3& position)
+	{
+		return matrix * Vector4(position, 1.0f);
+	}
+
+	OcclusionBuffer::OcclusionBuffer() : m_ViewProjection(1.0f), m_TileTriangles(TilesX * TilesY)
+	{
+		for (uint32_t width = Width, height = Height; ; width = std::max(width / 2, 1u), height = std::max(height / 2, 1u))
+		{
+			m_Levels.emplace_back(width * height, 1.0f);
+
+			if (width == 1 && height == 1)
+				break;
+		}
+	}
+
+	void OcclusionBuffer::Begin(const Matrix4& viewProjection)
+	{
+		m_ViewProjection = viewProjection;
+		m_Triangles.clear();
+
+		for (std::vector<uint32_t>& tileTriangles : m_TileTriangles)
+		{
+			tileTriangles.clear();
+		}
+	}
+
+	void OcclusionBuffer::AddOccluder(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices, const Matrix4& transform)
+	{
+		const Matrix4 matrix = m_ViewProjection * transform;
+
+		m_ClipVertices.resize(positions.size());
+		for (size_t i = 0; i < positions.size(); ++i)
+		{
+			m_ClipVertices[i] = Transform(matrix, positions[i]);
+		}
+
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const Vector4& v0 = m_ClipVertices[indices[i]];
+			const Vector4& v1 = m_ClipVertices[indices[i + 1]];
+			const Vector4& v2 = m_ClipVertices[indices[i + 2]];
+
+			// Fully outside one of the side planes
+			if ((v0.x > v0.w && v1.x > v1.w && v2.x > v2.w) || (v0.x < -v0.w && v1.x < -v1.w && v2.x < -v2.w) ||
+			    (v0.y > v0.w && v1.y > v1.w && v2.y > v2.w) || (v0.y < -v0.w && v1.y < -v1.w && v2.y < -v2.w))
+				continue;
+
+			// Clip against the near plane, z >= -w, which leaves at most a quad
+			const Vector4* input[3] = {&v0, &v1, &v2};
+			Vector4 output[4];
+			uint32_t outputCount = 0;
+
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				const Vector4& a = *input[k];
+				const Vector4& b = *input[(k + 1) % 3];
+				float distanceA = a.z + a.w;
+				float distanceB = b.z + b.w;
+
+				if (distanceA >= 0.0f)
+					output[outputCount++] = a;
+
+				if ((distanceA >= 0.0f) != (distanceB >= 0.0f))
+				{
+					float t = distanceA / (distanceA - distanceB);
+					output[outputCount++] = a + (b - a) * t;
+				}
+			}
+
+			if (outputCount >= 3)
+				AddClippedTriangle(output[0], output[1], output[2]);
+
+			if (outputCount == 4)
+				AddClippedTriangle(output[0], output[2], output[3]);
+		}
+	}
+
+	void OcclusionBuffer::AddClippedTriangle(const Vector4& v0, const Vector4& v1, const Vector4& v2)
+	{
+		const Vector4* clip[3] = {&v0, &v1, &v2};
+		Vector3 screen[3];
+
+		// Depth is not clamped, that would pull the triangle closer. Texels past the far plane keep the cleared 1.0.
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			float w = std::max(clip[k]->w, MinClipW);
+			screen[k] = Vector3((clip[k]->x / w * 0.5f + 0.5f) * float(Width),
+			                    (clip[k]->y / w * 0.5f + 0.5f) * float(Height),
+			                    clip[k]->z / w * 0.5f + 0.5f);
+		}
+
+		float area = (screen[1].x - screen[0].x) * (screen[2].y - screen[0].y) - (screen[2].x - screen[0].x) * (screen[1].y - screen[0].y);
+
+		if (area == 0.0f)
+			return;
+
+		// Counter clockwise on screen, so the edge functions are positive inside. Both faces are rasterized.
+		if (area < 0.0f)
+			std::swap(screen[1], screen[2]);
+
+		float minX = std::min({screen[0].x, screen[1].x, screen[2].x});
+		float maxX = std::max({screen[0].x, screen[1].x, screen[2].x});
+		float minY = std::min({screen[0].y, screen[1].y, screen[2].y});
+		float maxY = std::max({screen[0].y, screen[1].y, screen[2].y});
+
+		if (maxX < 0.0f || maxY < 0.0f || minX >= float(Width) || minY >= float(Height))
+			return;
+
+		const auto triangle = uint32_t(m_Triangles.size());
+		m_Triangles.push_back({screen[0], screen[1], screen[2]});
+
+		const auto tileX0 = uint32_t(std::clamp(minX, 0.0f, float(Width - 1))) / TileSize;
+		const auto tileX1 = uint32_t(std::clamp(maxX, 0.0f, float(Width - 1))) / TileSize;
+		const auto tileY0 = uint32_t(std::clamp(minY, 0.0f, float(Height - 1))) / TileSize;
+		const auto tileY1 = uint32_t(std::clamp(maxY, 0.0f, float(Height - 1))) / TileSize;
+
+		for (uint32_t tileY = tileY0; tileY <= tileY1; ++tileY)
+		{
+			for (uint32_t tileX = tileX0; tileX <= tileX1; ++tileX)
+			{
+				m_TileTriangles[tileY * TilesX + tileX].push_back(triangle);
+			}
+		}
+	}
+
+	void OcclusionBuffer::Finish(WorkerPool* workerPool)
+	{
+		if (workerPool)
+		{
+			workerPool->ParallelFor(TilesX * TilesY, 1, [this](uint32_t chunk, size_t begin, size_t end)
+			{
+				for (size_t tile = begin; tile < end; ++tile)
+				{
+					RasterizeTile(uint32_t(tile));
+				}
+			});
+		}
+		else
+		{
+			for (uint32_t tile = 0; tile < TilesX * TilesY; ++tile)
+			{
+				RasterizeTile(tile);
+			}
+		}
+
+		BuildLevels();
+	}
+
+	void OcclusionBuffer::RasterizeTile(uint32_t tile)
+	{
+		const uint32_t tileX0 = (tile % TilesX) * TileSize;
+		const uint32_t tileY0 = (tile / TilesX) * TileSize;
+		float* depth = m_Levels[0].data();
+
+		for (uint32_t y = tileY0; y < tileY0 + TileSize; ++y)
+		{
+			std::fill_n(depth + y * Width + tileX0, TileSize, 1.0f);
+		}
+
+		for (uint32_t triangleIndex : m_TileTriangles[tile])
+		{
+			const ScreenTriangle& triangle = m_Triangles[triangleIndex];
+			const Vector3& p0 = triangle.V0;
+			const Vector3& p1 = triangle.V1;
+			const Vector3& p2 = triangle.V2;
+
+			// Edge functions A * x + B * y + C, positive on the inner side of the edge
+			const float a0 = p0.y - p1.y, b0 = p1.x - p0.x, c0 = (p1.y - p0.y) * p0.x - (p1.x - p0.x) * p0.y;
+			const float a1 = p1.y - p2.y, b1 = p2.x - p1.x, c1 = (p2.y - p1.y) * p1.x - (p2.x - p1.x) * p1.y;
+			const float a2 = p2.y - p0.y, b2 = p0.x - p2.x, c2 = (p0.y - p2.y) * p2.x - (p0.x - p2.x) * p2.y;
+
+			const float area = c0 + c1 + c2;
+
+			// Depth is affine in screen space: barycentric weight of p1 is edge 2 and of p2 is edge 0
+			const float dz1 = (p1.z - p0.z) / area, dz2 = (p2.z - p0.z) / area;
+			const float za = a2 * dz1 + a0 * dz2;
+			const float zb = b2 * dz1 + b0 * dz2;
+			const float zc = p0.z + c2 * dz1 + c0 * dz2;
+
+			const float minX = std::min({p0.x, p1.x, p2.x}), maxX = std::max({p0.x, p1.x, p2.x});
+			const float minY = std::min({p0.y, p1.y, p2.y}), maxY = std::max({p0.y, p1.y, p2.y});
+
+			// Pixel centers inside the triangle bounds, x is aligned down to a group of 4
+			const uint32_t x0 = uint32_t(std::clamp(std::floor(minX), float(tileX0), float(tileX0 + TileSize - 1))) & ~3u;
+			const uint32_t x1 = uint32_t(std::clamp(std::ceil(maxX), float(tileX0), float(tileX0 + TileSize)));
+			const uint32_t y0 = uint32_t(std::clamp(std::floor(minY), float(tileY0), float(tileY0 + TileSize - 1)));
+			const uint32_t y1 = uint32_t(std::clamp(std::ceil(maxY), float(tileY0), float(tileY0 + TileSize)));
+
+#if defined(AU_OCCLUSION_SSE)
+			const __m128 stepX = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+			const __m128 zero = _mm_setzero_ps();
+
+			for (uint32_t y = y0; y < y1; ++y)
+			{
+				const float py = float(y) + 0.5f;
+				const __m128 rowE0 = _mm_set1_ps(b0 * py + c0);
+				const __m128 rowE1 = _mm_set1_ps(b1 * py + c1);
+				const __m128 rowE2 = _mm_set1_ps(b2 * py + c2);
+				const __m128 rowZ = _mm_set1_ps(zb * py + zc);
+				float* row = depth + y * Width;
+
+				for (uint32_t x = x0; x < x1; x += 4)
+				{
+					__m128 px = _mm_add_ps(_mm_set1_ps(float(x)), stepX);
+					__m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a0), px), rowE0);
+					__m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a1), px), rowE1);
+					__m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a2), px), rowE2);
+					__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+
+					if (_mm_movemask_ps(inside) == 0)
+						continue;
+
+					__m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(za), px), rowZ);
+					__m128 current = _mm_loadu_ps(row + x);
+					__m128 nearest = _mm_min_ps(current, z);
+					_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+				}
+			}
+#else
+			for (uint32_t y = y0; y < y1; ++y)
+			{
+				const float py = float(y) + 0.5f;
+				float* row = depth + y * Width;
+
+				for (uint32_t x = x0; x < x1; ++x)
+				{
+					const float px = float(x) + 0.5f;
+
+					if (a0 * px + b0 * py + c0 < 0.0f || a1 * px + b1 * py + c1 < 0.0f || a2 * px + b2 * py + c2 < 0.0f)
+						continue;
+
+					row[x] = std::min(row[x], za * px + zb * py + zc);
+				}
+			}
+#endif
+		}
+	}
+
+	void OcclusionBuffer::BuildLevels()
+	{
+		uint32_t width = Width, height = Height;
+
+		for (size_t level = 1; level < m_Levels.size(); ++level)
+		{
+			const std::vector<float>& source = m_Levels[level - 1];
+			std::vector<float>& destination = m_Levels[level];
+
+			const uint32_t sourceWidth = width, sourceHeight = height;
+			width = std::max(width / 2, 1u);
+			height = std::max(height / 2, 1u);
+
+			for (uint32_t y = 0; y < height; ++y)
+			{
+				for (uint32_t x = 0; x < width; ++x)
+				{
+					const uint32_t sx = std::min(x * 2, sourceWidth - 1), sx1 = std::min(x * 2 + 1, sourceWidth - 1);
+					const uint32_t sy = std::min(y * 2, sourceHeight - 1), sy1 = std::min(y * 2 + 1, sourceHeight - 1);
+
+					destination[y * width + x] = std::max(std::max(source[sy * sourceWidth + sx], source[sy * sourceWidth + sx1]),
+					                                      std::max(source[sy1 * sourceWidth + sx], source[sy1 * sourceWidth + sx1]));
+				}
+			}
+		}
+	}
+
+	bool OcclusionBuffer::IsBoxVisible(const Vector3& center, const Vector3& extent) const
+	{
+		Vector2 screenMin(std::numeric_limits<float>::max());
+		Vector2 screenMax(std::numeric_limits<float>::lowest());
+		float nearestDepth = 1.0f;
+
+		for (uint32_t corner = 0; corner < 8; ++corner)
+		{
+			Vector3 position(center.x + ((corner & 1) ? extent.x : -extent.x),
+			                 center.y + ((corner & 2) ? extent.y : -extent.y),
+			                 center.z + ((corner & 4) ? extent.z : -extent.z));
+			Vector4 clip = Transform(m_ViewProjection, position);
+
+			// Boxes crossing the near plane are too close to be hidden
+			if (clip.w < MinClipW || clip.z < -clip.w)
+				return true;
+
+			float x = (clip.x / clip.w * 0.5f + 0.5f) * float(Width);
+			float y = (clip.y / clip.w * 0.5f + 0.5f) * float(Height);
+			screenMin = Vector2(std::min(screenMin.x, x), std::min(screenMin.y, y));
+			screenMax = Vector2(std::max(screenMax.x, x), std::max(screenMax.y, y));
+			nearestDepth = std::min(nearestDepth, clip.z / clip.w * 0.5f + 0.5f);
+		}
+
+		// Off screen boxes are left to the frustum test
+		if (screenMax.x < 0.0f || screenMax.y < 0.0f || screenMin.x >= float(Width) || screenMin.y >= float(Height))
+			return true;
+
+		auto x0 = uint32_t(std::clamp(screenMin.x, 0.0f, float(Width - 1)));
+		auto x1 = uint32_t(std::clamp(screenMax.x, 0.0f, float(Width - 1)));
+		auto y0 = uint32_t(std::clamp(screenMin.y, 0.0f, float(Height - 1)));
+		auto y1 = uint32_t(std::clamp(screenMax.y, 0.0f, float(Height - 1)));
+
+		// Coarsest level where the box spans at most 2x2 texels
+		uint32_t level = 0;
+		while ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)
+			++level;
+
+		const std::vector<float>& depth = m_Levels[level];
+		const uint32_t levelWidth = std::max(Width >> level, 1u);
+
+		for (uint32_t y = y0 >> level; y <= (y1 >> level); ++y)
+		{
+			for (uint32_t x = x0 >> level; x <= (x1 >> level); ++x)
+			{
+				if (nearestDepth <= depth[y * levelWidth + x])
+					return true;
+			}
+		}
+
+		return false;
+	}
+
+	void OcclusionBuffer::CullBoxes(const FBoundsSoA& bounds, std::vector<uint64_t>& visibility) const
+	{
+		for (size_t i = 0; i < bounds.Size(); ++i)
+		{
+			// Whole words of hidden boxes are skipped
+			if (visibility[i >> 6] == 0)
+			{
+				i |= 63;
+				continue;
+			}
+
+			if (!IsVisibleInMask(visibility, i))
+				continue;
+
+			Vector3 center(bounds.CenterX[i], bounds.CenterY[i], bounds.CenterZ[i]);
+			Vector3 extent(bounds.ExtentX[i], bounds.ExtentY[i], bounds.ExtentZ[i]);
+
+			if (!IsBoxVisible(center, extent))
+			{
+				visibility[i >> 6] &= ~(uint64_t(1) << (i & 63));
+			}
+		}
+	}
+}
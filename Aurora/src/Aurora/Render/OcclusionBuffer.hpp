@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+#include "Aurora/Core/Library.hpp"
+#include "Aurora/Core/Math.hpp"
+
+namespace Aurora
+{
+	struct FBoundsSoA;
+	class WorkerPool;
+
+	// Low resolution depth buffer rasterized on the CPU from occluder meshes.
+	// Occluders keep their nearest depth per pixel, the hierarchical levels keep the farthest depth of every 2x2 block,
+	// so a box is hidden when its nearest point lies behind every texel it covers.
+	// Depth is normalized device depth mapped to 0 (near) .. 1 (far).
+	class AU_API OcclusionBuffer
+	{
+	public:
+		static constexpr uint32_t Width = 256;
+		static constexpr uint32_t Height = 128;
+		// Triangles are binned into tiles of this size, tiles are rasterized independently
+		static constexpr uint32_t TileSize = 32;
+		static constexpr uint32_t TilesX = Width / TileSize;
+		static constexpr uint32_t TilesY = Height / TileSize;
+	private:
+		struct ScreenTriangle
+		{
+			Vector3 V0, V1, V2;
+		};
+
+		Matrix4 m_ViewProjection;
+		std::vector<ScreenTriangle> m_Triangles;
+		std::vector<std::vector<uint32_t>> m_TileTriangles;
+		// Level 0 is the rasterized depth, every next level halves the resolution
+		std::vector<std::vector<float>> m_Levels;
+		std::vector<Vector4> m_ClipVertices;
+	public:
+		OcclusionBuffer();
+
+		// Starts a new frame, previous occluders are dropped
+		void Begin(const Matrix4& viewProjection);
+		// Transforms, clips and bins the triangles, positions are in the space transform maps to world
+		void AddOccluder(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices, const Matrix4& transform);
+		[[nodiscard]] bool HasOccluders() const { return !m_Triangles.empty(); }
+		// Rasterizes the binned triangles and builds the hierarchical levels, tiles are spread over the pool when given
+		void Finish(WorkerPool* workerPool = nullptr);
+
+		[[nodiscard]] bool IsBoxVisible(const Vector3& center, const Vector3& extent) const;
+		// Clears the bit of every visible box that is occluded
+		void CullBoxes(const FBoundsSoA& bounds, std::vector<uint64_t>& visibility) const;
+
+		[[nodiscard]] const std::vector<float>& GetDepth() const { return m_Levels[0]; }
+		[[nodiscard]] size_t GetTriangleCount() const { return m_Triangles.size(); }
+	private:
+		void AddClippedTriangle(const Vector4& v0, const Vector4& v1, const Vector4& v2);
+		void RasterizeTile(uint32_t tile);
+		void BuildLevels();
+	};
+}
@@ -21,6 +21,5 @@ namespace Aurora
 	void PostProcessEffect::RenderState(const DrawCallState& state)
 	{
 		GEngine->GetRenderDevice()->Draw(state, {DrawArguments(4)});
-		GEngine->GetRenderManager()->GetUniformBufferCache().Reset();
 	}
 }
\ No newline at end of file
@@ -1,9 +1,13 @@
 #include "SceneRenderer.hpp"
 
+#include <cstring>
+
 #include "Aurora/Core/Profiler.hpp"
+#include "Aurora/Core/WorkerPool.hpp"
 #include "Aurora/Framework/Scene.hpp"
 #include "Aurora/Framework/CameraComponent.hpp"
 #include "Aurora/Framework/MeshComponent.hpp"
+#include "Aurora/Framework/Lights.hpp"
 
 #include "Aurora/Resource/ResourceManager.hpp"
 
@@ -12,9 +16,16 @@
 
 namespace Aurora
 {
+	// Below these sizes a chunk costs more to hand to a worker than to process inline
+	static constexpr size_t MinMeshComponentsPerChunk = 256;
+	static constexpr size_t MinEntitiesPerSortChunk = 2048;
+
+
 	SceneRenderer::SceneRenderer()
 	{
-		m_InstancesBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("Instances", sizeof(Matrix4) * MaxInstances, EBufferType::UniformBuffer, EBufferUsage::DynamicDraw, false));
+		m_VisibilityWorkers = std::make_unique<WorkerPool>("Visibility");
+		m_ChunkVisibleEntities.resize(m_VisibilityWorkers->GetMaxChunks());
+
 		m_BaseVsDataBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("BaseVSData", sizeof(BaseVSData), EBufferType::UniformBuffer));
 		m_GlobDataBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("GlobData", sizeof(GLOB_Data), EBufferType::UniformBuffer));
 		m_BonesBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("Bones", sizeof(Matrix4) * MAX_BONES, EBufferType::UniformBuffer));
@@ -29,6 +40,8 @@ namespace Aurora
 		m_BloomDescBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("BloomDesc", sizeof(BloomDesc), EBufferType::UniformBuffer, EBufferUsage::DynamicDraw));
 	}
 
+	SceneRenderer::~SceneRenderer() = default;
+
 	void SceneRenderer::LoadShaders()
 	{
 		m_BloomShader = GEngine->GetResourceManager()->LoadComputeShader("Assets/Shaders/PostProcess/bloom.glsl");
@@ -39,6 +52,37 @@ namespace Aurora
 		});
 	}
 
+	VisibilityView SceneRenderer::MakeVisibilityView(CameraComponent* camera) const
+	{
+		VisibilityView view = {Vector3(0.0f), 0.0f};
+
+		if (camera)
+		{
+			view.Origin = camera->GetRenderTransformationMatrix()[3];
+
+			// Projection [1][1] is 1 / tan(fov / 2), radius times that over distance is the diameter relative to the view height
+			if (camera->GetProjectionType() == CameraComponent::ProjectionType::Perspective)
+			{
+				view.LodScale = camera->GetProjectionMatrix()[1][1] * std::exp2(-m_LodBias);
+			}
+		}
+
+		return view;
+	}
+
+	CullView SceneRenderer::MakeCameraCullView(CameraComponent* camera, const FFrustum& frustum)
+	{
+		CullView view = {&frustum, MakeVisibilityView(camera), nullptr, Matrix4(1.0f)};
+
+		if (m_OcclusionCulling && camera && camera->GetProjectionType() == CameraComponent::ProjectionType::Perspective)
+		{
+			view.Occlusion = &m_OcclusionBuffer;
+			view.ViewProjection = camera->GetProjectionMatrix() * camera->GetViewMatrix();
+		}
+
+		return view;
+	}
+
 	void SceneRenderer::PrepareMeshComponent(MeshComponent* meshComponent, CameraComponent* camera, const FFrustum& frustum)
 	{
 		if(!meshComponent->HasMesh() || !meshComponent->IsActive() || !meshComponent->IsParentActive())
@@ -46,28 +90,68 @@ namespace Aurora
 			return;
 		}
 
-		Matrix4 transform = meshComponent->GetTransformationMatrix();
+		Matrix4 transform = meshComponent->GetRenderTransformationMatrix();
 		Mesh_ptr mesh = meshComponent->GetMesh();
+		AABB bounds = mesh->m_Bounds.Transform(transform);
 
-		if (not frustum.IsBoxVisible(mesh->m_Bounds.Transform(transform)) &&  not meshComponent->IsIgnoringFrustumChecks())
+		if (not frustum.IsBoxVisible(bounds) &&  not meshComponent->IsIgnoringFrustumChecks())
 		{
 			return;
 		}
 
-		// TODO: Complete lod switching
-		LOD lod = 0;
-		const MeshLodResource& lodResource = mesh->LODResources[lod];
+		float boundsRadius = glm::length(bounds.GetMax() - bounds.GetMin()) * 0.5f;
+		AddVisibleMeshComponent(meshComponent, transform, boundsRadius, MakeVisibilityView(camera), m_VisibleEntities);
+	}
+
+	void SceneRenderer::AddVisibleMeshComponent(MeshComponent* meshComponent, const Matrix4& transform, float boundsRadius, const VisibilityView& view, VisibleEntitySet& visibleEntities)
+	{
+		Mesh* mesh = meshComponent->GetMesh().get();
+		float depth = glm::length(Vector3(transform[3]) - view.Origin);
+
+		LOD lod = meshComponent->m_CurrentLod;
+
+		if (view.LodScale > 0.0f)
+		{
+			float screenSize = boundsRadius * view.LodScale / std::max(depth, 0.0001f);
+			lod = mesh->SelectLOD(screenSize, lod);
+			meshComponent->m_CurrentLod = lod;
+		}
+
+		auto lodIt = mesh->LODResources.find(lod);
+
+		if (lodIt == mesh->LODResources.end())
+		{
+			lod = 0;
+			lodIt = mesh->LODResources.find(lod);
+
+			if (lodIt == mesh->LODResources.end())
+			{
+				return;
+			}
+		}
+
+		const MeshLodResource& lodResource = lodIt->second;
+		const MaterialSet& componentSlots = meshComponent->GetMaterialSet();
 
 		for (int sectionID = 0; sectionID < lodResource.Sections.size(); ++sectionID)
 		{
 			const FMeshSection& meshSection = lodResource.Sections[sectionID];
 			int32_t materialIndex = meshSection.MaterialIndex;
 
-			Material_ptr material = meshComponent->GetMaterialSlot(materialIndex).Material;
+			// Lookups must not insert missing slots, other threads read the same maps
+			Material* material = nullptr;
+
+			if (auto slotIt = componentSlots.find(materialIndex); slotIt != componentSlots.end())
+			{
+				material = slotIt->second.Material.get();
+			}
 
 			if(!material)
 			{
-				material = mesh->MaterialSlots[materialIndex].Material;
+				if (auto slotIt = mesh->MaterialSlots.find(materialIndex); slotIt != mesh->MaterialSlots.end())
+				{
+					material = slotIt->second.Material.get();
+				}
 			}
 
 			if(!material)
@@ -79,130 +163,383 @@ namespace Aurora
 
 			{
 				VisibleEntity visibleEntity;
-				visibleEntity.Material = material.get();
+				visibleEntity.Material = material;
 				visibleEntity.MeshComponent = meshComponent;
-				visibleEntity.Mesh = mesh.get();
+				visibleEntity.Mesh = mesh;
 				visibleEntity.MeshSection = sectionID;
 				visibleEntity.Lod = lod;
 				visibleEntity.Transform = transform;
+				visibleEntity.Depth = depth;
 
-				m_VisibleEntities[(uint8)renderSortType].emplace_back(visibleEntity);
+				visibleEntities[(uint8)renderSortType].emplace_back(visibleEntity);
 			}
 		}
 	}
 
 	void SceneRenderer::PrepareVisibleEntities(Scene* scene, CameraComponent* camera, const FFrustum& frustum)
 	{
-		for (MeshComponent* meshComponent : scene->GetComponents<MeshComponent>())
-		{
-			PrepareMeshComponent(meshComponent, camera, frustum);
-		}
+		CPU_DEBUG_SCOPE("PrepareVisibleEntities");
+
+		CullView view = MakeCameraCullView(camera, frustum);
+		CullScene(scene, &view, 1, &m_VisibleEntities);
 	}
 
-	void SceneRenderer::PrepareVisibleEntities(Actor* actor, CameraComponent* camera, const FFrustum& frustum)
+	void SceneRenderer::PrepareVisibleEntities(Scene* scene, const std::vector<CullView>& views)
 	{
-		for (MeshComponent* meshComponent : actor->FindComponentsOfType<MeshComponent>())
+		CPU_DEBUG_SCOPE("PrepareVisibleEntitiesMultiView");
+
+		if (views.size() > MaxCullViews)
 		{
-			PrepareMeshComponent(meshComponent, camera, frustum);
+			AU_LOG_ERROR("Cannot cull more than ", MaxCullViews, " views at once, got ", views.size());
+			return;
+		}
+
+		m_ViewVisibleEntities.resize(views.size());
+
+		for (VisibleEntitySet& visibleEntities : m_ViewVisibleEntities)
+		{
+			for (std::vector<VisibleEntity>& entities : visibleEntities)
+			{
+				entities.clear();
+			}
 		}
+
+		CullScene(scene, views.data(), views.size(), m_ViewVisibleEntities.data());
 	}
 
-	void SceneRenderer::FillRenderSet(RenderSet& renderSet, int numberOfPasses, ...)
+	void SceneRenderer::SelectViewEntities(size_t view)
 	{
-		std::va_list args;
-		va_start(args, numberOfPasses);
+		ClearVisibleEntities();
+		m_VisibleEntities.swap(m_ViewVisibleEntities[view]);
+	}
 
-		// Sort and prepare model contexts
-		for (uint8_t j = 0; j < numberOfPasses; ++j)
+	void SceneRenderer::CullScene(Scene* scene, const CullView* views, size_t viewCount, VisibleEntitySet* outputs)
+	{
+		if (viewCount == 0)
+			return;
+
+		// Components moved since the scene update reach the tree first
+		scene->FlushMovedComponents();
+
+		MeshCullingTree& cullingTree = scene->GetMeshCullingTree();
+		cullingTree.Update();
+
+		const FFrustum* frustums[MaxCullViews];
+		for (size_t v = 0; v < viewCount; ++v)
 		{
-			uint8_t i = (uint8_t) va_arg(args, RenderSortType);
+			frustums[v] = views[v].Frustum;
+		}
 
-			std::vector<VisibleEntity>& visibleEntities = m_VisibleEntities[i];
+		// The tree rejects and accepts whole groups of components, only the ones touching a view come out
+		m_CullMeshComponents.clear();
+		m_CullViewMasks.clear();
+		cullingTree.Query(frustums, viewCount, m_CullMeshComponents, m_CullViewMasks);
+
+		size_t count = 0;
+		for (size_t i = 0; i < m_CullMeshComponents.size(); ++i)
+		{
+			MeshComponent* meshComponent = m_CullMeshComponents[i];
 
-			if(visibleEntities.empty())
+			if(!meshComponent->HasMesh() || !meshComponent->IsActive() || !meshComponent->IsParentActive())
 				continue;
 
-			std::sort(visibleEntities.begin(), visibleEntities.end(), [](const VisibleEntity& left, const VisibleEntity& right) -> bool
+			m_CullMeshComponents[count] = meshComponent;
+			m_CullViewMasks[count] = m_CullViewMasks[i];
+			++count;
+		}
+
+		m_CullMeshComponents.resize(count);
+		m_CullViewMasks.resize(count);
+
+		if (count == 0)
+			return;
+
+		// Transform caches its matrix on first read, resolve the candidates here so the workers only read them
+		m_CullTransforms.resize(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			m_CullTransforms[i] = m_CullMeshComponents[i]->GetRenderTransformationMatrix();
+		}
+
+		m_CullBounds.Resize(count);
+
+		m_VisibilityWorkers->ParallelFor(count, MinMeshComponentsPerChunk, [this](uint32_t chunk, size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
 			{
-				if(left.Material != right.Material)
-					return left.Material < right.Material;
+				m_CullBounds.Set(i, m_CullMeshComponents[i]->GetMesh()->m_Bounds.Transform(m_CullTransforms[i]));
+			}
+		});
 
-				if(left.Mesh != right.Mesh)
-					return left.Mesh < right.Mesh;
+		if (m_CullVisibility.size() < viewCount)
+			m_CullVisibility.resize(viewCount);
 
-				if(left.MeshSection != right.MeshSection)
-					return left.MeshSection < right.MeshSection;
+		for (size_t v = 0; v < viewCount; ++v)
+		{
+			std::vector<uint64_t>& visibility = m_CullVisibility[v];
+			visibility.assign((count + 63) / 64, 0);
 
-				return false;
-			});
+			for (size_t i = 0; i < count; ++i)
+			{
+				visibility[i >> 6] |= (uint64_t)((m_CullViewMasks[i] >> v) & 1) << (i & 63);
+			}
+
+			// The tree only tested padded or stale leaf boxes, the exact bounds decide
+			views[v].Frustum->CullBoxes(m_CullBounds, visibility);
+
+			if (views[v].Occlusion)
+			{
+				CullOccludedBoxes(*views[v].Occlusion, views[v].ViewProjection, visibility);
+			}
+		}
+
+		if (m_ChunkVisibleEntities.size() < m_VisibilityWorkers->GetMaxChunks() * viewCount)
+			m_ChunkVisibleEntities.resize(m_VisibilityWorkers->GetMaxChunks() * viewCount);
 
-			VisibleEntity lastVisibleEntity = {nullptr, nullptr, nullptr, 0, 0, {}};
-			bool lastCanBeInstanced = false;
-			ModelContext currentModelContext = {nullptr, nullptr, nullptr, nullptr, nullptr, {}};
+		const uint32_t allViews = viewCount == MaxCullViews ? ~0u : (1u << viewCount) - 1;
 
-			for (const VisibleEntity& visibleEntity : visibleEntities)
+		uint32_t chunkCount = m_VisibilityWorkers->ParallelFor(count, MinMeshComponentsPerChunk, [this, views, viewCount, allViews](uint32_t chunk, size_t begin, size_t end)
+		{
+			VisibleEntitySet* visibleEntities = &m_ChunkVisibleEntities[chunk * viewCount];
+
+			for (size_t i = begin; i < end; ++i)
 			{
-				bool canBeInstanced = visibleEntity.Material->HasFlag(MF_INSTANCED);
+				MeshComponent* meshComponent = m_CullMeshComponents[i];
+				uint32_t viewMask = meshComponent->IsIgnoringFrustumChecks() ? allViews : 0;
 
-				if (lastVisibleEntity.Mesh == nullptr)
+				for (size_t v = 0; v < viewCount; ++v)
 				{
-					lastVisibleEntity = visibleEntity;
-					lastCanBeInstanced = canBeInstanced;
-
-					currentModelContext.Material = visibleEntity.Material;
-					currentModelContext.MeshComponent = visibleEntity.MeshComponent;
-					currentModelContext.Mesh = visibleEntity.Mesh;
-					currentModelContext.LodResource = &visibleEntity.Mesh->LODResources[visibleEntity.Lod];
-					currentModelContext.MeshSection = &currentModelContext.LodResource->Sections[visibleEntity.MeshSection];
-					currentModelContext.Instances.push_back(visibleEntity.Transform);
-					continue;
+					viewMask |= (uint32_t)IsVisibleInMask(m_CullVisibility[v], i) << v;
 				}
 
-				if (lastVisibleEntity == visibleEntity && lastCanBeInstanced == canBeInstanced && currentModelContext.Instances.size() < MaxInstances)
+				if (viewMask == 0)
+					continue;
+
+				float boundsRadius = glm::length(Vector3(m_CullBounds.ExtentX[i], m_CullBounds.ExtentY[i], m_CullBounds.ExtentZ[i]));
+
+				// Views are visited in order, so LOD choosing views listed first decide the LOD reused by the others
+				for (size_t v = 0; v < viewCount; ++v)
 				{
-					currentModelContext.Instances.push_back(visibleEntity.Transform);
+					if (viewMask & (1u << v))
+					{
+						AddVisibleMeshComponent(meshComponent, m_CullTransforms[i], boundsRadius, views[v].View, visibleEntities[v]);
+					}
 				}
-				else
+			}
+		});
+
+		// Merge in chunk order, the result matches a serial pass over the mesh list
+		for (uint32_t chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			for (size_t v = 0; v < viewCount; ++v)
+			{
+				VisibleEntitySet& chunkSet = m_ChunkVisibleEntities[chunk * viewCount + v];
+
+				for (int i = 0; i < SortTypeCount; ++i)
 				{
-					lastVisibleEntity = visibleEntity;
-					lastCanBeInstanced = canBeInstanced;
+					outputs[v][i].insert(outputs[v][i].end(), chunkSet[i].begin(), chunkSet[i].end());
+					chunkSet[i].clear();
+				}
+			}
+		}
+	}
 
-					if(!currentModelContext.Instances.empty())
-					{
-						renderSet.emplace_back(currentModelContext);
-						currentModelContext = {nullptr, nullptr, nullptr, nullptr, nullptr, {}};
-					}
+	void SceneRenderer::CullOccludedBoxes(OcclusionBuffer& occlusion, const Matrix4& viewProjection, std::vector<uint64_t>& visibility)
+	{
+		CPU_DEBUG_SCOPE("CullOccludedBoxes");
+
+		occlusion.Begin(viewProjection);
+
+		for (size_t i = 0; i < m_CullMeshComponents.size(); ++i)
+		{
+			MeshComponent* meshComponent = m_CullMeshComponents[i];
 
-					currentModelContext.Material = visibleEntity.Material;
-					currentModelContext.MeshComponent = visibleEntity.MeshComponent;
-					currentModelContext.Mesh = visibleEntity.Mesh;
-					currentModelContext.LodResource = &visibleEntity.Mesh->LODResources[visibleEntity.Lod];
-					currentModelContext.MeshSection = &currentModelContext.LodResource->Sections[visibleEntity.MeshSection];
-					currentModelContext.Instances.push_back(visibleEntity.Transform);
+			if (!meshComponent->IsOccluder() || !IsVisibleInMask(visibility, i))
+				continue;
+
+			if (const std::shared_ptr<OccluderGeometry>& occluder = meshComponent->GetMesh()->Occluder)
+			{
+				occlusion.AddOccluder(occluder->Positions, occluder->Indices, m_CullTransforms[i]);
+			}
+		}
+
+		if (!occlusion.HasOccluders())
+			return;
+
+		occlusion.Finish(m_VisibilityWorkers.get());
+		occlusion.CullBoxes(m_CullBounds, visibility);
+	}
+
+	void SceneRenderer::PrepareVisibleEntities(Actor* actor, CameraComponent* camera, const FFrustum& frustum)
+	{
+		for (MeshComponent* meshComponent : actor->FindComponentsOfType<MeshComponent>())
+		{
+			PrepareMeshComponent(meshComponent, camera, frustum);
+		}
+	}
+
+	void SceneRenderer::BuildLightClusters(Scene* scene, CameraComponent* camera, const FViewPort& viewPort)
+	{
+		for (PointLightComponent* lightComponent : scene->GetComponents<PointLightComponent>())
+		{
+			if (!lightComponent->GetOwner()->IsActive() || !lightComponent->IsActive())
+				continue;
+
+			m_LightClusters.AddPointLight(lightComponent->GetWorldPosition(), lightComponent->GetRadius(), lightComponent->GetColor(), lightComponent->GetIntensity());
+		}
+
+		m_LightClusters.Build(camera->GetViewMatrix(), camera->GetProjectionMatrix(), Vector2(viewPort.Width, viewPort.Height));
+	}
+
+	void SceneRenderer::FillRenderSet(RenderSet& renderSet, int numberOfPasses, ...)
+	{
+		CPU_DEBUG_SCOPE("FillRenderSet");
+
+		std::va_list args;
+		va_start(args, numberOfPasses);
+
+		m_SortEntries.clear();
+
+		// Every requested sort type gets its argument position as pass field, so one sort orders all of them
+		for (uint8_t j = 0; j < numberOfPasses; ++j)
+		{
+			auto sortType = (RenderSortType) va_arg(args, RenderSortType);
+
+			const std::vector<VisibleEntity>& visibleEntities = m_VisibleEntities[(uint8_t)sortType];
+			const bool backToFront = sortType == RenderSortType::Translucent;
+			const size_t first = m_SortEntries.size();
+
+			m_SortEntries.resize(first + visibleEntities.size());
+
+			m_VisibilityWorkers->ParallelFor(visibleEntities.size(), MinEntitiesPerSortChunk, [&, j](uint32_t chunk, size_t begin, size_t end)
+			{
+				for (size_t k = begin; k < end; ++k)
+				{
+					const VisibleEntity& visibleEntity = visibleEntities[k];
+
+					DrawSortEntry& entry = m_SortEntries[first + k];
+					entry.Key = DrawSortKey::Encode(j, visibleEntity.Material->GetProgramSortIndex(), visibleEntity.Material->GetSortIndex(), visibleEntity.Mesh->SortIndex, visibleEntity.Lod, visibleEntity.MeshSection, visibleEntity.Depth, backToFront);
+					entry.Entity = &visibleEntity;
 				}
+			});
+		}
+		va_end(args);
+
+		RadixSortByKey(m_SortEntries, m_SortScratch);
+
+		// Group equal neighbours into instanced model contexts
+		const VisibleEntity* lastVisibleEntity = nullptr;
+		bool lastCanBeInstanced = false;
+		ModelContext currentModelContext = {nullptr, nullptr, nullptr, nullptr, nullptr, {}};
+
+		for (const DrawSortEntry& entry : m_SortEntries)
+		{
+			const VisibleEntity& visibleEntity = *entry.Entity;
+			bool canBeInstanced = visibleEntity.Material->HasFlag(MF_INSTANCED);
+
+			if (lastVisibleEntity && *lastVisibleEntity == visibleEntity && lastCanBeInstanced == canBeInstanced)
+			{
+				currentModelContext.Instances.push_back(visibleEntity.Transform);
+				continue;
 			}
 
 			if (!currentModelContext.Instances.empty())
 			{
-				renderSet.emplace_back(currentModelContext);
+				renderSet.emplace_back(std::move(currentModelContext));
+				currentModelContext = {nullptr, nullptr, nullptr, nullptr, nullptr, {}};
 			}
+
+			lastVisibleEntity = &visibleEntity;
+			lastCanBeInstanced = canBeInstanced;
+
+			currentModelContext.Material = visibleEntity.Material;
+			currentModelContext.MeshComponent = visibleEntity.MeshComponent;
+			currentModelContext.Mesh = visibleEntity.Mesh;
+			currentModelContext.LodResource = &visibleEntity.Mesh->LODResources[visibleEntity.Lod];
+			currentModelContext.MeshSection = &currentModelContext.LodResource->Sections[visibleEntity.MeshSection];
+			currentModelContext.Instances.push_back(visibleEntity.Transform);
+		}
+
+		if (!currentModelContext.Instances.empty())
+		{
+			renderSet.emplace_back(std::move(currentModelContext));
 		}
-		va_end(args);
+	}
+
+	// Neighbouring contexts can share one multi draw when nothing has to be bound between them
+	static bool CanShareMultiDraw(const ModelContext& previous, const ModelContext& next)
+	{
+		return previous.Material == next.Material
+			&& previous.LodResource->VertexBuffer == next.LodResource->VertexBuffer
+			&& previous.LodResource->IndexBuffer == next.LodResource->IndexBuffer
+			&& previous.Mesh->GetTypeID() == next.Mesh->GetTypeID()
+			&& previous.MeshSection->PrimitiveType == next.MeshSection->PrimitiveType
+			&& (previous.MeshComponent == next.MeshComponent || !next.MeshComponent->HasAnimation());
 	}
 
 	void SceneRenderer::RenderPass(PassType_t pass, DrawCallState& drawCallState, CameraComponent* camera, const RenderSet& renderSet, bool drawInjected)
 	{
 		// Render model contexts
 
+		IRenderDevice* renderDevice = GEngine->GetRenderDevice();
+		// Without draw parameters every context is its own draw with its own slice of instances
+		const bool multiDraw = renderDevice->IsMultiDrawIndirectSupported();
+
 		Material* currentMaterial = nullptr;
-		Mesh* currentMesh = nullptr;
-		MeshLodResource* currentLodResource = nullptr;
-		FMeshSection* currentSection = nullptr;
+		// Static meshes share the heap buffers, so they only rebind when a heap page or the vertex layout changes
+		Buffer_ptr currentVertexBuffer = nullptr;
+		Buffer_ptr currentIndexBuffer = nullptr;
+		InputLayout_ptr currentInputLayout = nullptr;
 		MeshComponent* currentComponent = nullptr;
 		bool updateInputLayout = false;
 
+		// Write the instances of the whole pass into one range of the ring, followed by the draw commands
+		uint32_t instancesSize = 0;
 		for (const ModelContext& modelContext : renderSet)
 		{
+			instancesSize += m_InstanceRing.Align(modelContext.Instances.size() * sizeof(Matrix4));
+		}
+
+		const uint32_t commandsSize = multiDraw ? renderSet.size() * sizeof(DrawElementsIndirectCommand) : 0;
+
+		uint32_t passOffset = 0;
+		if (instancesSize > 0)
+		{
+			passOffset = m_InstanceRing.Allocate(instancesSize + commandsSize);
+
+			auto* commands = reinterpret_cast<DrawElementsIndirectCommand*>(m_InstanceRing.GetData(passOffset + instancesSize));
+
+			uint32_t offset = passOffset;
+			for (size_t i = 0; i < renderSet.size(); ++i)
+			{
+				const ModelContext& modelContext = renderSet[i];
+				uint32_t size = modelContext.Instances.size() * sizeof(Matrix4);
+
+				std::memcpy(m_InstanceRing.GetData(offset), modelContext.Instances.data(), size);
+
+				if (multiDraw)
+				{
+					DrawElementsIndirectCommand& command = commands[i];
+					command.count = modelContext.MeshSection->NumTriangles;
+					command.instanceCount = modelContext.Instances.size();
+					command.firstIndex = modelContext.LodResource->FirstIndex + modelContext.MeshSection->FirstIndex;
+					command.baseVertex = modelContext.LodResource->BaseVertex;
+					command.baseInstance = (offset - passOffset) / sizeof(Matrix4);
+				}
+
+				offset += m_InstanceRing.Align(size);
+			}
+		}
+
+		// Every BeginPass binds the bones, animated components only rewrite them
+		drawCallState.BindUniformBuffer("GLOB_BoneData"_HASH, m_BonesBuffer);
+
+		uint32_t instancesOffset = passOffset;
+
+		for (size_t i = 0; i < renderSet.size();)
+		{
+			const ModelContext& modelContext = renderSet[i];
+
 			if (currentMaterial != modelContext.Material)
 			{
 				if (currentMaterial)
@@ -215,25 +552,29 @@ namespace Aurora
 				updateInputLayout = true;
 			}
 
-			if (!(currentMesh == modelContext.Mesh && currentLodResource == modelContext.LodResource && currentSection == modelContext.MeshSection))
+			const MeshLodResource* lodResource = modelContext.LodResource;
+			const InputLayout_ptr& inputLayout = GetInputLayoutForMesh(modelContext.Mesh);
+
+			if (currentVertexBuffer != lodResource->VertexBuffer || currentIndexBuffer != lodResource->IndexBuffer || currentInputLayout != inputLayout)
 			{
-				currentMesh = modelContext.Mesh;
-				currentLodResource = modelContext.LodResource;
-				currentSection = modelContext.MeshSection;
+				currentVertexBuffer = lodResource->VertexBuffer;
+				currentIndexBuffer = lodResource->IndexBuffer;
+				currentInputLayout = inputLayout;
 
-				drawCallState.PrimitiveType = currentSection->PrimitiveType;
-				drawCallState.InputLayoutHandle = GetInputLayoutForMesh(currentMesh);
-				if (currentLodResource->IndexBuffer)
+				drawCallState.InputLayoutHandle = inputLayout;
+				if (currentIndexBuffer)
 				{
-					drawCallState.SetIndexBuffer(currentLodResource->IndexBuffer, currentLodResource->IndexFormat);
+					drawCallState.SetIndexBuffer(currentIndexBuffer, lodResource->IndexFormat);
 				}
-				drawCallState.SetVertexBuffer(0, currentLodResource->VertexBuffer);
+				drawCallState.SetVertexBuffer(0, currentVertexBuffer);
 				updateInputLayout = true;
 			}
 
+			drawCallState.PrimitiveType = modelContext.MeshSection->PrimitiveType;
+
 			if (updateInputLayout)
 			{
-				GEngine->GetRenderDevice()->BindShaderInputs(drawCallState, true);
+				renderDevice->BindShaderInputs(drawCallState, true);
 				updateInputLayout = false;
 			}
 
@@ -241,23 +582,43 @@ namespace Aurora
 			{
 				currentComponent = modelContext.MeshComponent;
 
-				currentComponent->UploadAnimation(m_BonesBuffer);
-				drawCallState.BindUniformBuffer("GLOB_BoneData", m_BonesBuffer);
-				GEngine->GetRenderDevice()->BindShaderResources(drawCallState);
+				if (currentComponent->HasAnimation())
+				{
+					currentComponent->UploadAnimation(m_BonesBuffer);
+				}
 			}
 
-			// Write instances
-			GEngine->GetRenderDevice()->WriteBuffer(m_InstancesBuffer, modelContext.Instances.data(), modelContext.Instances.size() * sizeof(Matrix4), 0);
+			size_t batchEnd = i + 1;
 
-			DrawArguments drawArguments;
-			drawArguments.VertexCount = modelContext.MeshSection->NumTriangles;
-			drawArguments.StartIndexLocation = modelContext.MeshSection->FirstIndex * 4;
-			drawArguments.InstanceCount = modelContext.Instances.size();
-			GEngine->GetRenderDevice()->DrawIndexed(drawCallState, {drawArguments}, false);
+			if (multiDraw)
+			{
+				while (batchEnd < renderSet.size() && CanShareMultiDraw(renderSet[batchEnd - 1], renderSet[batchEnd]))
+				{
+					++batchEnd;
+				}
+
+				renderDevice->BindStorageBlockRange(drawCallState, "Instances"_HASH, m_InstanceRing.GetBuffer(), passOffset, instancesSize);
+				renderDevice->DrawIndirect(drawCallState, m_InstanceRing.GetBuffer(), passOffset + instancesSize + i * sizeof(DrawElementsIndirectCommand), batchEnd - i);
+			}
+			else
+			{
+				uint32_t instancesSliceSize = modelContext.Instances.size() * sizeof(Matrix4);
+				renderDevice->BindStorageBlockRange(drawCallState, "Instances"_HASH, m_InstanceRing.GetBuffer(), instancesOffset, instancesSliceSize);
+				instancesOffset += m_InstanceRing.Align(instancesSliceSize);
+
+				DrawArguments drawArguments;
+				drawArguments.VertexCount = modelContext.MeshSection->NumTriangles;
+				drawArguments.StartIndexLocation = (lodResource->FirstIndex + modelContext.MeshSection->FirstIndex) * sizeof(Index_t);
+				drawArguments.StartVertexLocation = lodResource->BaseVertex;
+				drawArguments.InstanceCount = modelContext.Instances.size();
+				renderDevice->DrawIndexed(drawCallState, {drawArguments}, false);
+			}
 
 			drawCallState.ClearColorTarget = false;
 			drawCallState.ClearDepthTarget = false;
 			drawCallState.ClearStencilTarget = false;
+
+			i = batchEnd;
 		}
 
 		if (currentMaterial)
@@ -265,6 +626,8 @@ namespace Aurora
 			currentMaterial->EndPass(pass, drawCallState);
 		}
 
+		m_InstanceRing.Lock();
+
 		if (drawInjected)
 			m_InjectedPasses[pass].Invoke(std::forward<PassType_t>(pass), drawCallState, std::forward<CameraComponent*>(camera));
 	}
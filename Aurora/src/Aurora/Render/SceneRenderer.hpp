@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <iterator>
+#include <algorithm>
 #include "Aurora/Core/Delegate.hpp"
 #include "Aurora/Core/Library.hpp"
 #include "Aurora/Tools/robin_hood.h"
@@ -9,17 +11,23 @@
 #include "Aurora/Graphics/Color.hpp"
 #include "Aurora/Graphics/RenderManager.hpp"
 #include "Aurora/Framework/Mesh/Mesh.hpp"
+#include "Aurora/Physics/Frustum.hpp"
+#include "DrawSortKey.hpp"
+#include "LightClusters.hpp"
+#include "OcclusionBuffer.hpp"
+#include "InstanceBufferRing.hpp"
 
 namespace Aurora
 {
 	class Scene;
-	class FFrustum;
 	class CameraComponent;
 	class Actor;
 	class SceneComponent;
 	class MeshComponent;
+	class WorkerPool;
 
-	constexpr uint32_t MaxInstances = 1024;
+	// Views culled in one pass are tracked as bits of a 32-bit mask
+	constexpr uint32_t MaxCullViews = 32;
 
 	struct VisibleEntity
 	{
@@ -29,10 +37,12 @@ namespace Aurora
 		uint MeshSection;
 		LOD Lod;
 		Matrix4 Transform;
+		// Distance from the view origin, only used for ordering
+		float Depth;
 
 		bool operator==(const VisibleEntity& other) const
 		{
-			return Material == other.Material && Mesh == other.Mesh && MeshSection == other.MeshSection;
+			return Material == other.Material && Mesh == other.Mesh && Lod == other.Lod && MeshSection == other.MeshSection;
 		}
 
 		bool operator!=(const VisibleEntity& other) const
@@ -41,6 +51,30 @@ namespace Aurora
 		}
 	};
 
+	// Per view data needed while collecting visible entities
+	struct VisibilityView
+	{
+		Vector3 Origin;
+		// Converts bounding radius over distance into screen size, zero when the view does not choose LODs
+		float LodScale;
+	};
+
+	// One of the views culled together by the multi view PrepareVisibleEntities
+	struct CullView
+	{
+		const FFrustum* Frustum;
+		VisibilityView View;
+		// Boxes that pass the frustum are also tested against the occluders rasterized with ViewProjection, null to skip
+		OcclusionBuffer* Occlusion;
+		Matrix4 ViewProjection;
+	};
+
+	struct DrawSortEntry
+	{
+		uint64_t Key;
+		const VisibleEntity* Entity;
+	};
+
 	struct ModelContext
 	{
 		Aurora::Material* Material;
@@ -52,6 +86,7 @@ namespace Aurora
 	};
 
 	using RenderSet = std::vector<ModelContext>;
+	using VisibleEntitySet = std::array<std::vector<VisibleEntity>, SortTypeCount>;
 
 	typedef EventEmitter<PassType_t, DrawCallState&, CameraComponent*> PassRenderEventEmitter;
 
@@ -123,16 +158,43 @@ namespace Aurora
 
 	protected:
 		robin_hood::unordered_map<TTypeID, InputLayout_ptr> m_MeshInputLayouts;
-		std::array<std::vector<VisibleEntity>, SortTypeCount> m_VisibleEntities;
+		VisibleEntitySet m_VisibleEntities;
 		std::array<PassRenderEventEmitter, Pass::Count> m_InjectedPasses;
 
-		Buffer_ptr m_InstancesBuffer;
+		// Instance transforms of every pass, each draw reads its own slice
+		InstanceBufferRing m_InstanceRing;
 		Buffer_ptr m_BaseVsDataBuffer;
 		Buffer_ptr m_GlobDataBuffer;
 		Buffer_ptr m_BonesBuffer;
 
 		OutlineContext m_OutlineContext;
 
+		// Scratch data of the batched frustum culling, kept to reuse the allocations between frames
+		std::vector<MeshComponent*> m_CullMeshComponents;
+		// Views each candidate of the culling tree touches, one bit per view
+		std::vector<uint32_t> m_CullViewMasks;
+		std::vector<Matrix4> m_CullTransforms;
+		FBoundsSoA m_CullBounds;
+		std::vector<std::vector<uint64_t>> m_CullVisibility;
+		// Per view results of the last multi view culling, moved into m_VisibleEntities by SelectViewEntities
+		std::vector<VisibleEntitySet> m_ViewVisibleEntities;
+
+		// Visibility and render set preparation is split over the mesh list, each chunk writes its own entity set
+		std::unique_ptr<WorkerPool> m_VisibilityWorkers;
+		std::vector<VisibleEntitySet> m_ChunkVisibleEntities;
+
+		std::vector<DrawSortEntry> m_SortEntries;
+		std::vector<DrawSortEntry> m_SortScratch;
+
+		LightClusters m_LightClusters;
+
+		// Camera occlusion buffer, filled by the MeshComponents marked as occluders
+		OcclusionBuffer m_OcclusionBuffer;
+		bool m_OcclusionCulling = true;
+
+		// Positive values pick coarser LODs, every full step halves the screen size used for the selection
+		float m_LodBias = 0.0f;
+
 		BloomSettings m_BloomSettings;
 		Shader_ptr m_BloomShader;
 		Shader_ptr m_BloomShaderSS;
@@ -142,7 +204,7 @@ namespace Aurora
 		FToneMapSettings ToneMapSettings;
 	public:
 		SceneRenderer();
-		virtual ~SceneRenderer() = default;
+		virtual ~SceneRenderer();
 
 		virtual void LoadShaders();
 
@@ -157,7 +219,36 @@ namespace Aurora
 		void PrepareMeshComponent(MeshComponent* scene, CameraComponent* camera, const FFrustum& frustum);
 		void PrepareVisibleEntities(Scene* scene, CameraComponent* camera, const FFrustum& frustum);
 		void PrepareVisibleEntities(Actor* actor, CameraComponent* camera, const FFrustum& frustum);
+		// Walks and transforms the scene once for all views, every view gets its own entity set
+		void PrepareVisibleEntities(Scene* scene, const std::vector<CullView>& views);
+		// Replaces the visible entities with the set of a view from the multi view PrepareVisibleEntities
+		void SelectViewEntities(size_t view);
+		// Like SelectViewEntities but copies the entities accepted by filter, the view set stays usable for later calls
+		template<typename Filter>
+		void CopyViewEntities(size_t view, Filter&& filter)
+		{
+			ClearVisibleEntities();
+
+			for (int i = 0; i < SortTypeCount; ++i)
+			{
+				const std::vector<VisibleEntity>& viewEntities = m_ViewVisibleEntities[view][i];
+				std::copy_if(viewEntities.begin(), viewEntities.end(), std::back_inserter(m_VisibleEntities[i]), filter);
+			}
+		}
 		void FillRenderSet(RenderSet& renderSet, int numberOfPasses, ...);
+		// Bins the active point lights of the scene for the camera, bind the result with m_LightClusters.Bind
+		void BuildLightClusters(Scene* scene, CameraComponent* camera, const FViewPort& viewPort);
+	protected:
+		[[nodiscard]] VisibilityView MakeVisibilityView(CameraComponent* camera) const;
+		// Camera view for CullScene, with occlusion culling when it is enabled and the camera is perspective
+		[[nodiscard]] CullView MakeCameraCullView(CameraComponent* camera, const FFrustum& frustum);
+		// Appends the entities visible in views[v] to outputs[v]
+		void CullScene(Scene* scene, const CullView* views, size_t viewCount, VisibleEntitySet* outputs);
+		// Rasterizes the visible occluders of the culled meshes and clears the bits of the meshes they hide
+		void CullOccludedBoxes(OcclusionBuffer& occlusion, const Matrix4& viewProjection, std::vector<uint64_t>& visibility);
+		// Writes only the LOD state of the component, safe to call from several threads for different components and output sets
+		static void AddVisibleMeshComponent(MeshComponent* meshComponent, const Matrix4& transform, float boundsRadius, const VisibilityView& view, VisibleEntitySet& visibleEntities);
+	public:
 
 		virtual void Render(Scene* scene, CameraComponent* debugCamera = nullptr) = 0;
 		void RenderPass(PassType_t pass, DrawCallState& drawCallState, CameraComponent* camera, const RenderSet& renderSet, bool drawInjected = true);
@@ -167,6 +258,13 @@ namespace Aurora
 		const InputLayout_ptr& GetInputLayoutForMesh(Mesh* mesh);
 		PassRenderEventEmitter& GetPassEmitter(PassType_t passType) { return m_InjectedPasses[passType]; }
 
+		void SetLodBias(float lodBias) { m_LodBias = lodBias; }
+		[[nodiscard]] float GetLodBias() const { return m_LodBias; }
+
+		void SetOcclusionCulling(bool enabled) { m_OcclusionCulling = enabled; }
+		[[nodiscard]] bool IsOcclusionCulling() const { return m_OcclusionCulling; }
+		[[nodiscard]] const OcclusionBuffer& GetOcclusionBuffer() const { return m_OcclusionBuffer; }
+
 		BloomSettings& GetBloomSettings() { return m_BloomSettings; }
 		OutlineContext& GetOutlineContext() { return m_OutlineContext; }
 		[[nodiscard]] const OutlineContext& GetOutlineContext() const { return m_OutlineContext; }
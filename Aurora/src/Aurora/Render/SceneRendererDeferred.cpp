@@ -28,7 +28,6 @@ namespace Aurora
 		m_CompositeDefaultsBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("CompositeDefaults", sizeof(CompositeDefaults), EBufferType::UniformBuffer));
 		m_SkyLightBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("SkyLight", sizeof(SkyLightStorage), EBufferType::UniformBuffer));
 		m_DirLightsBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("DirLights", sizeof(DirectionalLightStorage), EBufferType::UniformBuffer));
-		m_PointLightsBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("PointLights", sizeof(PointLightStorage), EBufferType::UniformBuffer, EBufferUsage::DynamicDraw, true));
 
 		m_OutlineDescBuffer = GEngine->GetRenderDevice()->CreateBuffer(BufferDesc("OutlineDesc", sizeof(OutlineGPUDesc), EBufferType::UniformBuffer, EBufferUsage::DynamicDraw));
 		m_OutlineStripeTexture = GEngine->GetResourceManager()->LoadTexture("Assets/Textures/stripe.png");
@@ -106,7 +105,6 @@ namespace Aurora
 				CPU_DEBUG_SCOPE("AmbientPass");
 				DrawCallState drawCallState;
 				drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-				drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
 
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindTarget(0, albedoBuffer);
@@ -166,25 +164,8 @@ namespace Aurora
 
 				GEngine->GetRenderDevice()->WriteBuffer(m_DirLightsBuffer, &dirLights);
 
-				// Collect and update point light buffers
-				PointLightStorage pointLights = {};
-				pointLights.PointLightCount = 0;
-
-				for (PointLightComponent* lightComponent : scene->GetComponents<PointLightComponent>())
-				{
-					if (!lightComponent->GetOwner()->IsActive() || !lightComponent->IsActive())
-						continue;
-
-					auto& light = pointLights.PointLights[pointLights.PointLightCount];
-					light.PositionIntensity = Vector4(lightComponent->GetWorldPosition(), lightComponent->GetIntensity());
-					light.ColorRadius = Vector4(lightComponent->GetColor(), lightComponent->GetRadius());
-					pointLights.PointLightCount++;
-
-					if(pointLights.PointLightCount == MAX_POINT_LIGHTS)
-						break;
-				}
-
-				GEngine->GetRenderDevice()->WriteBuffer(m_PointLightsBuffer, &pointLights);
+				// Bin point lights into the view clusters, the composite pass only reads the lights of its cluster
+				BuildLightClusters(scene, camera, viewPort->ViewPort);
 			}
 
 			// Write defaults
@@ -210,7 +191,7 @@ namespace Aurora
 
 				state.BindUniformBuffer("SkyLightStorage", m_SkyLightBuffer);
 				state.BindUniformBuffer("DirectionalLightStorage", m_DirLightsBuffer);
-				state.BindUniformBuffer("PointLightStorage", m_PointLightsBuffer);
+				m_LightClusters.Bind(state);
 				state.BindUniformBuffer("CompositeDefaults", m_CompositeDefaultsBuffer);
 
 				state.PrimitiveType = EPrimitiveType::TriangleStrip;
@@ -295,7 +276,6 @@ namespace Aurora
 						GPU_DEBUG_SCOPE("DepthPass");
 						DrawCallState drawCallState;
 						drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-						drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
 
 						drawCallState.ViewPort = viewPort->ViewPort;
 						drawCallState.ClearColorTarget = false;
@@ -9,7 +9,6 @@ namespace Aurora
 	private:
 		Buffer_ptr m_SkyLightBuffer;
 		Buffer_ptr m_DirLightsBuffer;
-		Buffer_ptr m_PointLightsBuffer;
 		Buffer_ptr m_CompositeDefaultsBuffer;
 		Shader_ptr m_CompositeShader;
 		Shader_ptr m_HDRCompositeShader;
@@ -99,7 +99,6 @@ namespace Aurora
 
 				DrawCallState drawState;
 				drawState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
-				drawState.BindUniformBuffer("Instances", m_InstancesBuffer);
 
 				drawState.ViewPort = viewPort->ViewPort;
 				drawState.BindTarget(0, colorBuffer);
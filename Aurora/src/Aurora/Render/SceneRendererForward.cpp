@@ -110,37 +110,73 @@ namespace Aurora
 
 			GEngine->GetRenderDevice()->InvalidateState();
 
-			{ // Dir light depth
-				for(DirectionalLightComponent* dirLightComponent : scene->GetComponents<DirectionalLightComponent>())
+			// Only the first shadow casting directional light is rendered
+			DirectionalLightComponent* shadowLight = nullptr;
+
+			for(DirectionalLightComponent* dirLightComponent : scene->GetComponents<DirectionalLightComponent>())
+			{
+				if (dirLightComponent->CastShadows())
+				{
+					shadowLight = dirLightComponent;
+					break;
+				}
+			}
+
+			if (shadowLight)
+			{
+				if (shadowLight->RenderTexture == nullptr)
+				{
+					shadowLight->SetupShadowmaps(NUM_SHADOW_MAP_LEVELS, Vector2i(2048));
+					shadowLight->SetupSplitDistances(camera->GetPerspectiveSettings().Near, camera->GetPerspectiveSettings().Far, 3.0f);
+				}
+				shadowLight->SetTarget(camera);
+			}
+
+			// Camera and shadow cascades are culled in a single walk over the scene, the camera goes first so it picks the LODs
+			{
+				std::vector<CullView> cullViews;
+				cullViews.push_back(MakeCameraCullView(camera, camera->GetFrustum()));
+
+				if (shadowLight)
 				{
-					if (not dirLightComponent->CastShadows())
+					for (const ShadowLayerData& layer : shadowLight->Layers)
 					{
-						continue;
+						cullViews.push_back({&layer.Frustum, {Vector3(layer.ShadowCameraMatrix[3]), 0.0f}, nullptr, Matrix4(1.0f)});
 					}
+				}
+
+				PrepareVisibleEntities(scene, cullViews);
+			}
 
+			{ // Dir light depth
+				if (DirectionalLightComponent* dirLightComponent = shadowLight)
+				{
 					GPU_DEBUG_SCOPE("DirLightShadows");
 					CPU_DEBUG_SCOPE("DirLightShadows");
 
-					if (dirLightComponent->RenderTexture == nullptr)
-					{
-						dirLightComponent->SetupShadowmaps(NUM_SHADOW_MAP_LEVELS, Vector2i(2048));
-						dirLightComponent->SetupSplitDistances(camera->GetPerspectiveSettings().Near, camera->GetPerspectiveSettings().Far, 3.0f);
-					}
-					dirLightComponent->SetTarget(camera);
-
 					DrawCallState drawCallState;
-					dirLightComponent->Render(drawCallState, [this, &drawCallState, scene, dirLightComponent](CameraComponent* lightCamera, const FFrustum* frustum, const Matrix4& lightViewMatrix, int layer)
+					dirLightComponent->Render(drawCallState, [this, &drawCallState, dirLightComponent](CameraComponent* lightCamera, const FFrustum* frustum, const Matrix4& lightViewMatrix, int layer, EShadowCasterPass casterPass)
 					{
-						ClearVisibleEntities();
-						PrepareVisibleEntities(scene, lightCamera, *frustum);
-
-						drawCallState.BindDepthTarget(dirLightComponent->RenderTexture, layer, 0);
+						// A cascade can be drawn twice, static casters into the cache and dynamic ones on top of it
+						CopyViewEntities(1 + layer, [casterPass](const VisibleEntity& entity)
+						{
+							return casterPass == EShadowCasterPass::All || entity.MeshComponent->IsStatic() == (casterPass == EShadowCasterPass::Static);
+						});
+
+						if (casterPass == EShadowCasterPass::Static)
+						{
+							drawCallState.BindDepthTarget(dirLightComponent->StaticRenderTexture, layer, 0);
+						}
+						else
+						{
+							drawCallState.BindDepthTarget(dirLightComponent->RenderTexture, layer, 0);
+						}
 
 						RenderSet modelContextsOpaque;
 						FillRenderSet(modelContextsOpaque, 2, RenderSortType::Opaque, RenderSortType::Transparent);
 
 						drawCallState.ClearColorTarget = false;
-						drawCallState.ClearDepthTarget = true;
+						drawCallState.ClearDepthTarget = casterPass != EShadowCasterPass::Dynamic;
 
 						// Setup base vs data
 						BaseVSData baseVsData;
@@ -157,7 +193,6 @@ namespace Aurora
 
 						drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
 						drawCallState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-						drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
 
 						drawCallState.ViewPort = FViewPort(dirLightComponent->Layers[layer].Resolution);
 
@@ -171,19 +206,15 @@ namespace Aurora
 					{
 						DShapes::Frustum(glm::inverse(dirLightComponent->ShadowMatrices[i]), Color::white());
 					}*/
-
-					break;
 				}
 			}
 
 			//DShapes::Frustum(glm::inverse(camera->GetProjectionViewMatrix()), Color::red());
 
-			const FFrustum& frustum = camera->GetFrustum();
 			Matrix4 viewMatrix = camera->GetViewMatrix();
 
 			// Prepate sets
-			ClearVisibleEntities();
-			PrepareVisibleEntities(scene, camera, frustum);
+			SelectViewEntities(0);
 
 			RenderSet modelContextsOpaque;
 			FillRenderSet(modelContextsOpaque, 2, RenderSortType::Opaque, RenderSortType::Transparent);
@@ -236,7 +267,6 @@ namespace Aurora
 				DrawCallState drawCallState;
 				drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
 				drawCallState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-				drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
 
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindDepthTarget(depthBuffer, 0, 0);
@@ -264,7 +294,9 @@ namespace Aurora
 				DrawCallState drawState;
 				drawState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
 				drawState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-				drawState.BindUniformBuffer("Instances", m_InstancesBuffer);
+
+				BuildLightClusters(scene, camera, viewPort->ViewPort);
+				m_LightClusters.Bind(drawState);
 
 				{ // Decals
 					drawState.BindTexture("g_DecalTexture", GEngine->GetResourceManager()->LoadTexture("Assets/Textures/decals_0003_1k_F6fzPK.png"));
@@ -346,7 +378,6 @@ namespace Aurora
 				DrawCallState drawCallState;
 				drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
 				drawCallState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-				drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
 
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindTarget(0, hrdColorBuffer);
@@ -405,7 +436,6 @@ namespace Aurora
 				DrawCallState drawCallState;
 				drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
 				drawCallState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-				drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
 
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindTarget(0, hrdColorBuffer);
@@ -455,7 +485,6 @@ namespace Aurora
 				DrawCallState drawCallState;
 				drawCallState.BindUniformBuffer("BaseVSData", m_BaseVsDataBuffer);
 				drawCallState.BindUniformBuffer("GLOB_Data", m_GlobDataBuffer);
-				drawCallState.BindUniformBuffer("Instances", m_InstancesBuffer);
 
 				drawCallState.ViewPort = viewPort->ViewPort;
 				drawCallState.BindTarget(0, hrdColorBuffer);
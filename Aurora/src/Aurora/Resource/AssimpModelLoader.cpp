@@ -636,6 +636,18 @@ namespace Aurora
 		{
 			mesh->ComputeAABB();
 
+			if (StaticMesh_ptr staticMesh = StaticMesh::SafeCast(mesh))
+			{
+				if(importOptions.LODCount > 1)
+					staticMesh->GenerateLODs(importOptions.LODCount, importOptions.LODReductionRatio, importOptions.LODMaxError);
+
+				if(importOptions.BuildCollisionBVH)
+					staticMesh->BuildCollisionBVH();
+
+				if(importOptions.BuildOccluder)
+					staticMesh->BuildOccluder();
+			}
+
 			if(importOptions.UploadToGPU)
 				mesh->UploadToGPU(importOptions.KeepCPUData);
 		}
@@ -21,6 +21,15 @@ namespace Aurora
 		bool PreTransform = true;
 		bool KeepCPUData = false;
 		bool UploadToGPU = true;
+		// Builds StaticMesh::CollisionBVH for exact ray casts and MeshColliderComponent
+		bool BuildCollisionBVH = false;
+		// Builds StaticMesh::Occluder from LOD0, for meshes placed as occluders with MeshComponent::SetOccluder
+		bool BuildOccluder = false;
+		// Static meshes without authored LODs get LODCount - 1 simplified LODs, each with LODReductionRatio of the previous triangles.
+		// LODMaxError is the allowed surface deviation relative to the mesh size, generation stops before a LOD exceeds it.
+		uint8_t LODCount = 1;
+		float LODReductionRatio = 0.5f;
+		float LODMaxError = 0.02f;
 		float DefaultScale = 1.0f;
 	};
 
@@ -0,0 +1,147 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+#include <Aurora/Render/DrawSortKey.hpp>
+
+using namespace Aurora;
+
+// Compares the pointer comparator sort FillRenderSet used before with 64-bit keys and RadixSortByKey.
+// Usage: sort_key_benchmark [entityCount] [iterations]
+
+struct FakeResource
+{
+	uint32_t SortIndex;
+	uint32_t ProgramSortIndex;
+};
+
+// Same size class as VisibleEntity, the comparator sort moves whole entities
+struct FakeEntity
+{
+	const FakeResource* Material;
+	const FakeResource* Mesh;
+	uint32_t MeshSection;
+	float Depth;
+	float Transform[16];
+};
+
+struct FakeSortEntry
+{
+	uint64_t Key;
+	const FakeEntity* Entity;
+};
+
+static bool CompareEntities(const FakeEntity& left, const FakeEntity& right)
+{
+	if(left.Material != right.Material)
+		return left.Material < right.Material;
+
+	if(left.Mesh != right.Mesh)
+		return left.Mesh < right.Mesh;
+
+	if(left.MeshSection != right.MeshSection)
+		return left.MeshSection < right.MeshSection;
+
+	return false;
+}
+
+template<typename It, typename Get>
+static uint32_t CountBatches(It begin, It end, Get&& get)
+{
+	uint32_t batches = 0;
+	const FakeEntity* last = nullptr;
+
+	for (It it = begin; it != end; ++it)
+	{
+		const FakeEntity& entity = get(*it);
+
+		if (!last || last->Material != entity.Material || last->Mesh != entity.Mesh || last->MeshSection != entity.MeshSection)
+			++batches;
+
+		last = &entity;
+	}
+
+	return batches;
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t count = argc > 1 ? (uint32_t)std::strtoul(argv[1], nullptr, 10) : 50000;
+	uint32_t iterations = argc > 2 ? (uint32_t)std::strtoul(argv[2], nullptr, 10) : 100;
+
+	if (count == 0 || iterations == 0)
+	{
+		std::cout << "Usage: sort_key_benchmark [entityCount] [iterations]\n";
+		return 1;
+	}
+
+	constexpr uint32_t ProgramCount = 16;
+	constexpr uint32_t MaterialCount = 256;
+	constexpr uint32_t MeshCount = 512;
+
+	std::vector<FakeResource> materials(MaterialCount);
+	std::vector<FakeResource> meshes(MeshCount);
+
+	for (uint32_t i = 0; i < MaterialCount; ++i)
+		materials[i] = {i, i % ProgramCount};
+
+	for (uint32_t i = 0; i < MeshCount; ++i)
+		meshes[i] = {i, 0};
+
+	std::mt19937 random(1337);
+	std::vector<FakeEntity> source(count);
+
+	for (FakeEntity& entity : source)
+	{
+		entity.Material = &materials[random() % MaterialCount];
+		entity.Mesh = &meshes[random() % MeshCount];
+		entity.MeshSection = random() % 4;
+		entity.Depth = std::uniform_real_distribution<float>(0.5f, 2000.0f)(random);
+		std::fill(std::begin(entity.Transform), std::end(entity.Transform), entity.Depth);
+	}
+
+	double comparatorTime = 0;
+	double radixTime = 0;
+	uint32_t comparatorBatches = 0;
+	uint32_t radixBatches = 0;
+
+	std::vector<FakeEntity> entities;
+	std::vector<FakeSortEntry> entries(count);
+	std::vector<FakeSortEntry> scratch;
+
+	for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+	{
+		entities = source;
+
+		auto start = std::chrono::steady_clock::now();
+		std::sort(entities.begin(), entities.end(), CompareEntities);
+		comparatorTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		comparatorBatches = CountBatches(entities.begin(), entities.end(), [](const FakeEntity& entity) -> const FakeEntity& { return entity; });
+
+		start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const FakeEntity& entity = source[i];
+			entries[i].Key = DrawSortKey::Encode(0, entity.Material->ProgramSortIndex, entity.Material->SortIndex, entity.Mesh->SortIndex, 0, entity.MeshSection, entity.Depth, false);
+			entries[i].Entity = &entity;
+		}
+		RadixSortByKey(entries, scratch);
+		radixTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		radixBatches = CountBatches(entries.begin(), entries.end(), [](const FakeSortEntry& entry) -> const FakeEntity& { return *entry.Entity; });
+	}
+
+	bool sorted = std::is_sorted(entries.begin(), entries.end(), [](const FakeSortEntry& left, const FakeSortEntry& right) { return left.Key < right.Key; });
+
+	std::cout << std::fixed << std::setprecision(3)
+		<< "entities: " << count << " iterations: " << iterations << "\n"
+		<< "  pointer comparator sort: " << comparatorTime / iterations << "ms, batches: " << comparatorBatches << "\n"
+		<< "  key encode + radix sort: " << radixTime / iterations << "ms, batches: " << radixBatches << (sorted ? "" : " (NOT SORTED)") << "\n";
+
+	return sorted && comparatorBatches == radixBatches ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+#include <Aurora/Core/Profiler.hpp>
+#include <Aurora/Framework/Scene.hpp>
+#include <Aurora/Framework/Actor.hpp>
+#include <Aurora/Physics/PhysicsWorld.hpp>
+#include <Aurora/Framework/Physics/RigidBodyComponent.hpp>
+#include <Aurora/Framework/Physics/ColliderComponent.hpp>
+
+using namespace Aurora;
+
+// Headless PhysicsWorld benchmark, runs without a window or GL context.
+// Usage: physics_benchmark [boxCount] [steps]
+// Every update advances exactly one fixed step, so the final state hash must stay the same between runs of the same build.
+
+struct BenchmarkResult
+{
+	double TotalTime = 0;
+	double BroadphaseTime = 0;
+	double IntegrationTime = 0;
+	uint64_t PairSum = 0;
+	uint32_t MaxPairs = 0;
+	uint64_t StateHash = 0;
+};
+
+static void SpawnGround(Scene& scene)
+{
+	Actor* groundActor = scene.SpawnActor<Actor>("Ground", {0, -0.5f, 0});
+	groundActor->AddComponent<BoxColliderComponent>(500, 1, 500);
+}
+
+static RigidBodyComponent* SpawnBox(Scene& scene, const std::string& name, const Vector3& position, const Vector3& velocity = Vector3(0.0f), bool continuous = false)
+{
+	Actor* boxActor = scene.SpawnActor<Actor>(name, position);
+	boxActor->AddComponent<BoxColliderComponent>(1, 1, 1);
+
+	auto* rigidBody = boxActor->AddComponent<RigidBodyComponent>();
+	rigidBody->SetVelocity(velocity);
+	rigidBody->SetContinuousCollision(continuous);
+	return rigidBody;
+}
+
+static void BuildStackedScene(Scene& scene, uint32_t count, std::vector<RigidBodyComponent*>& bodies)
+{
+	constexpr uint32_t StackHeight = 10;
+	auto columns = (count + StackHeight - 1) / StackHeight;
+	auto side = (uint32_t)glm::ceil(glm::sqrt((float)columns));
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uint32_t column = i / StackHeight;
+		uint32_t level = i % StackHeight;
+		Vector3 position((float)(column % side) * 2.0f, 0.5f + (float)level * 1.01f, (float)(column / side) * 2.0f);
+		bodies.push_back(SpawnBox(scene, "Stacked" + std::to_string(i), position));
+	}
+}
+
+static void BuildFallingScene(Scene& scene, uint32_t count, std::vector<RigidBodyComponent*>& bodies)
+{
+	auto side = (uint32_t)glm::ceil(glm::sqrt((float)count));
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		Vector3 position((float)(i % side) * 1.5f, 5.0f + (float)(i % 7) * 1.3f, (float)(i / side) * 1.5f);
+		bodies.push_back(SpawnBox(scene, "Falling" + std::to_string(i), position));
+	}
+}
+
+// Pairs of boxes flying into each other, every other pair uses continuous collision
+static void BuildCollidingScene(Scene& scene, uint32_t count, std::vector<RigidBodyComponent*>& bodies)
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uint32_t pair = i / 2;
+		bool left = (i % 2) == 0;
+		bool continuous = (pair % 2) == 1;
+
+		Vector3 position(left ? -10.0f : 10.0f, 0.51f + (float)(pair % 4) * 1.5f, (float)(pair / 4) * 2.0f);
+		Vector3 velocity(left ? 40.0f : -40.0f, 0.0f, 0.0f);
+		bodies.push_back(SpawnBox(scene, "Colliding" + std::to_string(i), position, velocity, continuous));
+	}
+}
+
+static uint32_t CountBroadphasePairs(Scene& scene)
+{
+	const AABBTree<ColliderComponent>& tree = scene.GetPhysicsWorld().GetBroadphaseTree();
+
+	uint32_t pairs = 0;
+	std::vector<ColliderComponent*> overlaps;
+
+	for (ColliderComponent* collider : scene.GetComponents<ColliderComponent>())
+	{
+		overlaps.clear();
+		tree.QueryOverlaps(collider->GetTransformedAABB(), overlaps);
+
+		// Every collider finds itself
+		if (!overlaps.empty())
+			pairs += (uint32_t)overlaps.size() - 1;
+	}
+
+	return pairs / 2;
+}
+
+static uint64_t HashState(const std::vector<RigidBodyComponent*>& bodies)
+{
+	// FNV-1a over the raw bits, any difference in the simulation shows up
+	uint64_t hash = 14695981039346656037ull;
+
+	auto hashBytes = [&hash](const void* data, size_t size)
+	{
+		const auto* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	};
+
+	for (RigidBodyComponent* body : bodies)
+	{
+		const Vector3& location = body->GetOwner()->GetRootComponent()->GetTransform().GetLocation();
+		const Vector3& velocity = body->GetVelocity();
+		hashBytes(&location, sizeof(Vector3));
+		hashBytes(&velocity, sizeof(Vector3));
+	}
+
+	return hash;
+}
+
+template<typename BuildFn>
+static BenchmarkResult RunScene(const char* name, uint32_t count, uint32_t steps, BuildFn&& build)
+{
+	BenchmarkResult result;
+
+	Scene scene;
+	PhysicsWorld& physicsWorld = scene.GetPhysicsWorld();
+	physicsWorld.SetInterpolation(false);
+
+	std::vector<RigidBodyComponent*> bodies;
+	SpawnGround(scene);
+	build(scene, count, bodies);
+
+	for (uint32_t step = 0; step < steps; ++step)
+	{
+		// PhysicsWorld profiles into the local profiler, which needs a root scope
+		LocalProfileScope::Reset("PhysicsBenchmark");
+
+		auto start = std::chrono::steady_clock::now();
+		physicsWorld.Update(physicsWorld.GetUpdateRate());
+		result.TotalTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		const PhysicsStats& stats = physicsWorld.GetLastUpdateStats();
+		result.BroadphaseTime += stats.BroadphaseTime;
+		result.IntegrationTime += stats.IntegrationTime;
+
+		uint32_t pairs = CountBroadphasePairs(scene);
+		result.PairSum += pairs;
+		result.MaxPairs = std::max(result.MaxPairs, pairs);
+	}
+
+	result.StateHash = HashState(bodies);
+
+	std::cout << std::fixed << std::setprecision(3)
+		<< "[" << name << "] boxes: " << count << " steps: " << steps << "\n"
+		<< "  total: " << result.TotalTime << "ms (" << result.TotalTime / steps << "ms/step)\n"
+		<< "  broadphase build: " << result.BroadphaseTime << "ms\n"
+		<< "  integration: " << result.IntegrationTime << "ms\n"
+		<< "  broadphase pairs: avg " << (double)result.PairSum / steps << " max " << result.MaxPairs << "\n"
+		<< "  state hash: " << std::hex << std::setw(16) << std::setfill('0') << result.StateHash << std::dec << std::setfill(' ') << "\n";
+
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t count = argc > 1 ? (uint32_t)std::strtoul(argv[1], nullptr, 10) : 1000;
+	uint32_t steps = argc > 2 ? (uint32_t)std::strtoul(argv[2], nullptr, 10) : 600;
+
+	if (count == 0 || steps == 0)
+	{
+		std::cout << "Usage: physics_benchmark [boxCount] [steps]\n";
+		return 1;
+	}
+
+	RunScene("Stacked", count, steps, BuildStackedScene);
+	RunScene("Falling", count, steps, BuildFallingScene);
+	RunScene("Colliding", count, steps, BuildCollidingScene);
+
+	return 0;
+}
@@ -0,0 +1,106 @@
+#include <Aurora/Physics/Frustum.hpp>
+#include <Aurora/Logger/std_sink.hpp>
+
+using namespace Aurora;
+
+// Camera at the origin looking down -Z
+static FFrustum MakeFrustum()
+{
+	return FFrustum(glm::perspective(1.2f, 2.0f, 0.1f, 100.0f));
+}
+
+// Culling tree leaves grow dynamic boxes by 10% of their size
+static AABB PadBounds(const AABB& bounds)
+{
+	Vector3 padding = (bounds.GetMax() - bounds.GetMin()) * 0.1f;
+	return {bounds.GetMin() - padding, bounds.GetMax() + padding};
+}
+
+static bool TestPaddedLeaf()
+{
+	FFrustum frustum = MakeFrustum();
+
+	// Left of the view, only its padded box reaches the left plane
+	AABB box(Vector3(-26, -1, -11), Vector3(-16, 1, -9));
+
+	if (!frustum.IsBoxVisible(PadBounds(box)) || frustum.IsBoxVisible(box))
+	{
+		AU_LOG_ERROR("Padded leaf: padded box should touch the frustum and the box should not !");
+		return false;
+	}
+
+	FBoundsSoA bounds;
+	bounds.Add(box);
+	bounds.Add(AABB(Vector3(-1, -1, -11), Vector3(1, 1, -9)));
+
+	// Both accepted by the tree
+	std::vector<uint64_t> visibility = {0b11};
+	frustum.CullBoxes(bounds, visibility);
+
+	if (visibility[0] != 0b10)
+	{
+		AU_LOG_ERROR("Padded leaf: box outside the frustum was not culled !");
+		return false;
+	}
+
+	return true;
+}
+
+static bool TestMatchesScalar()
+{
+	FFrustum frustum = MakeFrustum();
+
+	// Grid wider than the frustum, with a count that is not a multiple of the SIMD width
+	FBoundsSoA bounds;
+	for (int z = 0; z < 13; ++z)
+	{
+		for (int x = -10; x <= 10; ++x)
+		{
+			Vector3 center((float)x * 4.0f, 0.0f, 5.0f - (float)z * 10.0f);
+			bounds.Add(AABB(center - Vector3(1.5f), center + Vector3(1.5f)));
+		}
+	}
+
+	// Every third box was already rejected and has to stay rejected
+	std::vector<uint64_t> visibility((bounds.Size() + 63) / 64, 0);
+	for (size_t i = 0; i < bounds.Size(); ++i)
+	{
+		if (i % 3 != 0)
+			visibility[i >> 6] |= 1ull << (i & 63);
+	}
+
+	frustum.CullBoxes(bounds, visibility);
+
+	bool passed = true;
+	size_t visibleCount = 0;
+
+	for (size_t i = 0; i < bounds.Size(); ++i)
+	{
+		Vector3 center(bounds.CenterX[i], bounds.CenterY[i], bounds.CenterZ[i]);
+		Vector3 extent(bounds.ExtentX[i], bounds.ExtentY[i], bounds.ExtentZ[i]);
+
+		bool expected = i % 3 != 0 && frustum.IsBoxVisible(center - extent, center + extent);
+
+		if (IsVisibleInMask(visibility, i) != expected)
+		{
+			AU_LOG_ERROR("Box ", i, " should be ", expected ? "visible" : "culled", " !");
+			passed = false;
+		}
+
+		visibleCount += expected;
+	}
+
+	AU_LOG_INFO("Scalar: ", visibleCount, "/", bounds.Size(), " boxes visible");
+
+	return passed;
+}
+
+int main()
+{
+	Logger::AddSink<std_sink>();
+
+	bool passed = TestPaddedLeaf();
+	passed &= TestMatchesScalar();
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <Aurora/Graphics/GPUBlockAllocator.hpp>
+#include <Aurora/Logger/std_sink.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace Aurora;
+
+// Allocations must stay inside the capacity and never overlap
+static bool CheckAllocations(std::vector<GPUBlockAllocator::Allocation> allocations, uint32_t capacity)
+{
+	std::sort(allocations.begin(), allocations.end(), [](const auto& a, const auto& b) { return a.Offset < b.Offset; });
+
+	for (size_t i = 0; i < allocations.size(); ++i)
+	{
+		if (allocations[i].Offset + allocations[i].Size > capacity)
+			return false;
+
+		if (i > 0 && allocations[i - 1].Offset + allocations[i - 1].Size > allocations[i].Offset)
+			return false;
+	}
+
+	return true;
+}
+
+static bool TestExactFit()
+{
+	GPUBlockAllocator allocator(1024);
+
+	auto a = allocator.Alloc(1024);
+	auto b = allocator.Alloc(1);
+
+	bool passed = a.IsValid() && a.Offset == 0 && !b.IsValid() && allocator.GetFreeSize() == 0;
+
+	allocator.Free(a);
+	passed &= allocator.IsEmpty() && allocator.GetLargestFreeBlock() == 1024;
+
+	if (!passed)
+		AU_LOG_ERROR("Exact fit failed !");
+
+	return passed;
+}
+
+static bool TestCoalescing()
+{
+	GPUBlockAllocator allocator(3000);
+
+	auto a = allocator.Alloc(1000);
+	auto b = allocator.Alloc(1000);
+	auto c = allocator.Alloc(1000);
+
+	// Freeing the outer blocks leaves two holes that cannot hold 2000 until the middle one is freed
+	allocator.Free(a);
+	allocator.Free(c);
+	bool passed = !allocator.Alloc(2000).IsValid();
+
+	allocator.Free(b);
+	auto d = allocator.Alloc(3000);
+	passed &= d.IsValid() && d.Offset == 0;
+
+	if (!passed)
+		AU_LOG_ERROR("Coalescing failed !");
+
+	return passed;
+}
+
+static bool TestRandom()
+{
+	const uint32_t capacity = 1 << 20;
+	GPUBlockAllocator allocator(capacity);
+
+	std::mt19937 random(1234);
+	std::vector<GPUBlockAllocator::Allocation> allocations;
+	uint32_t usedSize = 0;
+	size_t failedAllocations = 0;
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		if (!allocations.empty() && random() % 3 == 0)
+		{
+			size_t index = random() % allocations.size();
+			usedSize -= allocations[index].Size;
+			allocator.Free(allocations[index]);
+			allocations[index] = allocations.back();
+			allocations.pop_back();
+			continue;
+		}
+
+		auto allocation = allocator.Alloc(1 + random() % 4096);
+
+		if (!allocation.IsValid())
+		{
+			failedAllocations++;
+			continue;
+		}
+
+		usedSize += allocation.Size;
+		allocations.push_back(allocation);
+	}
+
+	bool passed = CheckAllocations(allocations, capacity) && allocator.GetFreeSize() == capacity - usedSize;
+
+	for (const auto& allocation : allocations)
+	{
+		allocator.Free(allocation);
+	}
+
+	// Every block merges back into one
+	passed &= allocator.IsEmpty() && allocator.GetLargestFreeBlock() == capacity;
+
+	AU_LOG_INFO("Random: ", failedAllocations, " allocations did not fit");
+
+	if (!passed)
+		AU_LOG_ERROR("Random allocations failed !");
+
+	return passed;
+}
+
+int main()
+{
+	Logger::AddSink<std_sink>();
+
+	bool passed = TestExactFit();
+	passed &= TestCoalescing();
+	passed &= TestRandom();
+
+	return passed ? 0 : 1;
+}
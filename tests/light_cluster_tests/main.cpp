@@ -0,0 +1,96 @@
+#include <Aurora/Render/LightClusters.hpp>
+#include <Aurora/Logger/std_sink.hpp>
+
+using namespace Aurora;
+
+static uint32_t ClusterIndex(uint32_t x, uint32_t y, uint32_t z)
+{
+	return (z * LIGHT_CLUSTERS_Y + y) * LIGHT_CLUSTERS_X + x;
+}
+
+static std::vector<uint32_t> ClusterLights(const LightClusters& clusters, uint32_t cluster)
+{
+	const std::vector<uint32_t>& ranges = clusters.GetClusterRanges();
+	const std::vector<uint32_t>& indices = clusters.GetClusterIndices();
+
+	return {indices.begin() + ranges[cluster * 2], indices.begin() + ranges[cluster * 2] + ranges[cluster * 2 + 1]};
+}
+
+static bool TestBinning()
+{
+	LightClusters clusters;
+
+	// Camera at the origin looking down -Z, 24 slices between 1 and 100
+	clusters.AddPointLight(Vector3(0.3f, 0.2f, -8.0f), 0.1f, Vector3(1.0f), 1.0f);  // Inside tile (8, 4) and slice 10
+	clusters.AddPointLight(Vector3(0.3f, 0.2f, -8.0f), 0.1f, Vector3(1.0f), 1.0f);  // Same cluster, listed after the first one
+	clusters.AddPointLight(Vector3(0.0f, 0.0f, 10.0f), 1.0f, Vector3(1.0f), 1.0f);  // Behind the camera
+	clusters.AddPointLight(Vector3(0.0f, 0.0f, -500.0f), 1.0f, Vector3(1.0f), 1.0f); // Past the far plane
+	clusters.AddPointLight(Vector3(0.0f, 0.0f, -20.0f), 2.0f, Vector3(1.0f), 1.0f); // Spans several clusters around slice 15
+
+	clusters.Bin(Matrix4(1.0f), glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 1.0f, 100.0f), Vector2(1600, 900));
+
+	bool passed = true;
+
+	if (clusters.GetPointLightCount() != 5)
+	{
+		AU_LOG_ERROR("Binning: expected 5 lights, got ", clusters.GetPointLightCount(), " !");
+		passed = false;
+	}
+
+	if (ClusterLights(clusters, ClusterIndex(8, 4, 10)) != std::vector<uint32_t>{0, 1})
+	{
+		AU_LOG_ERROR("Binning: cluster (8, 4, 10) should only hold lights 0 and 1 !");
+		passed = false;
+	}
+
+	const std::vector<uint32_t> centerLights = ClusterLights(clusters, ClusterIndex(8, 4, 15));
+	if (centerLights != std::vector<uint32_t>{4})
+	{
+		AU_LOG_ERROR("Binning: cluster (8, 4, 15) should only hold light 4 !");
+		passed = false;
+	}
+
+	size_t smallLightClusters = 0, largeLightClusters = 0;
+
+	for (uint32_t cluster = 0; cluster < LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y * LIGHT_CLUSTERS_Z; ++cluster)
+	{
+		std::vector<uint32_t> lights = ClusterLights(clusters, cluster);
+
+		for (size_t i = 0; i < lights.size(); ++i)
+		{
+			if (lights[i] == 2 || lights[i] == 3)
+			{
+				AU_LOG_ERROR("Binning: light ", lights[i], " is outside the view and was binned in cluster ", cluster, " !");
+				passed = false;
+			}
+
+			if (i > 0 && lights[i] <= lights[i - 1])
+			{
+				AU_LOG_ERROR("Binning: lights of cluster ", cluster, " are not in light order !");
+				passed = false;
+			}
+
+			smallLightClusters += lights[i] == 0;
+			largeLightClusters += lights[i] == 4;
+		}
+	}
+
+	AU_LOG_INFO("Binning: ", clusters.GetClusterIndices().size(), " indices, light 4 in ", largeLightClusters, " clusters");
+
+	if (smallLightClusters != 1 || largeLightClusters < 2)
+	{
+		AU_LOG_ERROR("Binning: light 0 should be in one cluster and light 4 in several, got ", smallLightClusters, " and ", largeLightClusters, " !");
+		passed = false;
+	}
+
+	return passed;
+}
+
+int main()
+{
+	Logger::AddSink<std_sink>();
+
+	bool passed = TestBinning();
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
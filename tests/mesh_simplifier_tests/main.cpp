@@ -0,0 +1,130 @@
+#include <Aurora/Framework/Mesh/MeshSimplifier.hpp>
+#include <Aurora/Logger/std_sink.hpp>
+
+using namespace Aurora;
+
+// UV sphere with a duplicated seam column and collapsed poles, the way exporters write them
+static void BuildSphere(uint32_t rings, uint32_t segments, std::vector<Vector3>& positions, std::vector<uint32_t>& indices)
+{
+	for (uint32_t ring = 0; ring <= rings; ++ring)
+	{
+		for (uint32_t segment = 0; segment <= segments; ++segment)
+		{
+			float theta = glm::pi<float>() * (float)ring / (float)rings;
+			float phi = glm::two_pi<float>() * (float)(segment % segments) / (float)segments;
+			positions.emplace_back(glm::sin(theta) * glm::cos(phi), glm::cos(theta), glm::sin(theta) * glm::sin(phi));
+		}
+	}
+
+	for (uint32_t ring = 0; ring < rings; ++ring)
+	{
+		for (uint32_t segment = 0; segment < segments; ++segment)
+		{
+			uint32_t a = ring * (segments + 1) + segment;
+			uint32_t b = a + 1;
+			uint32_t c = a + segments + 1;
+			uint32_t d = c + 1;
+
+			if (ring != 0)
+				indices.insert(indices.end(), {a, b, c});
+
+			if (ring != rings - 1)
+				indices.insert(indices.end(), {b, d, c});
+		}
+	}
+}
+
+static bool TestSphere()
+{
+	std::vector<Vector3> positions;
+	std::vector<uint32_t> indices;
+	BuildSphere(64, 128, positions, indices);
+
+	const size_t triangleCount = indices.size() / 3;
+	const float maxError = 0.05f;
+	bool passed = true;
+
+	for (float ratio : {0.5f, 0.25f, 0.1f})
+	{
+		std::vector<uint32_t> simplified;
+		size_t target = (size_t)((float)triangleCount * ratio) * 3;
+		float error = MeshSimplifier::Simplify(positions, indices, target, maxError, simplified);
+
+		// Triangles have to stay close to the sphere and keep facing outwards like the source
+		float deviation = 0.0f;
+		size_t flipped = 0;
+
+		for (size_t i = 0; i < simplified.size(); i += 3)
+		{
+			const Vector3& p0 = positions[simplified[i]];
+			const Vector3& p1 = positions[simplified[i + 1]];
+			const Vector3& p2 = positions[simplified[i + 2]];
+
+			Vector3 centroid = (p0 + p1 + p2) / 3.0f;
+			deviation = std::max(deviation, 1.0f - glm::length(centroid));
+
+			if (glm::dot(glm::cross(p1 - p0, p2 - p0), centroid) <= 0.0f)
+				++flipped;
+		}
+
+		bool reachedTarget = simplified.size() <= target || error > maxError * 0.5f;
+
+		AU_LOG_INFO("Sphere ratio ", ratio, ": ", simplified.size() / 3, "/", triangleCount, " triangles, error ", error, ", deviation ", deviation, ", flipped ", flipped);
+
+		if (simplified.empty() || !reachedTarget || error > maxError || deviation > maxError || flipped != 0)
+		{
+			AU_LOG_ERROR("Sphere ratio ", ratio, " failed !");
+			passed = false;
+		}
+	}
+
+	return passed;
+}
+
+static bool TestPlane()
+{
+	constexpr uint32_t Size = 64;
+
+	std::vector<Vector3> positions;
+	std::vector<uint32_t> indices;
+
+	for (uint32_t y = 0; y <= Size; ++y)
+		for (uint32_t x = 0; x <= Size; ++x)
+			positions.emplace_back((float)x, 0.0f, (float)y);
+
+	for (uint32_t y = 0; y < Size; ++y)
+	{
+		for (uint32_t x = 0; x < Size; ++x)
+		{
+			uint32_t a = y * (Size + 1) + x;
+			uint32_t c = a + Size + 1;
+			indices.insert(indices.end(), {a, c, a + 1, a + 1, c, c + 1});
+		}
+	}
+
+	std::vector<uint32_t> simplified;
+	float error = MeshSimplifier::Simplify(positions, indices, 0, 0.001f, simplified);
+
+	// Border vertices stay, a flat interior collapses completely without error
+	size_t borderTriangles = Size * 4 - 2;
+
+	AU_LOG_INFO("Plane: ", simplified.size() / 3, "/", indices.size() / 3, " triangles, error ", error);
+
+	if (error != 0.0f || simplified.size() / 3 > borderTriangles + Size)
+	{
+		AU_LOG_ERROR("Plane failed !");
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	Logger::AddSink<std_sink>();
+
+	bool passed = TestSphere();
+	passed &= TestPlane();
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+#include <Aurora/Render/OcclusionBuffer.hpp>
+#include <Aurora/Physics/Frustum.hpp>
+#include <Aurora/Logger/std_sink.hpp>
+
+using namespace Aurora;
+
+// Camera at the origin looking down -Z, with a 10x10 wall at distance 10
+static void RasterizeWall(OcclusionBuffer& occlusion)
+{
+	std::vector<Vector3> positions = {{-5, -5, 0}, {5, -5, 0}, {5, 5, 0}, {-5, 5, 0}};
+	std::vector<uint32_t> indices = {0, 1, 2, 0, 2, 3};
+
+	occlusion.Begin(glm::perspective(1.2f, 2.0f, 0.1f, 100.0f));
+	occlusion.AddOccluder(positions, indices, glm::translate(Matrix4(1.0f), Vector3(0, 0, -10)));
+	occlusion.Finish();
+}
+
+static bool TestWall()
+{
+	OcclusionBuffer occlusion;
+	RasterizeWall(occlusion);
+
+	bool passed = true;
+
+	auto expect = [&passed, &occlusion](const char* name, const Vector3& center, const Vector3& extent, bool visible)
+	{
+		if (occlusion.IsBoxVisible(center, extent) != visible)
+		{
+			AU_LOG_ERROR("Wall: ", name, " should be ", visible ? "visible" : "hidden", " !");
+			passed = false;
+		}
+	};
+
+	expect("box behind", Vector3(0, 0, -20), Vector3(1), false);
+	expect("box in front", Vector3(0, 0, -5), Vector3(1), true);
+	expect("box beside", Vector3(30, 0, -20), Vector3(1), true);
+	expect("box through", Vector3(0, 0, -10), Vector3(1), true);
+	expect("box wider than the wall", Vector3(0, 0, -20), Vector3(20, 1, 1), true);
+	expect("box around the camera", Vector3(0), Vector3(1), true);
+
+	// Boxes along the view axis, the ones starting behind the wall are culled
+	FBoundsSoA bounds;
+	for (int i = 0; i < 100; ++i)
+	{
+		bounds.Add(AABB(Vector3(-0.5f, -0.5f, -5.5f - (float)i * 0.2f), Vector3(0.5f, 0.5f, -4.5f - (float)i * 0.2f)));
+	}
+
+	std::vector<uint64_t> visibility = {~0ull, (1ull << 36) - 1};
+	occlusion.CullBoxes(bounds, visibility);
+
+	size_t visibleCount = 0;
+	for (size_t i = 0; i < bounds.Size(); ++i)
+	{
+		visibleCount += IsVisibleInMask(visibility, i);
+	}
+
+	AU_LOG_INFO("Wall: ", occlusion.GetTriangleCount(), " triangles, ", visibleCount, "/", bounds.Size(), " boxes visible");
+
+	if (visibleCount != 28)
+	{
+		AU_LOG_ERROR("Wall: expected 28 visible boxes !");
+		passed = false;
+	}
+
+	return passed;
+}
+
+static bool TestNearClip()
+{
+	// Floor passing under the camera, the part behind the near plane has to be clipped away
+	std::vector<Vector3> positions = {{-50, -1, 5}, {50, -1, 5}, {50, -1, -50}, {-50, -1, -50}};
+	std::vector<uint32_t> indices = {0, 1, 2, 0, 2, 3};
+
+	OcclusionBuffer occlusion;
+	occlusion.Begin(glm::perspective(1.2f, 2.0f, 0.1f, 100.0f));
+	occlusion.AddOccluder(positions, indices, Matrix4(1.0f));
+	occlusion.Finish();
+
+	bool under = occlusion.IsBoxVisible(Vector3(0, -3, -10), Vector3(0.5f));
+	bool above = occlusion.IsBoxVisible(Vector3(0, 1, -10), Vector3(0.5f));
+
+	if (under || !above)
+	{
+		AU_LOG_ERROR("Near clip failed, under floor visible ", under, ", above floor visible ", above);
+		return false;
+	}
+
+	return true;
+}
+
+static bool TestFarPlaneCrossing()
+{
+	// Slope rising away from the camera, its far edge is well beyond the far plane at 20
+	std::vector<Vector3> positions = {{-30, -5, -10}, {30, -5, -10}, {30, 5, -100}, {-30, 5, -100}};
+	std::vector<uint32_t> indices = {0, 1, 2, 0, 2, 3};
+
+	OcclusionBuffer occlusion;
+	occlusion.Begin(glm::perspective(1.2f, 2.0f, 1.0f, 20.0f));
+	occlusion.AddOccluder(positions, indices, Matrix4(1.0f));
+	occlusion.Finish();
+
+	// Both on the line of sight to the slope point (0, -4.5, -14.5), one just in front of it and one behind it
+	bool front = occlusion.IsBoxVisible(Vector3(0, -4.5f * 13.25f / 14.5f, -13.25f), Vector3(0.05f));
+	bool behind = occlusion.IsBoxVisible(Vector3(0, -4.5f * 19.0f / 14.5f, -19.0f), Vector3(0.05f));
+
+	if (!front || behind)
+	{
+		AU_LOG_ERROR("Far plane crossing failed, box in front visible ", front, ", box behind visible ", behind);
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	Logger::AddSink<std_sink>();
+
+	bool passed = TestWall();
+	passed &= TestNearClip();
+	passed &= TestFarPlaneCrossing();
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+#include <random>
+#include <Aurora/Physics/TriangleBVH.hpp>
+#include <Aurora/Logger/std_sink.hpp>
+
+using namespace Aurora;
+
+// Moller-Trumbore, two sided, with the same arithmetic as the BVH so rays grazing an edge agree
+static bool IntersectTriangle(const Vector3& origin, const Vector3& direction, const Vector3& v0, const Vector3& v1, const Vector3& v2, float& t)
+{
+	Vector3 edge1 = v1 - v0;
+	Vector3 edge2 = v2 - v0;
+	Vector3 p = glm::cross(direction, edge2);
+	float determinant = glm::dot(edge1, p);
+
+	if (glm::abs(determinant) < 1e-12f)
+		return false;
+
+	float invDeterminant = 1.0f / determinant;
+	Vector3 s = origin - v0;
+	float u = glm::dot(s, p) * invDeterminant;
+	Vector3 q = glm::cross(s, edge1);
+	float v = glm::dot(direction, q) * invDeterminant;
+
+	if (u < 0.0f || u > 1.0f || v < 0.0f || u + v > 1.0f)
+		return false;
+
+	t = glm::dot(edge2, q) * invDeterminant;
+	return t >= 0.0f;
+}
+
+static bool BruteForceRayCast(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices, const Vector3& origin, const Vector3& direction, float maxDistance, float& closest)
+{
+	bool found = false;
+	closest = maxDistance;
+
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		float t;
+		if (IntersectTriangle(origin, direction, positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]], t) && t <= closest)
+		{
+			closest = t;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+// Small random triangles scattered in a 20 unit cube, enough of them to get a few tree levels
+static void BuildTriangleSoup(std::mt19937& random, std::vector<Vector3>& positions, std::vector<uint32_t>& indices)
+{
+	std::uniform_real_distribution<float> center(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> offset(-1.5f, 1.5f);
+
+	for (uint32_t i = 0; i < 500; ++i)
+	{
+		Vector3 c(center(random), center(random), center(random));
+
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			indices.push_back((uint32_t)positions.size());
+			positions.push_back(c + Vector3(offset(random), offset(random), offset(random)));
+		}
+	}
+}
+
+static bool TestMatchesBruteForce()
+{
+	std::mt19937 random(1337);
+
+	std::vector<Vector3> positions;
+	std::vector<uint32_t> indices;
+	BuildTriangleSoup(random, positions, indices);
+
+	TriangleBVH bvh;
+	bvh.Build(positions, indices);
+
+	std::uniform_real_distribution<float> point(-15.0f, 15.0f);
+	std::uniform_real_distribution<float> maxDistance(5.0f, 40.0f);
+
+	bool passed = true;
+	size_t hitCount = 0;
+	const size_t rayCount = 2000;
+
+	for (size_t r = 0; r < rayCount; ++r)
+	{
+		Vector3 origin(point(random), point(random), point(random));
+		Vector3 direction = glm::normalize(Vector3(point(random), point(random), point(random)) - origin);
+		float distance = maxDistance(random);
+
+		float expectedDistance;
+		bool expected = BruteForceRayCast(positions, indices, origin, direction, distance, expectedDistance);
+
+		TriangleHit hit = {};
+		bool found = bvh.RayCast(origin, direction, distance, hit);
+
+		if (found != expected)
+		{
+			AU_LOG_ERROR("Ray ", r, " should ", expected ? "hit" : "miss", " !");
+			passed = false;
+			continue;
+		}
+
+		if (!found)
+			continue;
+
+		++hitCount;
+
+		// Several triangles can share the closest distance, so only the distance is compared
+		if (glm::abs(hit.Distance - expectedDistance) > 1e-4f)
+		{
+			AU_LOG_ERROR("Ray ", r, " hit at ", hit.Distance, " instead of ", expectedDistance, " !");
+			passed = false;
+		}
+
+		float triangleDistance;
+		const uint32_t* triangle = &indices[hit.TriangleIndex * 3];
+		if (!IntersectTriangle(origin, direction, positions[triangle[0]], positions[triangle[1]], positions[triangle[2]], triangleDistance) || glm::abs(triangleDistance - hit.Distance) > 1e-4f)
+		{
+			AU_LOG_ERROR("Ray ", r, " reported triangle ", hit.TriangleIndex, " which it does not hit there !");
+			passed = false;
+		}
+	}
+
+	AU_LOG_INFO("Brute force: ", hitCount, "/", rayCount, " rays hit");
+
+	// Both outcomes have to be exercised for the comparison to mean anything
+	if (hitCount == 0 || hitCount == rayCount)
+	{
+		AU_LOG_ERROR("Brute force: expected a mix of hits and misses, got ", hitCount, " hits !");
+		passed = false;
+	}
+
+	return passed;
+}
+
+static bool TestMisses()
+{
+	// Unit quad in the XY plane at z = 0
+	std::vector<Vector3> positions = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+	std::vector<uint32_t> indices = {0, 1, 2, 0, 2, 3};
+
+	TriangleBVH bvh;
+	bvh.Build(positions, indices);
+
+	bool passed = true;
+	TriangleHit hit = {};
+
+	if (!bvh.RayCast(Vector3(0.5f, 0.5f, 5.0f), Vector3(0, 0, -1), 10.0f, hit) || glm::abs(hit.Distance - 5.0f) > 1e-5f)
+	{
+		AU_LOG_ERROR("Misses: ray through the quad should hit it at 5 !");
+		passed = false;
+	}
+
+	if (bvh.RayCast(Vector3(0.5f, 0.5f, 5.0f), Vector3(0, 0, 1), 10.0f, hit))
+	{
+		AU_LOG_ERROR("Misses: ray pointing away from the quad should miss !");
+		passed = false;
+	}
+
+	if (bvh.RayCast(Vector3(0.5f, 0.5f, 5.0f), Vector3(0, 0, -1), 4.0f, hit))
+	{
+		AU_LOG_ERROR("Misses: quad past the max distance should be missed !");
+		passed = false;
+	}
+
+	if (bvh.RayCast(Vector3(1.5f, 0.5f, 5.0f), Vector3(0, 0, -1), 10.0f, hit))
+	{
+		AU_LOG_ERROR("Misses: ray next to the quad should miss !");
+		passed = false;
+	}
+
+	return passed;
+}
+
+int main()
+{
+	Logger::AddSink<std_sink>();
+
+	bool passed = TestMatchesBruteForce();
+	passed &= TestMisses();
+
+	return passed ? 0 : 1;
+}